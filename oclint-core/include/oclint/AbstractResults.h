@@ -31,6 +31,8 @@ public:
 
     virtual int numberOfCheckerBugs() const override;
     virtual bool hasCheckerBugs() const override;
+
+    virtual bool isTruncated() const override;
 };
 
 } // end namespace oclint
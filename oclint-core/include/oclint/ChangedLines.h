@@ -0,0 +1,32 @@
+#ifndef OCLINT_CHANGEDLINES_H
+#define OCLINT_CHANGEDLINES_H
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace oclint
+{
+
+/*
+ * The lines touched by a patch, by absolute file path. The lines of each file are kept
+ * as sorted, disjoint closed intervals, so an intersection test is a binary search.
+ */
+class ChangedLines
+{
+private:
+    std::map<std::string, std::vector<std::pair<int, int>>> _ranges;
+
+public:
+    void add(const std::string &path, int firstLine, int lastLine);
+
+    bool empty() const;
+    bool containsFile(const std::string &path) const;
+    bool intersects(const std::string &path, int firstLine, int lastLine) const;
+    std::vector<std::string> paths() const;
+};
+
+} // end namespace oclint
+
+#endif
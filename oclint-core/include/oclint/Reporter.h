@@ -2,6 +2,7 @@
 #define OCLINT_REPORTER_H
 
 #include <ostream>
+#include <string>
 
 namespace oclint
 {
@@ -14,6 +15,13 @@ public:
     virtual ~Reporter() {}
     virtual void report(Results *results, std::ostream &out) = 0;
     virtual const std::string name() const = 0;
+
+    /* writes the report as several files into an existing directory,
+       returns false when the reporter only writes to a single stream */
+    virtual bool reportToDirectory(Results *, const std::string &)
+    {
+        return false;
+    }
 };
 
 } // end namespace oclint
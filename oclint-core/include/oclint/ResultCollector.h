@@ -3,8 +3,10 @@
 
 #include "oclint/Violation.h"
 
+#include <functional>
 #include <vector>
 #include <memory>
+#include <unordered_set>
 
 namespace oclint
 {
@@ -26,6 +28,13 @@ private:
     std::unique_ptr<ViolationSet> _compilerWarningSet;
     std::unique_ptr<ViolationSet> _clangStaticCheckerBugSet;
 
+    bool _counting;
+    bool _countingUniqueViolations;
+    int _numberOfViolationsWithPriority[3];
+    std::unordered_set<Violation, ViolationHash> _countedViolations;
+    std::function<bool(const Violation &)> _isKnownViolation;
+    bool _truncated;
+
 public:
     void add(ViolationSet *violationSet);
 
@@ -39,6 +48,20 @@ public:
 
     void addCheckerBug(const Violation& violation);
     ViolationSet* getClangStaticCheckerBugSet() const;
+
+    /*
+     * Counts the violations by priority as violation sets are added, so a run can stop
+     * as soon as a threshold is exceeded. Duplicated violations are counted once unless
+     * allowed, the same way the results leave them out, and so are known violations,
+     * e.g. those of a baseline.
+     */
+    void countViolations(bool allowDuplications,
+        std::function<bool(const Violation &)> isKnownViolation = nullptr);
+    int numberOfViolationsWithPriority(int priority) const;
+
+    /* the run stopped before analyzing every source */
+    void markTruncated();
+    bool isTruncated() const;
 };
 
 } // end namespace oclint
@@ -34,6 +34,9 @@ public:
     virtual int numberOfCheckerBugs() const = 0;
     virtual bool hasCheckerBugs() const = 0;
     virtual const std::vector<Violation>& allCheckerBugs() const = 0;
+
+    /* a fail-fast run stopped before analyzing every source */
+    virtual bool isTruncated() const { return false; }
 };
 
 } // end namespace oclint
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <algorithm>
+#include <vector>
 
 #ifdef DOCGEN
 #include <map>
@@ -10,6 +11,11 @@
 
 #include "oclint/RuleCarrier.h"
 
+namespace clang
+{
+    class LangOptions;
+}
+
 namespace oclint
 {
 
@@ -29,6 +35,28 @@ public:
     virtual const std::string category() const = 0;
     virtual int priority() const = 0;
 
+    /* translation units whose language options are not applicable skip the rule */
+    virtual bool isApplicable(const clang::LangOptions &langOptions) const;
+
+    /*
+     * Identifiers, keywords or other strings, e.g. annotations, that must all appear in
+     * the source of a translation unit for the rule to find anything in it.
+     */
+    virtual const std::vector<std::string> lexicalPrerequisites() const;
+
+    /*
+     * Global analysis maps every translation unit to a summary and then reduces them.
+     * beginGlobalAnalysis() is called before the first translation unit. Right after the
+     * rule is applied to one, summarizeTranslationUnit() returns what the rule needs to
+     * remember from it in a serialized form, so its AST can be released; rules that do not
+     * look across translation units return an empty string. After the last translation
+     * unit, endGlobalAnalysis() turns the summaries, in any order, into violations.
+     */
+    virtual void beginGlobalAnalysis();
+    virtual std::string summarizeTranslationUnit();
+    virtual void endGlobalAnalysis(const std::vector<std::string> &summaries,
+        ViolationSet *violationSet);
+
 #ifdef DOCGEN
     virtual const std::string since() const = 0;
     virtual const std::string description() const = 0;
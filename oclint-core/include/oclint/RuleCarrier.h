@@ -1,6 +1,9 @@
 #ifndef OCLINT_RULECARRIER_H
 #define OCLINT_RULECARRIER_H
 
+#include <chrono>
+#include <map>
+#include <memory>
 #include <string>
 
 namespace clang
@@ -15,21 +18,70 @@ namespace clang
 namespace oclint
 {
 
+class ChangedLines;
+
+/**
+ * Base class for data computed once per translation unit and shared by the rules
+ * analyzing it. Caches are owned by the RuleCarrier, so they are released together
+ * with the carrier once the translation unit has been analyzed.
+ */
+class TranslationUnitCache
+{
+public:
+    virtual ~TranslationUnitCache() {}
+};
+
 class RuleCarrier
 {
 private:
     ViolationSet *_violationSet;
     clang::ASTContext *_astContext;
+    const ChangedLines *_changedLines;
+    std::chrono::steady_clock::time_point _deadline;
+    bool _cancelled;
+    std::map<std::string, std::unique_ptr<TranslationUnitCache>> _caches;
 
 public:
-    RuleCarrier(clang::ASTContext *astContext, ViolationSet *violationSet);
+    RuleCarrier(clang::ASTContext *astContext, ViolationSet *violationSet,
+        const ChangedLines *changedLines = nullptr);
     clang::ASTContext* getASTContext();
     clang::SourceManager& getSourceManager();
     std::string getMainFilePath();
     clang::TranslationUnitDecl* getTranslationUnitDecl();
 
+    /**
+     * Without changed lines, e.g. outside of a diff-scoped run, every line is in scope.
+     * Relative paths are taken against the current directory of the translation unit.
+     */
+    bool hasChangedLines();
+    bool isFileChanged(const std::string &filePath);
+    bool isInChangedLines(const std::string &filePath, int startLine, int endLine);
+
+    /**
+     * Rules check isCancelled() between units of work, e.g. functions and methods, and
+     * stop early once the deadline has passed. Violations found until then are kept.
+     */
+    void setDeadline(std::chrono::steady_clock::time_point deadline);
+    bool isCancelled();
+
     void addViolation(std::string filePath, int startLine, int startColumn,
         int endLine, int endColumn, RuleBase *rule, const std::string& message = "");
+
+    /**
+     * Returns the cache registered under key, constructing it as T(*this) on first use.
+     * Rules are loaded as separate dynamic libraries, so caches are identified by name
+     * rather than by type; every user of a key must agree on its type.
+     */
+    template <typename T>
+    T *getCache(const std::string &key)
+    {
+        std::unique_ptr<TranslationUnitCache> &cache = _caches[key];
+        if (!cache)
+        {
+            cache.reset(new T(*this));
+        }
+        return static_cast<T *>(cache.get());
+    }
 };
 
 } // end namespace oclint
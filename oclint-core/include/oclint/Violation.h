@@ -1,6 +1,7 @@
 #ifndef OCLINT_VIOLATION_H
 #define OCLINT_VIOLATION_H
 
+#include <cstddef>
 #include <string>
 
 namespace oclint
@@ -27,6 +28,12 @@ public:
     bool operator==(const oclint::Violation &rhs) const;
 };
 
+class ViolationHash
+{
+public:
+    std::size_t operator()(const oclint::Violation& violation) const;
+};
+
 } // end namespace oclint
 
 #endif
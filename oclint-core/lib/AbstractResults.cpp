@@ -79,4 +79,9 @@ bool AbstractResults::hasCheckerBugs() const
     return numberOfCheckerBugs() > 0;
 }
 
+bool AbstractResults::isTruncated() const
+{
+    return _resultCollector.isTruncated();
+}
+
 } // end namespace oclint
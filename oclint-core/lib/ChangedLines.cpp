@@ -0,0 +1,61 @@
+#include "oclint/ChangedLines.h"
+
+#include <algorithm>
+
+using namespace oclint;
+
+typedef std::pair<int, int> LineRange;
+
+void ChangedLines::add(const std::string &path, int firstLine, int lastLine)
+{
+    if (lastLine < firstLine)
+    {
+        return;
+    }
+    std::vector<LineRange> &ranges = _ranges[path];
+    // the first range that ends at or after the line before firstLine can be joined
+    auto first = std::lower_bound(ranges.begin(), ranges.end(), firstLine - 1,
+        [](const LineRange &range, int line) { return range.second < line; });
+    auto last = first;
+    while (last != ranges.end() && last->first <= lastLine + 1)
+    {
+        firstLine = std::min(firstLine, last->first);
+        lastLine = std::max(lastLine, last->second);
+        ++last;
+    }
+    first = ranges.erase(first, last);
+    ranges.insert(first, LineRange(firstLine, lastLine));
+}
+
+bool ChangedLines::empty() const
+{
+    return _ranges.empty();
+}
+
+bool ChangedLines::containsFile(const std::string &path) const
+{
+    return _ranges.find(path) != _ranges.end();
+}
+
+bool ChangedLines::intersects(const std::string &path, int firstLine, int lastLine) const
+{
+    auto file = _ranges.find(path);
+    if (file == _ranges.end())
+    {
+        return false;
+    }
+    const std::vector<LineRange> &ranges = file->second;
+    auto range = std::lower_bound(ranges.begin(), ranges.end(), firstLine,
+        [](const LineRange &candidate, int line) { return candidate.second < line; });
+    return range != ranges.end() && range->first <= lastLine;
+}
+
+std::vector<std::string> ChangedLines::paths() const
+{
+    std::vector<std::string> paths;
+    for (const auto &file : _ranges)
+    {
+        paths.push_back(file.first);
+    }
+    return paths;
+}
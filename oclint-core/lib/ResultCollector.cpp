@@ -20,6 +20,10 @@ ResultCollector::ResultCollector()
     : _compilerErrorSet(new ViolationSet)
     , _compilerWarningSet(new ViolationSet)
     , _clangStaticCheckerBugSet(new ViolationSet)
+    , _counting(false)
+    , _countingUniqueViolations(false)
+    , _numberOfViolationsWithPriority{0, 0, 0}
+    , _truncated(false)
 {
 }
 
@@ -30,6 +34,26 @@ ResultCollector::~ResultCollector()
 void ResultCollector::add(ViolationSet *violationSet)
 {
     _collection.push_back(violationSet);
+    if (!_counting)
+    {
+        return;
+    }
+    for (const auto& violation : violationSet->getViolations())
+    {
+        if (_countingUniqueViolations && !_countedViolations.insert(violation).second)
+        {
+            continue;
+        }
+        if (_isKnownViolation && _isKnownViolation(violation))
+        {
+            continue;
+        }
+        int priority = violation.rule ? violation.rule->priority() : 0;
+        if (priority >= 1 && priority <= 3)
+        {
+            _numberOfViolationsWithPriority[priority - 1]++;
+        }
+    }
 }
 
 const std::vector<ViolationSet*>& ResultCollector::getCollection() const
@@ -67,4 +91,27 @@ ViolationSet* ResultCollector::getClangStaticCheckerBugSet() const
     return _clangStaticCheckerBugSet.get();
 }
 
+void ResultCollector::countViolations(bool allowDuplications,
+    std::function<bool(const Violation &)> isKnownViolation)
+{
+    _counting = true;
+    _countingUniqueViolations = !allowDuplications;
+    _isKnownViolation = std::move(isKnownViolation);
+}
+
+int ResultCollector::numberOfViolationsWithPriority(int priority) const
+{
+    return priority >= 1 && priority <= 3 ? _numberOfViolationsWithPriority[priority - 1] : 0;
+}
+
+void ResultCollector::markTruncated()
+{
+    _truncated = true;
+}
+
+bool ResultCollector::isTruncated() const
+{
+    return _truncated;
+}
+
 } // end namespace oclint
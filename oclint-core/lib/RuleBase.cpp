@@ -13,6 +13,29 @@ const std::string RuleBase::attributeName() const
     return name();
 }
 
+bool RuleBase::isApplicable(const clang::LangOptions &) const
+{
+    return true;
+}
+
+const std::vector<std::string> RuleBase::lexicalPrerequisites() const
+{
+    return std::vector<std::string>();
+}
+
+void RuleBase::beginGlobalAnalysis()
+{
+}
+
+std::string RuleBase::summarizeTranslationUnit()
+{
+    return "";
+}
+
+void RuleBase::endGlobalAnalysis(const std::vector<std::string> &, ViolationSet *)
+{
+}
+
 const std::string RuleBase::identifier() const
 {
     std::string copy = name();
@@ -1,13 +1,22 @@
 #include "oclint/RuleCarrier.h"
 
 #include <clang/AST/AST.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+
+#include "oclint/ChangedLines.h"
 
 using namespace oclint;
 
-RuleCarrier::RuleCarrier(clang::ASTContext *astContext, ViolationSet *violationSet)
+RuleCarrier::RuleCarrier(clang::ASTContext *astContext, ViolationSet *violationSet,
+    const ChangedLines *changedLines)
 {
     _violationSet = violationSet;
     _astContext = astContext;
+    _changedLines = changedLines;
+    _deadline = std::chrono::steady_clock::time_point::max();
+    _cancelled = false;
 }
 
 clang::ASTContext* RuleCarrier::getASTContext()
@@ -32,6 +41,45 @@ clang::TranslationUnitDecl* RuleCarrier::getTranslationUnitDecl()
     return getASTContext()->getTranslationUnitDecl();
 }
 
+static std::string absolutePath(const std::string &filePath)
+{
+    llvm::SmallString<256> path(filePath);
+    llvm::sys::fs::make_absolute(path);
+    llvm::sys::path::remove_dots(path, true);
+    return path.str();
+}
+
+bool RuleCarrier::hasChangedLines()
+{
+    return _changedLines != nullptr;
+}
+
+bool RuleCarrier::isFileChanged(const std::string &filePath)
+{
+    return !_changedLines || _changedLines->containsFile(absolutePath(filePath));
+}
+
+bool RuleCarrier::isInChangedLines(const std::string &filePath, int startLine, int endLine)
+{
+    return !_changedLines ||
+        _changedLines->intersects(absolutePath(filePath), startLine, endLine);
+}
+
+void RuleCarrier::setDeadline(std::chrono::steady_clock::time_point deadline)
+{
+    _deadline = deadline;
+    _cancelled = false;
+}
+
+bool RuleCarrier::isCancelled()
+{
+    if (!_cancelled && _deadline != std::chrono::steady_clock::time_point::max())
+    {
+        _cancelled = std::chrono::steady_clock::now() >= _deadline;
+    }
+    return _cancelled;
+}
+
 void RuleCarrier::addViolation(std::string filePath, int startLine, int startColumn,
     int endLine, int endColumn, RuleBase *rule, const std::string& message)
 {
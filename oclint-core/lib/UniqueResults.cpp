@@ -9,27 +9,11 @@
 namespace
 {
 
-class ViolationHash
-{
-public:
-    std::size_t operator()(const oclint::Violation& violation) const
-    {
-        std::size_t hash1 = std::hash<const oclint::RuleBase*>()(violation.rule);
-        std::size_t hash2 = std::hash<std::string>()(violation.path);
-        std::size_t hash3 = std::hash<std::string>()(violation.message);
-        std::size_t hash4 = violation.startLine
-            ^ (violation.startColumn << 2)
-            ^ (violation.endLine << 4)
-            ^ (violation.endColumn << 8);
-        return hash1 ^ (hash2 << 1) ^ (hash2 << 2) ^ (hash3 << 3) ^ (hash4 << 4);
-    }
-};
-
 std::vector<oclint::Violation> removeViolationDuplications(
   std::vector<oclint::Violation> originalViolations)
 {
     std::vector<oclint::Violation> violations;
-    std::unordered_set<oclint::Violation, ViolationHash> set;
+    std::unordered_set<oclint::Violation, oclint::ViolationHash> set;
 
     for (const auto& violation : originalViolations)
     {
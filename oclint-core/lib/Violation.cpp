@@ -1,5 +1,6 @@
 #include "oclint/Violation.h"
 
+#include <functional>
 #include <utility>
 
 #include "oclint/RuleBase.h"
@@ -29,3 +30,15 @@ bool Violation::operator==(const oclint::Violation &rhs) const
             && (endColumn == rhs.endColumn)
             && (message == rhs.message);
 }
+
+std::size_t ViolationHash::operator()(const oclint::Violation& violation) const
+{
+    std::size_t hash1 = std::hash<const oclint::RuleBase*>()(violation.rule);
+    std::size_t hash2 = std::hash<std::string>()(violation.path);
+    std::size_t hash3 = std::hash<std::string>()(violation.message);
+    std::size_t hash4 = violation.startLine
+        ^ (violation.startColumn << 2)
+        ^ (violation.endLine << 4)
+        ^ (violation.endColumn << 8);
+    return hash1 ^ (hash2 << 1) ^ (hash2 << 2) ^ (hash3 << 3) ^ (hash4 << 4);
+}
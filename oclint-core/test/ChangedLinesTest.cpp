@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "oclint/ChangedLines.h"
+
+using namespace ::testing;
+using namespace oclint;
+
+TEST(ChangedLinesTest, Empty)
+{
+    ChangedLines changedLines;
+    EXPECT_TRUE(changedLines.empty());
+    EXPECT_FALSE(changedLines.containsFile("/a.m"));
+    EXPECT_FALSE(changedLines.intersects("/a.m", 1, 100));
+}
+
+TEST(ChangedLinesTest, Intersects)
+{
+    ChangedLines changedLines;
+    changedLines.add("/a.m", 10, 12);
+    changedLines.add("/a.m", 20, 20);
+    EXPECT_TRUE(changedLines.containsFile("/a.m"));
+    EXPECT_FALSE(changedLines.intersects("/a.m", 1, 9));
+    EXPECT_TRUE(changedLines.intersects("/a.m", 1, 10));
+    EXPECT_TRUE(changedLines.intersects("/a.m", 11, 11));
+    EXPECT_TRUE(changedLines.intersects("/a.m", 12, 30));
+    EXPECT_FALSE(changedLines.intersects("/a.m", 13, 19));
+    EXPECT_TRUE(changedLines.intersects("/a.m", 5, 25));
+    EXPECT_FALSE(changedLines.intersects("/a.m", 21, 40));
+    EXPECT_FALSE(changedLines.intersects("/b.m", 10, 12));
+}
+
+TEST(ChangedLinesTest, MergeOverlappingAndAdjacentRanges)
+{
+    ChangedLines changedLines;
+    changedLines.add("/a.m", 5, 5);
+    changedLines.add("/a.m", 1, 1);
+    changedLines.add("/a.m", 3, 3);
+    EXPECT_FALSE(changedLines.intersects("/a.m", 2, 2));
+    EXPECT_FALSE(changedLines.intersects("/a.m", 4, 4));
+    changedLines.add("/a.m", 2, 4);
+    EXPECT_TRUE(changedLines.intersects("/a.m", 2, 2));
+    EXPECT_TRUE(changedLines.intersects("/a.m", 4, 4));
+    EXPECT_FALSE(changedLines.intersects("/a.m", 6, 6));
+}
+
+TEST(ChangedLinesTest, IgnoreEmptyRanges)
+{
+    ChangedLines changedLines;
+    changedLines.add("/a.m", 5, 4);
+    EXPECT_TRUE(changedLines.empty());
+}
+
+TEST(ChangedLinesTest, Paths)
+{
+    ChangedLines changedLines;
+    changedLines.add("/b.m", 1, 1);
+    changedLines.add("/a.m", 1, 1);
+    EXPECT_THAT(changedLines.paths(), ElementsAre("/a.m", "/b.m"));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
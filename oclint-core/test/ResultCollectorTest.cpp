@@ -4,6 +4,7 @@
 #include "oclint/RuleBase.h"
 #include "oclint/ResultCollector.h"
 #include "oclint/Violation.h"
+#include "oclint/ViolationSet.h"
 
 using namespace ::testing;
 using namespace oclint;
@@ -81,6 +82,69 @@ TEST(ResultCollectorTest, ViolationSetsInCollection)
     EXPECT_EQ(*violationSetWithTwoViolations, *results->getCollection()[2]);
 }
 
+TEST(ResultCollectorTest, CountUniqueViolationsWithPriority)
+{
+    ResultCollector *results = new ResultCollectorTest_ResultCollectorStub();
+    results->countViolations(false);
+    RuleBase *rule = new MockRuleBaseOne();
+    ViolationSet *violationSet = new ViolationSet();
+    violationSet->addViolation(Violation(rule, "a", 1, 2, 3, 4));
+    violationSet->addViolation(Violation(new MockRuleBaseTwo(), "a", 1, 2, 3, 4));
+    results->add(violationSet);
+    ViolationSet *duplicatedViolationSet = new ViolationSet();
+    duplicatedViolationSet->addViolation(Violation(rule, "a", 1, 2, 3, 4));
+    duplicatedViolationSet->addViolation(Violation(rule, "b", 1, 2, 3, 4));
+    results->add(duplicatedViolationSet);
+    EXPECT_EQ(2, results->numberOfViolationsWithPriority(1));
+    EXPECT_EQ(1, results->numberOfViolationsWithPriority(2));
+    EXPECT_EQ(0, results->numberOfViolationsWithPriority(3));
+}
+
+TEST(ResultCollectorTest, CountDuplicatedViolationsWhenAllowed)
+{
+    ResultCollector *results = new ResultCollectorTest_ResultCollectorStub();
+    results->countViolations(true);
+    RuleBase *rule = new MockRuleBaseOne();
+    ViolationSet *violationSet = new ViolationSet();
+    violationSet->addViolation(Violation(rule, "a", 1, 2, 3, 4));
+    violationSet->addViolation(Violation(rule, "a", 1, 2, 3, 4));
+    results->add(violationSet);
+    EXPECT_EQ(2, results->numberOfViolationsWithPriority(1));
+}
+
+TEST(ResultCollectorTest, LeaveKnownViolationsOutOfCounts)
+{
+    ResultCollector *results = new ResultCollectorTest_ResultCollectorStub();
+    results->countViolations(false, [](const Violation &violation)
+    {
+        return violation.path == "known";
+    });
+    RuleBase *rule = new MockRuleBaseOne();
+    ViolationSet *violationSet = new ViolationSet();
+    violationSet->addViolation(Violation(rule, "known", 1, 2, 3, 4));
+    violationSet->addViolation(Violation(rule, "new", 1, 2, 3, 4));
+    results->add(violationSet);
+    EXPECT_EQ(1, results->numberOfViolationsWithPriority(1));
+    EXPECT_EQ(2, results->getCollection()[0]->numberOfViolations());
+}
+
+TEST(ResultCollectorTest, NoCountsUnlessAsked)
+{
+    ResultCollector *results = new ResultCollectorTest_ResultCollectorStub();
+    ViolationSet *violationSet = new ViolationSet();
+    violationSet->addViolation(Violation(new MockRuleBaseOne(), "a", 1, 2, 3, 4));
+    results->add(violationSet);
+    EXPECT_EQ(0, results->numberOfViolationsWithPriority(1));
+}
+
+TEST(ResultCollectorTest, Truncated)
+{
+    ResultCollector *results = new ResultCollectorTest_ResultCollectorStub();
+    EXPECT_FALSE(results->isTruncated());
+    results->markTruncated();
+    EXPECT_TRUE(results->isTruncated());
+}
+
 int main(int argc, char **argv)
 {
     ::testing::InitGoogleMock(&argc, argv);
@@ -3,6 +3,7 @@
 
 #include <clang/AST/AST.h>
 
+#include "oclint/ChangedLines.h"
 #include "oclint/RuleBase.h"
 #include "oclint/ViolationSet.h"
 
@@ -52,6 +53,84 @@ TEST(RuleCarrierTest, AddViolationWithEmptyFilePath)
     EXPECT_THAT(violationSet->numberOfViolations(), Eq(0));
 }
 
+class CountingCache : public TranslationUnitCache
+{
+public:
+    static int constructed;
+    static int destructed;
+
+    explicit CountingCache(RuleCarrier &)
+    {
+        constructed++;
+    }
+
+    virtual ~CountingCache()
+    {
+        destructed++;
+    }
+};
+
+int CountingCache::constructed = 0;
+int CountingCache::destructed = 0;
+
+TEST(RuleCarrierTest, CacheIsCreatedOncePerKey)
+{
+    CountingCache::constructed = 0;
+    CountingCache::destructed = 0;
+    ViolationSet violationSet;
+    {
+        RuleCarrier carrier(NULL, &violationSet);
+        CountingCache *cache = carrier.getCache<CountingCache>("counting");
+        EXPECT_THAT(carrier.getCache<CountingCache>("counting"), Eq(cache));
+        EXPECT_THAT(carrier.getCache<CountingCache>("another"), Ne(cache));
+        EXPECT_THAT(CountingCache::constructed, Eq(2));
+        EXPECT_THAT(CountingCache::destructed, Eq(0));
+    }
+    EXPECT_THAT(CountingCache::destructed, Eq(2));
+}
+
+TEST(RuleCarrierTest, EveryLineIsChangedWithoutChangedLines)
+{
+    ViolationSet violationSet;
+    RuleCarrier carrier(NULL, &violationSet);
+    EXPECT_FALSE(carrier.hasChangedLines());
+    EXPECT_TRUE(carrier.isFileChanged("/a.m"));
+    EXPECT_TRUE(carrier.isInChangedLines("/a.m", 1, 1));
+}
+
+TEST(RuleCarrierTest, ChangedLines)
+{
+    ChangedLines changedLines;
+    changedLines.add("/a.m", 3, 4);
+    ViolationSet violationSet;
+    RuleCarrier carrier(NULL, &violationSet, &changedLines);
+    EXPECT_TRUE(carrier.hasChangedLines());
+    EXPECT_TRUE(carrier.isFileChanged("/a.m"));
+    EXPECT_FALSE(carrier.isFileChanged("/b.m"));
+    EXPECT_TRUE(carrier.isInChangedLines("/a.m", 1, 3));
+    EXPECT_TRUE(carrier.isInChangedLines("/./a.m", 4, 9));
+    EXPECT_FALSE(carrier.isInChangedLines("/a.m", 5, 9));
+}
+
+TEST(RuleCarrierTest, NeverCancelledWithoutDeadline)
+{
+    ViolationSet violationSet;
+    RuleCarrier carrier(NULL, &violationSet);
+    EXPECT_FALSE(carrier.isCancelled());
+}
+
+TEST(RuleCarrierTest, CancelledOncePastDeadline)
+{
+    ViolationSet violationSet;
+    RuleCarrier carrier(NULL, &violationSet);
+    carrier.setDeadline(std::chrono::steady_clock::now() + std::chrono::hours(1));
+    EXPECT_FALSE(carrier.isCancelled());
+    carrier.setDeadline(std::chrono::steady_clock::now());
+    EXPECT_TRUE(carrier.isCancelled());
+    carrier.setDeadline(std::chrono::steady_clock::time_point::max());
+    EXPECT_FALSE(carrier.isCancelled());
+}
+
 int main(int argc, char **argv)
 {
     ::testing::InitGoogleMock(&argc, argv);
@@ -1,6 +1,8 @@
 #ifndef OCLINT_ANALYZER_H
 #define OCLINT_ANALYZER_H
 
+#include <map>
+#include <string>
 #include <vector>
 
 namespace clang
@@ -11,12 +13,33 @@ namespace clang
 namespace oclint
 {
 
+/* global analysis summaries of one translation unit, by rule identifier */
+typedef std::map<std::string, std::string> TranslationUnitSummaries;
+
+/*
+ * With global analysis, preprocess() is called once before the first translation unit and
+ * postprocess() once after the last one, both without contexts, and analyze() is called
+ * with one translation unit at a time in between. Otherwise, all three are called for
+ * each translation unit.
+ */
 class Analyzer
 {
 public:
     virtual void preprocess(std::vector<clang::ASTContext *> &contexts) {}
     virtual void analyze(std::vector<clang::ASTContext *> &contexts) = 0;
     virtual void postprocess(std::vector<clang::ASTContext *> &contexts) {}
+
+    /*
+     * With global analysis, lastSummaries() returns the summaries of the translation unit
+     * analyzed last, and reuseSummaries() takes summaries saved by an earlier run in place
+     * of analyzing a translation unit that has not changed since. Summaries are incomplete
+     * when a rule ran out of time, and summariesMissing() tells that a translation unit
+     * could not be summarized at all. The rules affected then skip the reduce.
+     */
+    virtual TranslationUnitSummaries lastSummaries() { return TranslationUnitSummaries(); }
+    virtual bool lastSummariesComplete() { return true; }
+    virtual void reuseSummaries(const TranslationUnitSummaries &summaries) {}
+    virtual void summariesMissing() {}
 };
 
 } // end namespace oclint
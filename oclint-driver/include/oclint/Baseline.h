@@ -0,0 +1,90 @@
+#ifndef OCLINT_BASELINE_H
+#define OCLINT_BASELINE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "oclint/Results.h"
+#include "oclint/Violation.h"
+
+namespace oclint
+{
+
+/*
+ * Violations that are already known, so a run only reports new ones. A violation is
+ * identified by a fingerprint of its rule identifier, its path relative to the working
+ * directory, and the source of its first and last line with all whitespace removed.
+ * Line numbers are left out, so violations still match after the code around them moved.
+ *
+ * The file holds one hexadecimal fingerprint per line, once for every occurrence.
+ */
+class Baseline
+{
+private:
+    std::string _workingPath;
+    std::unordered_map<uint64_t, int> _fingerprints;
+
+    // violations of a file are not adjacent, e.g. in the global reduce, so every file
+    // with a violation is read once and kept
+    std::unordered_map<std::string, std::vector<std::string>> _normalizedLines;
+
+    const std::vector<std::string> &normalizedLinesOf(const std::string &path);
+
+public:
+    explicit Baseline(std::string workingPath);
+
+    uint64_t fingerprint(const Violation &violation);
+
+    void add(const Violation &violation);
+    /* consumes one occurrence of the fingerprint, returns false when there is none left */
+    bool match(const Violation &violation);
+    int numberOfFingerprints() const;
+
+    bool load(const std::string &path);
+    bool save(const std::string &path) const;
+};
+
+/* the results of a run without the violations found in the baseline */
+class BaselineResults : public Results
+{
+private:
+    std::unique_ptr<Results> _results;
+    std::vector<Violation> _violations;
+    int _numberOfViolationsWithPriority[3];
+    int _numberOfFilesWithViolations;
+    int _numberOfBaselineViolations;
+
+public:
+    BaselineResults(std::unique_ptr<Results> results, Baseline &baseline);
+
+    int numberOfBaselineViolations() const;
+
+    virtual std::vector<Violation> allViolations() const override;
+
+    virtual int numberOfViolations() const override;
+    virtual int numberOfViolationsWithPriority(int priority) const override;
+
+    virtual int numberOfFiles() const override;
+    virtual int numberOfFilesWithViolations() const override;
+
+    virtual int numberOfErrors() const override;
+    virtual bool hasErrors() const override;
+    virtual const std::vector<Violation>& allErrors() const override;
+
+    virtual int numberOfWarnings() const override;
+    virtual bool hasWarnings() const override;
+    virtual const std::vector<Violation>& allWarnings() const override;
+
+    virtual int numberOfCheckerBugs() const override;
+    virtual bool hasCheckerBugs() const override;
+    virtual const std::vector<Violation>& allCheckerBugs() const override;
+
+    virtual bool isTruncated() const override;
+};
+
+} // end namespace oclint
+
+#endif
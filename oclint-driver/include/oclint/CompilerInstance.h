@@ -16,11 +16,17 @@ namespace oclint
 class CompilerInstance : public clang::CompilerInstance
 {
 public:
+    CompilerInstance();
+
     void start();
     void end();
 
+    /* parsing stopped early because the time budget of the translation unit ran out */
+    bool hasTimedOut() const;
+
 private:
     std::vector<std::unique_ptr<clang::FrontendAction>> _actions;
+    bool _timedOut;
 };
 
 } // end namespace oclint
@@ -0,0 +1,45 @@
+#ifndef OCLINT_COMPRESSEDOUTPUTSTREAM_H
+#define OCLINT_COMPRESSEDOUTPUTSTREAM_H
+
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace oclint
+{
+
+class CompressingBuffer;
+
+/*
+ * Writes everything put into it compressed to a file. The stream fills blocks, and a
+ * separate thread compresses and writes them, so compression overlaps with the report
+ * being generated. Only a handful of blocks are in flight at any time.
+ */
+class CompressedOutputStream : public std::ostream
+{
+public:
+    enum Format
+    {
+        GZIP,
+        ZSTD
+    };
+
+private:
+    std::unique_ptr<CompressingBuffer> _buffer;
+
+public:
+    CompressedOutputStream(const std::string &path, Format format);
+    virtual ~CompressedOutputStream();
+
+    /* recognizes gzip and zstd, returns false for any other name */
+    static bool formatOf(const std::string &name, Format &format);
+    static bool isFormatAvailable(Format format);
+
+    bool is_open() const;
+    /* waits until everything is compressed and written, throws when that failed */
+    void close();
+};
+
+} // end namespace oclint
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef OCLINT_COSTHISTORY_H
+#define OCLINT_COSTHISTORY_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace oclint
+{
+
+/*
+ * How long each source took to analyze in earlier runs. A source without history is
+ * estimated from the size of its main file, at the milliseconds per byte the recorded
+ * sources took on average.
+ *
+ * The file holds one line per source with its milliseconds, its size and its path.
+ */
+class CostHistory
+{
+private:
+    struct Entry
+    {
+        uint64_t milliseconds;
+        uint64_t bytes;
+    };
+
+    std::map<std::string, Entry> _entries;
+
+    double millisecondsPerByte() const;
+
+public:
+    static uint64_t sizeOfFile(const std::string &path);
+
+    bool load(const std::string &path);
+    bool save(const std::string &path) const;
+
+    void record(const std::string &path, std::chrono::milliseconds elapsed);
+    uint64_t estimate(const std::string &path) const;
+
+    int numberOfEntries() const;
+};
+
+} // end namespace oclint
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef OCLINT_DIFFSCOPE_H
+#define OCLINT_DIFFSCOPE_H
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <llvm/ADT/StringRef.h>
+
+#include "oclint/ChangedLines.h"
+
+namespace clang
+{
+namespace tooling
+{
+    struct CompileCommand;
+}
+}
+
+namespace oclint
+{
+
+/*
+ * Narrows a run down to the lines changed by a unified diff, as written by git diff or
+ * diff -u. Paths in the diff are taken relative to the base path, after a leading a/ or b/
+ * is stripped. Added lines are changed lines, and removed lines mark the lines around
+ * the place they were removed from.
+ *
+ * A translation unit is in scope when its source or any header it includes changed. The
+ * includes are found by scanning the #include and #import lines of each file, without
+ * preprocessing, so conditional includes count while computed includes are missed.
+ */
+class DiffScope
+{
+private:
+    typedef std::pair<bool, std::string> Include;
+
+    ChangedLines _changedLines;
+    bool _hasChangedHeaders;
+    std::map<std::string, std::vector<Include>> _includes;
+    std::map<std::string, bool> _existingFiles;
+
+    const std::vector<Include> &includesOf(const std::string &path);
+    bool exists(const std::string &path);
+    std::string resolve(const Include &include, const std::string &includingPath,
+        const std::vector<std::string> &quotePaths, const std::vector<std::string> &searchPaths);
+
+public:
+    DiffScope();
+
+    bool load(const std::string &diffPath, const std::string &basePath);
+    bool parse(llvm::StringRef diff, const std::string &basePath);
+
+    const ChangedLines &changedLines() const;
+
+    bool isInScope(const std::string &filePath,
+        const clang::tooling::CompileCommand &compileCommand);
+};
+
+} // end namespace oclint
+
+#endif
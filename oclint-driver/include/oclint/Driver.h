@@ -21,13 +21,15 @@ namespace tooling
 namespace oclint
 {
 
+class DiffScope;
 class ViolationSet;
 
 class Driver
 {
 public:
     void run(const clang::tooling::CompilationDatabase &compilationDatabase,
-        llvm::ArrayRef<std::string> sourcePaths, oclint::Analyzer &analyzer);
+        llvm::ArrayRef<std::string> sourcePaths, oclint::Analyzer &analyzer,
+        DiffScope *diffScope = nullptr);
 };
 
 } // end namespace oclint
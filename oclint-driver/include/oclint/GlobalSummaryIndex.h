@@ -0,0 +1,104 @@
+#ifndef OCLINT_GLOBALSUMMARYINDEX_H
+#define OCLINT_GLOBALSUMMARYINDEX_H
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include "oclint/Analyzer.h"
+#include "oclint/Violation.h"
+
+namespace oclint
+{
+
+class RuleBase;
+
+/* what a translation unit reported, reported again when its summaries are reused */
+struct TranslationUnitResults
+{
+    std::vector<Violation> violations;
+    std::vector<Violation> errors;
+    std::vector<Violation> warnings;
+};
+
+/*
+ * Keeps the global analysis summaries of every translation unit on disk between runs.
+ * Translation units are keyed by their source path and compile command. An entry stays
+ * valid while the contents of every file the translation unit read are unchanged, so only
+ * changed translation units are parsed again. Along with the summaries, an entry keeps the
+ * violations and compiler diagnostics of the translation unit, so they are still reported.
+ *
+ * The file is a flat sequence of length-prefixed strings. It is memory-mapped when loaded,
+ * and entries refer into the mapping until they are replaced.
+ */
+class GlobalSummaryIndex
+{
+private:
+    typedef std::vector<std::pair<llvm::StringRef, llvm::StringRef>> StringPairs;
+
+    struct Record
+    {
+        uint32_t kind;
+        llvm::StringRef rule;
+        llvm::StringRef path;
+        uint32_t range[4];
+        llvm::StringRef message;
+    };
+
+    struct Entry
+    {
+        StringPairs dependencies;
+        StringPairs summaries;
+        std::vector<Record> records;
+        bool current;
+    };
+
+    std::string _scope;
+    std::map<std::string, RuleBase *> _rules;
+    std::unique_ptr<llvm::MemoryBuffer> _mapped;
+    std::deque<std::string> _strings;
+    std::map<std::string, Entry> _entries;
+    std::map<std::string, std::string> _fileDigests;
+
+    llvm::StringRef keep(std::string value);
+    void keep(uint32_t kind, const std::vector<Violation> &violations,
+        std::vector<Record> &records);
+
+public:
+    /*
+     * Entries written under a different scope, e.g. another rule set, are discarded. The
+     * rules are those the violations of the entries refer to.
+     */
+    explicit GlobalSummaryIndex(std::string scope,
+        const std::vector<RuleBase *> &rules = std::vector<RuleBase *>());
+
+    static std::string digest(llvm::StringRef content);
+    /* memoized for the run, empty when the file cannot be read */
+    const std::string &digestOfFile(const std::string &path);
+
+    bool load(const std::string &path);
+    bool save(const std::string &path) const;
+
+    bool lookup(const std::string &key, TranslationUnitSummaries &summaries,
+        TranslationUnitResults &results);
+    void update(const std::string &key, const std::vector<std::string> &dependencyPaths,
+        const TranslationUnitSummaries &summaries, const TranslationUnitResults &results);
+    /* drops the entry, e.g. when the translation unit could not be summarized completely */
+    void invalidate(const std::string &key);
+
+    /* entries are dropped when saved unless looked up or updated, or kept by this */
+    void keepUnvisitedEntries();
+
+    int numberOfEntries() const;
+};
+
+} // end namespace oclint
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef OCLINT_LEXICALPREREQUISITES_H
+#define OCLINT_LEXICALPREREQUISITES_H
+
+#include <string>
+#include <vector>
+
+namespace clang
+{
+    class ASTContext;
+}
+
+namespace oclint
+{
+
+class RuleBase;
+
+/**
+ * Collects the distinct lexical prerequisites of a list of rules, so that their
+ * presence can be looked up once per translation unit. An identifier is present when
+ * it has been lexed; keywords and other strings, like annotations, when they appear in
+ * the text of the main file or of any included file.
+ */
+class LexicalPrerequisites
+{
+private:
+    std::vector<std::string> _prerequisites;
+    std::vector<std::vector<unsigned>> _rulePrerequisites;
+
+public:
+    explicit LexicalPrerequisites(const std::vector<RuleBase *> &rules);
+
+    /* presence bitmap of the prerequisites of the rules at ruleIndices, others are true */
+    std::vector<bool> presence(clang::ASTContext &context,
+        const std::vector<unsigned> &ruleIndices) const;
+    bool isSatisfied(unsigned ruleIndex, const std::vector<bool> &presence) const;
+};
+
+} // end namespace oclint
+
+#endif
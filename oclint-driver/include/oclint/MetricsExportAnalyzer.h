@@ -0,0 +1,29 @@
+#ifndef OCLINT_METRICSEXPORTANALYZER_H
+#define OCLINT_METRICSEXPORTANALYZER_H
+
+#include "oclint/Analyzer.h"
+
+namespace oclint
+{
+
+class MetricsExportWriter;
+
+/*
+ * Replaces the rules in metrics-only mode: every function and method defined in
+ * the main file of a translation unit is measured with the combined metric and
+ * handed to the writer before the next translation unit is looked at.
+ */
+class MetricsExportAnalyzer : public Analyzer
+{
+private:
+    MetricsExportWriter &_writer;
+
+public:
+    explicit MetricsExportAnalyzer(MetricsExportWriter &writer);
+
+    virtual void analyze(std::vector<clang::ASTContext *> &contexts) override;
+};
+
+} // end namespace oclint
+
+#endif
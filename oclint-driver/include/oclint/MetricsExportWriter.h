@@ -0,0 +1,56 @@
+#ifndef OCLINT_METRICSEXPORTWRITER_H
+#define OCLINT_METRICSEXPORTWRITER_H
+
+#include <ostream>
+#include <string>
+
+#include "oclint/metric/CombinedMetric.h"
+
+namespace oclint
+{
+
+struct FunctionMetricsRecord
+{
+    std::string path;
+    int line;
+    int column;
+    std::string name;
+    FunctionMetrics metrics;
+};
+
+/*
+ * Writes one row per function straight to the output stream, so the memory used
+ * does not grow with the number of functions exported. JSON output is a single
+ * array that is only closed by finish().
+ */
+class MetricsExportWriter
+{
+public:
+    enum Format
+    {
+        CSV,
+        JSON
+    };
+
+private:
+    std::ostream &_out;
+    Format _format;
+    bool _started;
+
+    void writeCSVHeader();
+    void writeCSV(const FunctionMetricsRecord &record);
+    void writeJSON(const FunctionMetricsRecord &record);
+
+public:
+    MetricsExportWriter(std::ostream &out, Format format);
+
+    static bool parseFormat(const std::string &name, Format &format);
+
+    void write(const FunctionMetricsRecord &record);
+    void flush();
+    void finish();
+};
+
+} // end namespace oclint
+
+#endif
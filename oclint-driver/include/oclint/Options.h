@@ -23,15 +23,35 @@ namespace option
 
     bool hasOutputPath();
     std::string outputPath();
+    std::string compression();
+    bool hasReportDirectory();
+    std::string reportDirectory();
     std::string reportType();
     const oclint::RulesetFilter &rulesetFilter();
+    std::vector<std::string> ruleConfigurations();
     int maxP1();
     int maxP2();
     int maxP3();
+    unsigned translationUnitTimeout();
+    unsigned ruleTimeout();
+    bool failFast();
     bool showEnabledRules();
     bool enableGlobalAnalysis();
+    bool hasGlobalIndexPath();
+    std::string globalIndexPath();
+    bool hasBaselinePath();
+    std::string baselinePath();
+    bool hasWriteBaselinePath();
+    std::string writeBaselinePath();
+    bool hasDiffPath();
+    std::string diffPath();
+    bool hasCostHistoryPath();
+    std::string costHistoryPath();
     bool enableClangChecker();
     bool allowDuplicatedViolations();
+    bool metricsOnly();
+    std::string metricsFormat();
+    bool printStats();
     bool disableAnalytics();
     bool enableVerbose();
 } // end namespace option
@@ -1,10 +1,18 @@
 #ifndef OCLINT_RULESETBASEDANALYZER_H
 #define OCLINT_RULESETBASEDANALYZER_H
 
+#include <map>
+#include <set>
+#include <string>
+
 #include "oclint/Analyzer.h"
 
+#include "oclint/ChangedLines.h"
+
 #include "oclint/RuleBase.h"
 
+#include "oclint/LexicalPrerequisites.h"
+
 namespace oclint
 {
 
@@ -12,11 +20,29 @@ class RulesetBasedAnalyzer : public Analyzer
 {
 private:
     std::vector<RuleBase *> _filteredRules;
+    LexicalPrerequisites _prerequisites;
+    bool _globalAnalysis;
+    const ChangedLines *_changedLines;
+    std::map<RuleBase *, std::vector<std::string>> _summaries;
+    TranslationUnitSummaries _lastSummaries;
+    bool _lastSummariesComplete;
+    std::set<RuleBase *> _incompleteRules;
+
+    std::vector<RuleBase *> applicableRules(clang::ASTContext &context) const;
+    void summaryMissing(RuleBase *rule);
 
 public:
-    explicit RulesetBasedAnalyzer(std::vector<RuleBase *> filteredRules);
+    explicit RulesetBasedAnalyzer(std::vector<RuleBase *> filteredRules,
+        bool globalAnalysis = false, const ChangedLines *changedLines = nullptr);
 
+    virtual void preprocess(std::vector<clang::ASTContext *> &contexts) override;
     virtual void analyze(std::vector<clang::ASTContext*>& contexts) override;
+    virtual void postprocess(std::vector<clang::ASTContext *> &contexts) override;
+
+    virtual TranslationUnitSummaries lastSummaries() override;
+    virtual bool lastSummariesComplete() override;
+    virtual void reuseSummaries(const TranslationUnitSummaries &summaries) override;
+    virtual void summariesMissing() override;
 };
 
 } // end namespace oclint
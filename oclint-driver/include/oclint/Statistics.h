@@ -0,0 +1,42 @@
+#ifndef OCLINT_STATISTICS_H
+#define OCLINT_STATISTICS_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <llvm/Support/raw_ostream.h>
+
+namespace oclint
+{
+
+class RuleBase;
+
+enum RuleOutcome
+{
+    RULE_APPLIED,
+    RULE_SKIPPED_FOR_LANGUAGE,
+    RULE_SKIPPED_FOR_PREREQUISITES,
+    RULE_TIMED_OUT,
+    NUMBER_OF_RULE_OUTCOMES
+};
+
+class Statistics
+{
+public:
+    static void translationUnitAnalyzed();
+    static void ruleOutcome(const RuleBase *rule, RuleOutcome outcome);
+    /* stage is where the time budget ran out, e.g. the frontend or the rules */
+    static void translationUnitTimedOut(const std::string &path, const std::string &stage);
+
+    static int numberOfTranslationUnits();
+    static int numberOfOutcomes(const RuleBase *rule, RuleOutcome outcome);
+    static const std::vector<std::pair<std::string, std::string>> &timedOutTranslationUnits();
+
+    static void print(llvm::raw_ostream &out);
+    static void reset();
+};
+
+} // end namespace oclint
+
+#endif
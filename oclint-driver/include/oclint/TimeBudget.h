@@ -0,0 +1,33 @@
+#ifndef OCLINT_TIMEBUDGET_H
+#define OCLINT_TIMEBUDGET_H
+
+#include <chrono>
+
+namespace oclint
+{
+
+/*
+ * The time each translation unit, and each rule within it, may take. The frontend and
+ * the rules check the deadlines cooperatively, between top-level declarations, so a
+ * single declaration that takes long is not interrupted. A budget of zero is unlimited.
+ */
+class TimeBudget
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static void configure(std::chrono::milliseconds translationUnitBudget,
+        std::chrono::milliseconds ruleBudget);
+
+    static void startTranslationUnit();
+    static bool isTranslationUnitExpired();
+    /* the deadline of a rule starting now, never past the one of its translation unit */
+    static Clock::time_point ruleDeadline();
+
+    static std::chrono::milliseconds translationUnitBudget();
+    static std::chrono::milliseconds ruleBudget();
+};
+
+} // end namespace oclint
+
+#endif
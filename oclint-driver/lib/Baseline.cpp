@@ -0,0 +1,263 @@
+#include "oclint/Baseline.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include "oclint/RuleBase.h"
+
+using namespace oclint;
+
+static const char baselineHeader[] = "oclint-baseline 1";
+
+Baseline::Baseline(std::string workingPath) : _workingPath(std::move(workingPath))
+{
+}
+
+const std::vector<std::string> &Baseline::normalizedLinesOf(const std::string &path)
+{
+    auto cached = _normalizedLines.find(path);
+    if (cached != _normalizedLines.end())
+    {
+        return cached->second;
+    }
+    std::vector<std::string> &lines = _normalizedLines[path];
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+        llvm::MemoryBuffer::getFile(path, -1, false);
+    if (!buffer)
+    {
+        return lines;
+    }
+    std::string line;
+    for (char character : buffer.get()->getBuffer())
+    {
+        if (character == '\n')
+        {
+            lines.push_back(line);
+            line.clear();
+        }
+        else if (!isspace(static_cast<unsigned char>(character)))
+        {
+            line += character;
+        }
+    }
+    lines.push_back(line);
+    return lines;
+}
+
+uint64_t Baseline::fingerprint(const Violation &violation)
+{
+    std::string path = violation.path;
+    std::string prefix = _workingPath + "/";
+    if (path.compare(0, prefix.size(), prefix) == 0)
+    {
+        path = path.substr(prefix.size());
+    }
+    const std::vector<std::string> &lines = normalizedLinesOf(violation.path);
+    auto lineAt = [&lines](int line) -> std::string
+    {
+        return line >= 1 && line <= static_cast<int>(lines.size()) ? lines[line - 1] : "";
+    };
+    int endLine = violation.endLine != 0 ? violation.endLine : violation.startLine;
+
+    llvm::MD5 hash;
+    hash.update(violation.rule ? violation.rule->identifier() : "");
+    hash.update(llvm::StringRef("\0", 1));
+    hash.update(path);
+    hash.update(llvm::StringRef("\0", 1));
+    hash.update(lineAt(violation.startLine));
+    hash.update(llvm::StringRef("\0", 1));
+    hash.update(lineAt(endLine));
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    uint64_t value = 0;
+    for (int index = 0; index < 8; index++)
+    {
+        value = (value << 8) | result[index];
+    }
+    return value;
+}
+
+void Baseline::add(const Violation &violation)
+{
+    _fingerprints[fingerprint(violation)]++;
+}
+
+bool Baseline::match(const Violation &violation)
+{
+    auto known = _fingerprints.find(fingerprint(violation));
+    if (known == _fingerprints.end() || known->second == 0)
+    {
+        return false;
+    }
+    known->second--;
+    return true;
+}
+
+int Baseline::numberOfFingerprints() const
+{
+    int count = 0;
+    for (const auto& fingerprint : _fingerprints)
+    {
+        count += fingerprint.second;
+    }
+    return count;
+}
+
+bool Baseline::load(const std::string &path)
+{
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+        llvm::MemoryBuffer::getFile(path, -1, false);
+    if (!buffer)
+    {
+        return false;
+    }
+    llvm::SmallVector<llvm::StringRef, 0> lines;
+    buffer.get()->getBuffer().split(lines, '\n', -1, false);
+    if (lines.empty() || lines[0].rtrim() != baselineHeader)
+    {
+        return false;
+    }
+    std::unordered_map<uint64_t, int> fingerprints;
+    for (size_t index = 1; index < lines.size(); index++)
+    {
+        uint64_t fingerprint;
+        if (lines[index].rtrim().getAsInteger(16, fingerprint))
+        {
+            return false;
+        }
+        fingerprints[fingerprint]++;
+    }
+    _fingerprints.swap(fingerprints);
+    return true;
+}
+
+bool Baseline::save(const std::string &path) const
+{
+    std::multiset<uint64_t> sorted;
+    for (const auto& fingerprint : _fingerprints)
+    {
+        for (int occurrence = 0; occurrence < fingerprint.second; occurrence++)
+        {
+            sorted.insert(fingerprint.first);
+        }
+    }
+    std::ofstream out(path.c_str());
+    out << baselineHeader << "\n";
+    for (uint64_t fingerprint : sorted)
+    {
+        char hex[17];
+        snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(fingerprint));
+        out << hex << "\n";
+    }
+    out.close();
+    return !out.fail();
+}
+
+BaselineResults::BaselineResults(std::unique_ptr<Results> results, Baseline &baseline)
+    : _results(std::move(results)), _numberOfViolationsWithPriority{0, 0, 0},
+    _numberOfBaselineViolations(0)
+{
+    std::set<std::string> filesWithViolations;
+    for (const auto& violation : _results->allViolations())
+    {
+        if (baseline.match(violation))
+        {
+            _numberOfBaselineViolations++;
+            continue;
+        }
+        _violations.push_back(violation);
+        filesWithViolations.insert(violation.path);
+        int priority = violation.rule ? violation.rule->priority() : 0;
+        if (priority >= 1 && priority <= 3)
+        {
+            _numberOfViolationsWithPriority[priority - 1]++;
+        }
+    }
+    _numberOfFilesWithViolations = filesWithViolations.size();
+}
+
+int BaselineResults::numberOfBaselineViolations() const
+{
+    return _numberOfBaselineViolations;
+}
+
+std::vector<Violation> BaselineResults::allViolations() const
+{
+    return _violations;
+}
+
+int BaselineResults::numberOfViolations() const
+{
+    return _violations.size();
+}
+
+int BaselineResults::numberOfViolationsWithPriority(int priority) const
+{
+    return priority >= 1 && priority <= 3 ? _numberOfViolationsWithPriority[priority - 1] : 0;
+}
+
+int BaselineResults::numberOfFiles() const
+{
+    return _results->numberOfFiles();
+}
+
+int BaselineResults::numberOfFilesWithViolations() const
+{
+    return _numberOfFilesWithViolations;
+}
+
+int BaselineResults::numberOfErrors() const
+{
+    return _results->numberOfErrors();
+}
+
+bool BaselineResults::hasErrors() const
+{
+    return _results->hasErrors();
+}
+
+const std::vector<Violation>& BaselineResults::allErrors() const
+{
+    return _results->allErrors();
+}
+
+int BaselineResults::numberOfWarnings() const
+{
+    return _results->numberOfWarnings();
+}
+
+bool BaselineResults::hasWarnings() const
+{
+    return _results->hasWarnings();
+}
+
+const std::vector<Violation>& BaselineResults::allWarnings() const
+{
+    return _results->allWarnings();
+}
+
+int BaselineResults::numberOfCheckerBugs() const
+{
+    return _results->numberOfCheckerBugs();
+}
+
+bool BaselineResults::hasCheckerBugs() const
+{
+    return _results->hasCheckerBugs();
+}
+
+const std::vector<Violation>& BaselineResults::allCheckerBugs() const
+{
+    return _results->allCheckerBugs();
+}
+
+bool BaselineResults::isTruncated() const
+{
+    return _results->isTruncated();
+}
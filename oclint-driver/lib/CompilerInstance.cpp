@@ -46,21 +46,73 @@
  */
 #include "oclint/CompilerInstance.h"
 
+#include <clang/AST/ASTConsumer.h>
 #include <clang/Basic/TargetInfo.h>
 #include <clang/Frontend/FrontendActions.h>
+#include <clang/Frontend/MultiplexConsumer.h>
 #include <clang/StaticAnalyzer/Frontend/FrontendActions.h>
 
 #include "oclint/Options.h"
+#include "oclint/TimeBudget.h"
 
 using namespace oclint;
 
-static clang::FrontendAction *getFrontendAction()
+namespace
+{
+
+/* the parser asks every consumer whether to go on after each top-level declaration */
+class DeadlineConsumer : public clang::ASTConsumer
+{
+private:
+    bool &_timedOut;
+
+public:
+    explicit DeadlineConsumer(bool &timedOut) : _timedOut(timedOut)
+    {
+    }
+
+    virtual bool HandleTopLevelDecl(clang::DeclGroupRef) override
+    {
+        _timedOut = _timedOut || TimeBudget::isTranslationUnitExpired();
+        return !_timedOut;
+    }
+};
+
+template <typename Action>
+class DeadlineAction : public Action
+{
+private:
+    bool &_timedOut;
+
+public:
+    explicit DeadlineAction(bool &timedOut) : _timedOut(timedOut)
+    {
+    }
+
+protected:
+    virtual std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(
+        clang::CompilerInstance &compiler, llvm::StringRef inFile) override
+    {
+        std::vector<std::unique_ptr<clang::ASTConsumer>> consumers;
+        consumers.push_back(Action::CreateASTConsumer(compiler, inFile));
+        consumers.push_back(llvm::make_unique<DeadlineConsumer>(_timedOut));
+        return llvm::make_unique<clang::MultiplexConsumer>(std::move(consumers));
+    }
+};
+
+} // end namespace
+
+static clang::FrontendAction *getFrontendAction(bool &timedOut)
 {
     if (option::enableClangChecker())
     {
-        return new clang::ento::AnalysisAction();
+        return new DeadlineAction<clang::ento::AnalysisAction>(timedOut);
     }
-    return new clang::SyntaxOnlyAction();
+    return new DeadlineAction<clang::SyntaxOnlyAction>(timedOut);
+}
+
+CompilerInstance::CompilerInstance() : _timedOut(false)
+{
 }
 
 void CompilerInstance::start()
@@ -84,7 +136,7 @@ void CompilerInstance::start()
             getSourceManager().clearIDTables();
         }
 
-        clang::FrontendAction *frontendAction = getFrontendAction();
+        clang::FrontendAction *frontendAction = getFrontendAction(_timedOut);
         if(frontendAction->BeginSourceFile(*this, input))
         {
             frontendAction->Execute();
@@ -93,6 +145,11 @@ void CompilerInstance::start()
     }
 }
 
+bool CompilerInstance::hasTimedOut() const
+{
+    return _timedOut;
+}
+
 void CompilerInstance::end()
 {
     for (const auto& action : _actions)
@@ -0,0 +1,330 @@
+#include "oclint/CompressedOutputStream.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "oclint/GenericException.h"
+
+using namespace oclint;
+
+static const size_t blockSize = 1 << 20;
+static const size_t maximumPendingBlocks = 4;
+
+namespace
+{
+
+class Compressor
+{
+public:
+    virtual ~Compressor() {}
+    /* compresses the data and writes the output that is ready, finish ends the stream */
+    virtual void compress(const char *data, size_t size, bool finish, std::ostream &out) = 0;
+};
+
+class GzipCompressor : public Compressor
+{
+private:
+    z_stream _stream;
+    std::vector<char> _output;
+
+public:
+    GzipCompressor() : _output(blockSize / 4)
+    {
+        memset(&_stream, 0, sizeof(_stream));
+        // 16 more window bits ask for a gzip header instead of a zlib one
+        if (deflateInit2(&_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+            15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            throw GenericException("cannot initialize gzip compression");
+        }
+    }
+
+    virtual ~GzipCompressor()
+    {
+        deflateEnd(&_stream);
+    }
+
+    virtual void compress(const char *data, size_t size, bool finish, std::ostream &out) override
+    {
+        _stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+        _stream.avail_in = size;
+        int result;
+        do
+        {
+            _stream.next_out = reinterpret_cast<Bytef *>(_output.data());
+            _stream.avail_out = _output.size();
+            result = deflate(&_stream, finish ? Z_FINISH : Z_NO_FLUSH);
+            if (result == Z_STREAM_ERROR)
+            {
+                throw GenericException("gzip compression failed");
+            }
+            out.write(_output.data(), _output.size() - _stream.avail_out);
+        } while (finish ? result != Z_STREAM_END : _stream.avail_out == 0);
+    }
+};
+
+#ifdef HAVE_ZSTD
+
+class ZstdCompressor : public Compressor
+{
+private:
+    ZSTD_CStream *_stream;
+    std::vector<char> _output;
+
+    void check(size_t result)
+    {
+        if (ZSTD_isError(result))
+        {
+            throw GenericException(std::string("zstd compression failed: ") +
+                ZSTD_getErrorName(result));
+        }
+    }
+
+public:
+    ZstdCompressor() : _stream(ZSTD_createCStream()), _output(ZSTD_CStreamOutSize())
+    {
+        if (_stream == nullptr || ZSTD_isError(ZSTD_initCStream(_stream, 3)))
+        {
+            ZSTD_freeCStream(_stream);
+            throw GenericException("cannot initialize zstd compression");
+        }
+    }
+
+    virtual ~ZstdCompressor()
+    {
+        ZSTD_freeCStream(_stream);
+    }
+
+    virtual void compress(const char *data, size_t size, bool finish, std::ostream &out) override
+    {
+        ZSTD_inBuffer input = { data, size, 0 };
+        while (input.pos < input.size)
+        {
+            ZSTD_outBuffer output = { _output.data(), _output.size(), 0 };
+            check(ZSTD_compressStream(_stream, &output, &input));
+            out.write(_output.data(), output.pos);
+        }
+        size_t remaining = finish ? 1 : 0;
+        while (remaining != 0)
+        {
+            ZSTD_outBuffer output = { _output.data(), _output.size(), 0 };
+            remaining = ZSTD_endStream(_stream, &output);
+            check(remaining);
+            out.write(_output.data(), output.pos);
+        }
+    }
+};
+
+#endif
+
+} // end namespace
+
+namespace oclint
+{
+
+class CompressingBuffer : public std::streambuf
+{
+private:
+    std::string _path;
+    std::ofstream _file;
+    std::unique_ptr<Compressor> _compressor;
+    std::vector<char> _block;
+
+    std::mutex _mutex;
+    std::condition_variable _changed;
+    std::deque<std::vector<char>> _pending;
+    bool _finished;
+    std::string _failure;
+    std::thread _thread;
+
+    /* queues the filled part of the block, waits while the compressor is behind */
+    void handOff()
+    {
+        _block.resize(pptr() - pbase());
+        if (!_block.empty())
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _changed.wait(lock, [this] { return _pending.size() < maximumPendingBlocks; });
+            _pending.push_back(std::move(_block));
+            _changed.notify_all();
+        }
+        _block.resize(blockSize);
+        setp(_block.data(), _block.data() + _block.size());
+    }
+
+    void compressPendingBlocks()
+    {
+        bool last = false;
+        while (!last)
+        {
+            std::vector<char> block;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _changed.wait(lock, [this] { return !_pending.empty() || _finished; });
+                if (!_pending.empty())
+                {
+                    block = std::move(_pending.front());
+                    _pending.pop_front();
+                }
+                last = _pending.empty() && _finished;
+                _changed.notify_all();
+            }
+            // after a failure, the remaining blocks are only drained
+            if (_failure.empty())
+            {
+                try
+                {
+                    _compressor->compress(block.data(), block.size(), last, _file);
+                    if (!_file)
+                    {
+                        throw GenericException("cannot write report output file " + _path);
+                    }
+                }
+                catch (const std::exception &exception)
+                {
+                    _failure = exception.what();
+                }
+            }
+        }
+    }
+
+protected:
+    virtual int_type overflow(int_type character) override
+    {
+        handOff();
+        if (!traits_type::eq_int_type(character, traits_type::eof()))
+        {
+            *pptr() = traits_type::to_char_type(character);
+            pbump(1);
+        }
+        return traits_type::not_eof(character);
+    }
+
+    virtual int sync() override
+    {
+        handOff();
+        return 0;
+    }
+
+public:
+    CompressingBuffer(const std::string &path, CompressedOutputStream::Format format)
+        : _path(path), _file(path.c_str(), std::ios::binary), _finished(false)
+    {
+        if (!_file.is_open())
+        {
+            return;
+        }
+        if (format == CompressedOutputStream::GZIP)
+        {
+            _compressor.reset(new GzipCompressor());
+        }
+#ifdef HAVE_ZSTD
+        else
+        {
+            _compressor.reset(new ZstdCompressor());
+        }
+#endif
+        if (!_compressor)
+        {
+            throw GenericException("the compression is not available in this build");
+        }
+        _block.resize(blockSize);
+        setp(_block.data(), _block.data() + _block.size());
+        _thread = std::thread(&CompressingBuffer::compressPendingBlocks, this);
+    }
+
+    virtual ~CompressingBuffer()
+    {
+        finish();
+    }
+
+    bool isOpen() const
+    {
+        return _file.is_open();
+    }
+
+    /* returns the reason when compressing or writing failed, empty otherwise */
+    std::string finish()
+    {
+        if (!_thread.joinable())
+        {
+            return _failure;
+        }
+        handOff();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _finished = true;
+            _changed.notify_all();
+        }
+        _thread.join();
+        _file.close();
+        if (_failure.empty() && _file.fail())
+        {
+            _failure = "cannot write report output file " + _path;
+        }
+        return _failure;
+    }
+};
+
+} // end namespace oclint
+
+CompressedOutputStream::CompressedOutputStream(const std::string &path, Format format)
+    : std::ostream(nullptr), _buffer(new CompressingBuffer(path, format))
+{
+    rdbuf(_buffer.get());
+}
+
+CompressedOutputStream::~CompressedOutputStream()
+{
+}
+
+bool CompressedOutputStream::formatOf(const std::string &name, Format &format)
+{
+    if (name == "gzip" || name == "gz")
+    {
+        format = GZIP;
+        return true;
+    }
+    if (name == "zstd" || name == "zst")
+    {
+        format = ZSTD;
+        return true;
+    }
+    return false;
+}
+
+bool CompressedOutputStream::isFormatAvailable(Format format)
+{
+#ifndef HAVE_ZSTD
+    if (format == ZSTD)
+    {
+        return false;
+    }
+#endif
+    return true;
+}
+
+bool CompressedOutputStream::is_open() const
+{
+    return _buffer->isOpen();
+}
+
+void CompressedOutputStream::close()
+{
+    flush();
+    std::string failure = _buffer->finish();
+    if (!failure.empty())
+    {
+        throw GenericException(failure);
+    }
+}
@@ -0,0 +1,102 @@
+#include "oclint/CostHistory.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+using namespace oclint;
+
+static const char historyHeader[] = "oclint-cost-history 1";
+
+// before anything was recorded, only the relative sizes of the sources matter
+static const double defaultMillisecondsPerByte = 0.001;
+
+uint64_t CostHistory::sizeOfFile(const std::string &path)
+{
+    uint64_t size;
+    return llvm::sys::fs::file_size(path, size) ? 0 : size;
+}
+
+bool CostHistory::load(const std::string &path)
+{
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+        llvm::MemoryBuffer::getFile(path, -1, false);
+    if (!buffer)
+    {
+        return false;
+    }
+    llvm::SmallVector<llvm::StringRef, 0> lines;
+    buffer.get()->getBuffer().split(lines, '\n', -1, false);
+    if (lines.empty() || lines[0].rtrim() != historyHeader)
+    {
+        return false;
+    }
+    std::map<std::string, Entry> entries;
+    for (size_t index = 1; index < lines.size(); index++)
+    {
+        std::pair<llvm::StringRef, llvm::StringRef> milliseconds = lines[index].split(' ');
+        std::pair<llvm::StringRef, llvm::StringRef> bytes = milliseconds.second.split(' ');
+        llvm::StringRef sourcePath = bytes.second.rtrim();
+        Entry entry;
+        if (milliseconds.first.getAsInteger(10, entry.milliseconds) ||
+            bytes.first.getAsInteger(10, entry.bytes) || sourcePath.empty())
+        {
+            return false;
+        }
+        entries[sourcePath.str()] = entry;
+    }
+    _entries.swap(entries);
+    return true;
+}
+
+bool CostHistory::save(const std::string &path) const
+{
+    std::ofstream out(path.c_str());
+    out << historyHeader << "\n";
+    for (const auto &entry : _entries)
+    {
+        out << entry.second.milliseconds << " " << entry.second.bytes << " "
+            << entry.first << "\n";
+    }
+    out.close();
+    return !out.fail();
+}
+
+void CostHistory::record(const std::string &path, std::chrono::milliseconds elapsed)
+{
+    Entry &entry = _entries[path];
+    entry.milliseconds = elapsed.count();
+    entry.bytes = sizeOfFile(path);
+}
+
+double CostHistory::millisecondsPerByte() const
+{
+    uint64_t milliseconds = 0;
+    uint64_t bytes = 0;
+    for (const auto &entry : _entries)
+    {
+        milliseconds += entry.second.milliseconds;
+        bytes += entry.second.bytes;
+    }
+    return milliseconds == 0 || bytes == 0 ?
+        defaultMillisecondsPerByte : double(milliseconds) / bytes;
+}
+
+uint64_t CostHistory::estimate(const std::string &path) const
+{
+    auto known = _entries.find(path);
+    if (known != _entries.end())
+    {
+        return known->second.milliseconds;
+    }
+    return static_cast<uint64_t>(sizeOfFile(path) * millisecondsPerByte());
+}
+
+int CostHistory::numberOfEntries() const
+{
+    return _entries.size();
+}
@@ -0,0 +1,285 @@
+#include "oclint/DiffScope.h"
+
+#include <algorithm>
+#include <set>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <clang/Tooling/CompilationDatabase.h>
+
+using namespace oclint;
+
+static std::string normalizedPath(llvm::StringRef path, const std::string &basePath)
+{
+    llvm::SmallString<256> normalized;
+    if (!llvm::sys::path::is_absolute(path))
+    {
+        normalized = basePath;
+    }
+    llvm::sys::path::append(normalized, path);
+    llvm::sys::path::remove_dots(normalized, true);
+    return normalized.str();
+}
+
+static std::string newPathOf(llvm::StringRef header, const std::string &basePath)
+{
+    // diff -u appends a tab and the modification time to the path
+    llvm::StringRef path = header.split('\t').first.rtrim();
+    if (path == "/dev/null")
+    {
+        return "";
+    }
+    if (path.startswith("b/"))
+    {
+        path = path.drop_front(2);
+    }
+    return normalizedPath(path, basePath);
+}
+
+static bool parseRange(llvm::StringRef range, int &start, int &count)
+{
+    std::pair<llvm::StringRef, llvm::StringRef> parts = range.split(',');
+    count = 1;
+    return !parts.first.getAsInteger(10, start) &&
+        (parts.second.empty() || !parts.second.getAsInteger(10, count));
+}
+
+static bool isSourceFile(const std::string &path)
+{
+    static const std::set<std::string> sourceExtensions {
+        ".c", ".cc", ".cp", ".cpp", ".cxx", ".c++", ".m", ".mm" };
+    return sourceExtensions.count(llvm::sys::path::extension(path).lower()) > 0;
+}
+
+DiffScope::DiffScope() : _hasChangedHeaders(false)
+{
+}
+
+bool DiffScope::load(const std::string &diffPath, const std::string &basePath)
+{
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+        llvm::MemoryBuffer::getFile(diffPath, -1, false);
+    return buffer && parse(buffer.get()->getBuffer(), basePath);
+}
+
+bool DiffScope::parse(llvm::StringRef diff, const std::string &basePath)
+{
+    llvm::SmallVector<llvm::StringRef, 0> lines;
+    diff.split(lines, '\n');
+    std::string path;
+    int newLine = 0;
+    int oldRemaining = 0;
+    int newRemaining = 0;
+    for (llvm::StringRef line : lines)
+    {
+        line = line.rtrim('\r');
+        if (oldRemaining > 0 || newRemaining > 0)
+        {
+            // some tools strip the space of empty context lines
+            char marker = line.empty() ? ' ' : line[0];
+            if (marker == '+')
+            {
+                if (!path.empty())
+                {
+                    _changedLines.add(path, newLine, newLine);
+                }
+                newLine++;
+                newRemaining--;
+            }
+            else if (marker == '-')
+            {
+                if (!path.empty())
+                {
+                    _changedLines.add(path, std::max(newLine - 1, 1), newLine);
+                }
+                oldRemaining--;
+            }
+            else if (marker == ' ')
+            {
+                newLine++;
+                oldRemaining--;
+                newRemaining--;
+            }
+            else if (marker != '\\')
+            {
+                return false;
+            }
+        }
+        else if (line.startswith("+++ "))
+        {
+            path = newPathOf(line.drop_front(4), basePath);
+        }
+        else if (line.startswith("@@ "))
+        {
+            llvm::SmallVector<llvm::StringRef, 4> ranges;
+            line.drop_front(3).split(ranges, ' ', 2, false);
+            int oldStart;
+            if (ranges.size() < 2 || !ranges[0].startswith("-") || !ranges[1].startswith("+") ||
+                !parseRange(ranges[0].drop_front(), oldStart, oldRemaining) ||
+                !parseRange(ranges[1].drop_front(), newLine, newRemaining))
+            {
+                return false;
+            }
+        }
+    }
+
+    for (const auto &changedPath : _changedLines.paths())
+    {
+        _hasChangedHeaders = _hasChangedHeaders || !isSourceFile(changedPath);
+    }
+    return true;
+}
+
+const ChangedLines &DiffScope::changedLines() const
+{
+    return _changedLines;
+}
+
+const std::vector<DiffScope::Include> &DiffScope::includesOf(const std::string &path)
+{
+    auto cached = _includes.find(path);
+    if (cached != _includes.end())
+    {
+        return cached->second;
+    }
+    std::vector<Include> &includes = _includes[path];
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+        llvm::MemoryBuffer::getFile(path, -1, false);
+    if (!buffer)
+    {
+        return includes;
+    }
+    llvm::SmallVector<llvm::StringRef, 0> lines;
+    buffer.get()->getBuffer().split(lines, '\n');
+    for (llvm::StringRef line : lines)
+    {
+        llvm::StringRef directive = line.ltrim();
+        if (!directive.startswith("#"))
+        {
+            continue;
+        }
+        directive = directive.drop_front().ltrim();
+        if (directive.startswith("include"))
+        {
+            directive = directive.drop_front(7);
+            if (directive.startswith("_next"))
+            {
+                directive = directive.drop_front(5);
+            }
+        }
+        else if (directive.startswith("import"))
+        {
+            directive = directive.drop_front(6);
+        }
+        else
+        {
+            continue;
+        }
+        directive = directive.ltrim();
+        if (directive.empty() || (directive[0] != '"' && directive[0] != '<'))
+        {
+            continue;
+        }
+        size_t end = directive.find(directive[0] == '"' ? '"' : '>', 1);
+        if (end != llvm::StringRef::npos)
+        {
+            includes.push_back(Include(directive[0] == '"', directive.slice(1, end).str()));
+        }
+    }
+    return includes;
+}
+
+bool DiffScope::exists(const std::string &path)
+{
+    auto cached = _existingFiles.find(path);
+    if (cached != _existingFiles.end())
+    {
+        return cached->second;
+    }
+    bool isFile = llvm::sys::fs::is_regular_file(path);
+    _existingFiles[path] = isFile;
+    return isFile;
+}
+
+std::string DiffScope::resolve(const Include &include, const std::string &includingPath,
+    const std::vector<std::string> &quotePaths, const std::vector<std::string> &searchPaths)
+{
+    std::vector<std::string> directories;
+    if (include.first)
+    {
+        directories.push_back(llvm::sys::path::parent_path(includingPath));
+        directories.insert(directories.end(), quotePaths.begin(), quotePaths.end());
+    }
+    directories.insert(directories.end(), searchPaths.begin(), searchPaths.end());
+    for (const auto &directory : directories)
+    {
+        std::string candidate = normalizedPath(include.second, directory);
+        if (exists(candidate))
+        {
+            return candidate;
+        }
+    }
+    return "";
+}
+
+bool DiffScope::isInScope(const std::string &filePath,
+    const clang::tooling::CompileCommand &compileCommand)
+{
+    std::string sourcePath = normalizedPath(filePath, compileCommand.Directory);
+    if (_changedLines.containsFile(sourcePath))
+    {
+        return true;
+    }
+    if (!_hasChangedHeaders)
+    {
+        return false;
+    }
+
+    std::vector<std::string> quotePaths;
+    std::vector<std::string> searchPaths;
+    const std::vector<std::string> &arguments = compileCommand.CommandLine;
+    for (size_t index = 0; index < arguments.size(); index++)
+    {
+        llvm::StringRef argument = arguments[index];
+        for (llvm::StringRef flag : { "-iquote", "-isystem", "-idirafter", "-I" })
+        {
+            if (!argument.startswith(flag))
+            {
+                continue;
+            }
+            llvm::StringRef directory = argument.drop_front(flag.size());
+            if (directory.empty() && index + 1 < arguments.size())
+            {
+                directory = arguments[++index];
+            }
+            (flag == "-iquote" ? quotePaths : searchPaths).push_back(
+                normalizedPath(directory, compileCommand.Directory));
+            break;
+        }
+    }
+
+    std::set<std::string> visited { sourcePath };
+    std::vector<std::string> pending { sourcePath };
+    while (!pending.empty())
+    {
+        std::string path = pending.back();
+        pending.pop_back();
+        for (const Include &include : includesOf(path))
+        {
+            std::string includedPath = resolve(include, path, quotePaths, searchPaths);
+            if (includedPath.empty() || !visited.insert(includedPath).second)
+            {
+                continue;
+            }
+            if (_changedLines.containsFile(includedPath))
+            {
+                return true;
+            }
+            pending.push_back(includedPath);
+        }
+    }
+    return false;
+}
@@ -48,6 +48,10 @@
 
 #include <unistd.h>
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
 #include <sstream>
 
 #include <llvm/ADT/IntrusiveRefCntPtr.h>
@@ -57,6 +61,7 @@
 #include <llvm/Support/Host.h>
 #include <llvm/Support/raw_ostream.h>
 #include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/SourceManager.h>
 #include <clang/Driver/Compilation.h>
 #include <clang/Driver/Driver.h>
 #include <clang/Driver/Job.h>
@@ -67,11 +72,21 @@
 #include <clang/Tooling/CompilationDatabase.h>
 #include <clang/Tooling/Tooling.h>
 
+#include "oclint/Baseline.h"
 #include "oclint/CompilerInstance.h"
+#include "oclint/CostHistory.h"
 #include "oclint/DiagnosticDispatcher.h"
+#include "oclint/DiffScope.h"
 #include "oclint/GenericException.h"
+#include "oclint/GlobalSummaryIndex.h"
 #include "oclint/Logger.h"
 #include "oclint/Options.h"
+#include "oclint/ResultCollector.h"
+#include "oclint/RuleBase.h"
+#include "oclint/Statistics.h"
+#include "oclint/TimeBudget.h"
+#include "oclint/Version.h"
+#include "oclint/Violation.h"
 #include "oclint/ViolationSet.h"
 
 using namespace oclint;
@@ -127,7 +142,8 @@ static clang::CompilerInvocation *newInvocation(clang::DiagnosticsEngine *diagno
 static void constructCompileCommands(
     CompileCommandPairs &compileCommands,
     const clang::tooling::CompilationDatabase &compilationDatabase,
-    llvm::ArrayRef<std::string> sourcePaths)
+    llvm::ArrayRef<std::string> sourcePaths,
+    DiffScope *diffScope)
 {
     for (const auto &sourcePath : sourcePaths)
     {
@@ -141,6 +157,12 @@ static void constructCompileCommands(
         }
         for (auto &compileCommand : compileCmdsForFile)
         {
+            if (diffScope && !diffScope->isInScope(filePath, compileCommand))
+            {
+                LOG_VERBOSE("Skipping unchanged ");
+                LOG_VERBOSE_LINE(filePath.c_str());
+                continue;
+            }
             compileCommands.push_back(std::make_pair(filePath, compileCommand));
         }
     }
@@ -253,6 +275,15 @@ static std::vector<std::string> adjustArguments(std::vector<std::string> &unadju
     return argAdjuster(unadjustedCmdLine, filename);
 }
 
+static void translationUnitTimedOut(const std::string &path, const std::string &stage)
+{
+    Statistics::translationUnitTimedOut(path, stage);
+    std::string message = "analysis exceeded the time budget of " +
+        std::to_string(TimeBudget::translationUnitBudget().count() / 1000) +
+        " seconds in the " + stage + ", the source was not analyzed";
+    ResultCollector::getInstance()->addError(Violation(nullptr, path, 0, 0, 0, 0, message));
+}
+
 static void constructCompilersAndFileManagers(std::vector<oclint::CompilerInstance *> &compilers,
     std::vector<clang::FileManager *> &fileManagers,
     CompileCommandPairs &compileCommands,
@@ -280,8 +311,14 @@ static void constructCompilersAndFileManagers(std::vector<oclint::CompilerInstan
         clang::FileManager *fileManager = newFileManager();
         oclint::CompilerInstance *compiler = newCompilerInstance(compilerInvocation, fileManager);
 
+        TimeBudget::startTranslationUnit();
         compiler->start();
-        if (!compiler->getDiagnostics().hasErrorOccurred() && compiler->hasASTContext())
+        if (compiler->hasTimedOut())
+        {
+            LOG_VERBOSE(" - Timed out");
+            translationUnitTimedOut(compileCommand.first, "frontend");
+        }
+        else if (!compiler->getDiagnostics().hasErrorOccurred() && compiler->hasASTContext())
         {
             LOG_VERBOSE(" - Success");
             compilers.push_back(compiler);
@@ -317,8 +354,14 @@ static void invokeClangStaticAnalyzer(
         oclint::CompilerInstance *compiler = newCompilerInstance(compilerInvocation,
             fileManager, true);
 
+        TimeBudget::startTranslationUnit();
         compiler->start();
-        if (!compiler->getDiagnostics().hasErrorOccurred() && compiler->hasASTContext())
+        if (compiler->hasTimedOut())
+        {
+            LOG_VERBOSE(" - Timed out");
+            translationUnitTimedOut(compileCommand.first, "clang static analyzer");
+        }
+        else if (!compiler->getDiagnostics().hasErrorOccurred() && compiler->hasASTContext())
         {
             LOG_VERBOSE(" - Done");
         }
@@ -333,12 +376,31 @@ static void invokeClangStaticAnalyzer(
     }
 }
 
+static void releaseCompilersAndFileManagers(std::vector<oclint::CompilerInstance *> &compilers,
+    std::vector<clang::FileManager *> &fileManagers)
+{
+    // send out the signals to release or simply leak resources
+    for (size_t compilerIndex = 0; compilerIndex != compilers.size(); ++compilerIndex)
+    {
+        compilers.at(compilerIndex)->end();
+        compilers.at(compilerIndex)->resetAndLeakFileManager();
+        fileManagers.at(compilerIndex)->clearStatCaches();
+        delete compilers.at(compilerIndex);
+        delete fileManagers.at(compilerIndex);
+    }
+}
+
 static void invoke(CompileCommandPairs &compileCommands,
-    std::string &mainExecutable, oclint::Analyzer &analyzer)
+    std::string &mainExecutable, oclint::Analyzer &analyzer, bool withProcessing = true)
 {
     std::vector<oclint::CompilerInstance *> compilers;
     std::vector<clang::FileManager *> fileManagers;
+    size_t numberOfTimeouts = Statistics::timedOutTranslationUnits().size();
     constructCompilersAndFileManagers(compilers, fileManagers, compileCommands, mainExecutable);
+    if (Statistics::timedOutTranslationUnits().size() != numberOfTimeouts)
+    {
+        analyzer.summariesMissing();
+    }
 
     // collect a collection of AST contexts
     std::vector<clang::ASTContext *> localContexts;
@@ -348,45 +410,300 @@ static void invoke(CompileCommandPairs &compileCommands,
     }
 
     // use the analyzer to do the actual analysis
-    analyzer.preprocess(localContexts);
+    if (withProcessing)
+    {
+        analyzer.preprocess(localContexts);
+    }
     analyzer.analyze(localContexts);
-    analyzer.postprocess(localContexts);
+    if (withProcessing)
+    {
+        analyzer.postprocess(localContexts);
+    }
 
-    // send out the signals to release or simply leak resources
-    for (size_t compilerIndex = 0; compilerIndex != compilers.size(); ++compilerIndex)
+    releaseCompilersAndFileManagers(compilers, fileManagers);
+}
+
+static void invokeAndRecordCost(
+    const std::pair<std::string, clang::tooling::CompileCommand> &compileCommand,
+    std::string &mainExecutable, oclint::Analyzer &analyzer, bool withProcessing,
+    CostHistory &history)
+{
+    auto start = std::chrono::steady_clock::now();
+    CompileCommandPairs oneCompileCommand { compileCommand };
+    invoke(oneCompileCommand, mainExecutable, analyzer, withProcessing);
+    history.record(compileCommand.first, std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start));
+}
+
+static bool stopsEarly(size_t numberOfRemainingSources)
+{
+    if (!option::failFast())
     {
-        compilers.at(compilerIndex)->end();
-        compilers.at(compilerIndex)->resetAndLeakFileManager();
-        fileManagers.at(compilerIndex)->clearStatCaches();
-        delete compilers.at(compilerIndex);
-        delete fileManagers.at(compilerIndex);
+        return false;
+    }
+    ResultCollector *results = ResultCollector::getInstance();
+    if (results->numberOfViolationsWithPriority(1) <= option::maxP1() &&
+        results->numberOfViolationsWithPriority(2) <= option::maxP2() &&
+        results->numberOfViolationsWithPriority(3) <= option::maxP3())
+    {
+        return false;
+    }
+    if (numberOfRemainingSources > 0)
+    {
+        LOG_VERBOSE_LINE("Violations exceed threshold, skipping the remaining "
+            << numberOfRemainingSources << " sources");
+        results->markTruncated();
+    }
+    return true;
+}
+
+static std::string globalIndexScope()
+{
+    std::vector<std::string> ruleIdentifiers;
+    for (RuleBase *rule : option::rulesetFilter().filteredRules())
+    {
+        ruleIdentifiers.push_back(rule->identifier());
+    }
+    std::sort(ruleIdentifiers.begin(), ruleIdentifiers.end());
+
+    std::string scope = Version::identifier();
+    for (const auto &ruleIdentifier : ruleIdentifiers)
+    {
+        scope += "\n" + ruleIdentifier;
+    }
+    for (const auto &ruleConfiguration : option::ruleConfigurations())
+    {
+        scope += "\n" + ruleConfiguration;
+    }
+    return scope;
+}
+
+static std::string translationUnitKey(
+    const std::pair<std::string, clang::tooling::CompileCommand> &compileCommand)
+{
+    std::string command = compileCommand.second.Directory;
+    for (const auto &argument : compileCommand.second.CommandLine)
+    {
+        command += '\0' + argument;
+    }
+    return compileCommand.first + "\n" + GlobalSummaryIndex::digest(command);
+}
+
+static std::vector<std::string> dependencyPaths(oclint::CompilerInstance &compiler)
+{
+    std::vector<std::string> paths;
+    clang::SourceManager &sourceManager = compiler.getSourceManager();
+    for (auto file = sourceManager.fileinfo_begin(); file != sourceManager.fileinfo_end(); ++file)
+    {
+        llvm::SmallString<256> path(file->first->getName());
+        llvm::sys::fs::make_absolute(path);
+        paths.push_back(path.str());
+    }
+    return paths;
+}
+
+static TranslationUnitResults resultsSince(size_t numberOfViolationSets,
+    size_t numberOfErrors, size_t numberOfWarnings)
+{
+    ResultCollector *collector = ResultCollector::getInstance();
+    TranslationUnitResults results;
+    const std::vector<ViolationSet *> &collection = collector->getCollection();
+    for (size_t index = numberOfViolationSets; index < collection.size(); index++)
+    {
+        const std::vector<Violation> &violations = collection[index]->getViolations();
+        results.violations.insert(results.violations.end(), violations.begin(), violations.end());
+    }
+    const std::vector<Violation> &errors = collector->getCompilerErrorSet()->getViolations();
+    results.errors.assign(errors.begin() + numberOfErrors, errors.end());
+    const std::vector<Violation> &warnings = collector->getCompilerWarningSet()->getViolations();
+    results.warnings.assign(warnings.begin() + numberOfWarnings, warnings.end());
+    return results;
+}
+
+static void reportAgain(const TranslationUnitResults &results)
+{
+    ResultCollector *collector = ResultCollector::getInstance();
+    auto violationSet = new ViolationSet();
+    for (const auto &violation : results.violations)
+    {
+        violationSet->addViolation(violation);
+    }
+    collector->add(violationSet);
+    for (const auto &error : results.errors)
+    {
+        collector->addError(error);
+    }
+    for (const auto &warning : results.warnings)
+    {
+        collector->addWarning(warning);
+    }
+}
+
+static void invokeIncrementally(CompileCommandPairs &compileCommands,
+    std::string &mainExecutable, oclint::Analyzer &analyzer, CostHistory &history)
+{
+    GlobalSummaryIndex index(globalIndexScope(), option::rulesetFilter().filteredRules());
+    index.load(option::globalIndexPath());
+
+    for (size_t position = 0; position < compileCommands.size(); position++)
+    {
+        if (stopsEarly(compileCommands.size() - position))
+        {
+            break;
+        }
+        auto &compileCommand = compileCommands[position];
+        std::string key = translationUnitKey(compileCommand);
+        TranslationUnitSummaries summaries;
+        TranslationUnitResults results;
+        if (index.lookup(key, summaries, results))
+        {
+            LOG_VERBOSE("Reusing summaries of ");
+            LOG_VERBOSE_LINE(compileCommand.first.c_str());
+            analyzer.reuseSummaries(summaries);
+            reportAgain(results);
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        ResultCollector *collector = ResultCollector::getInstance();
+        size_t numberOfViolationSets = collector->getCollection().size();
+        size_t numberOfErrors = collector->getCompilerErrorSet()->numberOfViolations();
+        size_t numberOfWarnings = collector->getCompilerWarningSet()->numberOfViolations();
+        CompileCommandPairs oneCompileCommand { compileCommand };
+        std::vector<oclint::CompilerInstance *> compilers;
+        std::vector<clang::FileManager *> fileManagers;
+        size_t numberOfTimeouts = Statistics::timedOutTranslationUnits().size();
+        constructCompilersAndFileManagers(compilers, fileManagers,
+            oneCompileCommand, mainExecutable);
+        if (Statistics::timedOutTranslationUnits().size() != numberOfTimeouts)
+        {
+            analyzer.summariesMissing();
+            index.invalidate(key);
+        }
+        if (!compilers.empty())
+        {
+            std::vector<clang::ASTContext *> localContexts { &compilers.front()->getASTContext() };
+            analyzer.analyze(localContexts);
+            // summaries of a translation unit that ran out of time are incomplete
+            if (analyzer.lastSummariesComplete())
+            {
+                index.update(key, dependencyPaths(*compilers.front()), analyzer.lastSummaries(),
+                    resultsSince(numberOfViolationSets, numberOfErrors, numberOfWarnings));
+            }
+            else
+            {
+                index.invalidate(key);
+            }
+        }
+        releaseCompilersAndFileManagers(compilers, fileManagers);
+        history.record(compileCommand.first, std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start));
+    }
+
+    if (ResultCollector::getInstance()->isTruncated())
+    {
+        // the sources skipped by this run are still valid for the next one
+        index.keepUnvisitedEntries();
+    }
+    if (!index.save(option::globalIndexPath()))
+    {
+        llvm::errs() << "Cannot write global index to " << option::globalIndexPath() << ".\n";
+    }
+}
+
+static void invokeGlobally(CompileCommandPairs &compileCommands,
+    std::string &mainExecutable, oclint::Analyzer &analyzer, CostHistory &history)
+{
+    // rules summarize each translation unit while it is analyzed, so one AST at a time
+    // is kept alive, and the analyzer reduces the summaries when postprocessing
+    std::vector<clang::ASTContext *> noContexts;
+    analyzer.preprocess(noContexts);
+    if (option::hasGlobalIndexPath())
+    {
+        invokeIncrementally(compileCommands, mainExecutable, analyzer, history);
+    }
+    else
+    {
+        for (size_t index = 0; index < compileCommands.size(); index++)
+        {
+            if (stopsEarly(compileCommands.size() - index))
+            {
+                break;
+            }
+            invokeAndRecordCost(compileCommands[index], mainExecutable, analyzer, false, history);
+        }
+    }
+    // without the summaries of the skipped sources, everything they use would look unused
+    if (!ResultCollector::getInstance()->isTruncated())
+    {
+        analyzer.postprocess(noContexts);
     }
 }
 
 void Driver::run(const clang::tooling::CompilationDatabase &compilationDatabase,
-    llvm::ArrayRef<std::string> sourcePaths, oclint::Analyzer &analyzer)
+    llvm::ArrayRef<std::string> sourcePaths, oclint::Analyzer &analyzer, DiffScope *diffScope)
 {
     CompileCommandPairs compileCommands;
-    constructCompileCommands(compileCommands, compilationDatabase, sourcePaths);
+    constructCompileCommands(compileCommands, compilationDatabase, sourcePaths, diffScope);
 
     static int staticSymbol;
     std::string mainExecutable = llvm::sys::fs::getMainExecutable("oclint", &staticSymbol);
 
-    if (option::enableGlobalAnalysis())
+    if (option::failFast())
     {
-        invoke(compileCommands, mainExecutable, analyzer);
+        // only the violations that the baseline leaves in the report count towards the
+        // thresholds, it is loaded separately since matching consumes its occurrences
+        std::function<bool(const Violation &)> isKnownViolation;
+        if (option::hasBaselinePath())
+        {
+            std::shared_ptr<Baseline> baseline(new Baseline(option::workingPath()));
+            if (!baseline->load(option::baselinePath()))
+            {
+                throw oclint::GenericException("cannot read baseline " + option::baselinePath());
+            }
+            isKnownViolation = [baseline](const Violation &violation)
+            {
+                return baseline->match(violation);
+            };
+        }
+        ResultCollector::getInstance()->countViolations(option::allowDuplicatedViolations(),
+            isKnownViolation);
+    }
+    TimeBudget::configure(std::chrono::seconds(option::translationUnitTimeout()),
+        std::chrono::seconds(option::ruleTimeout()));
+
+    // the previous history is loaded so the sources outside of this run keep their entries
+    CostHistory history;
+    if (option::hasCostHistoryPath() && !history.load(option::costHistoryPath()))
+    {
+        LOG_VERBOSE_LINE(("No cost history at " + option::costHistoryPath()).c_str());
+    }
+
+    // metrics are exported one translation unit at a time to keep memory bounded
+    if (option::enableGlobalAnalysis() && !option::metricsOnly())
+    {
+        invokeGlobally(compileCommands, mainExecutable, analyzer, history);
     }
     else
     {
-        for (auto &compileCommand : compileCommands)
+        for (size_t index = 0; index < compileCommands.size(); index++)
         {
-            CompileCommandPairs oneCompileCommand { compileCommand };
-            invoke(oneCompileCommand, mainExecutable, analyzer);
+            if (stopsEarly(compileCommands.size() - index))
+            {
+                break;
+            }
+            invokeAndRecordCost(compileCommands[index], mainExecutable, analyzer, true, history);
         }
     }
 
-    if (option::enableClangChecker())
+    if (option::enableClangChecker() && !option::metricsOnly() &&
+        !ResultCollector::getInstance()->isTruncated())
     {
         invokeClangStaticAnalyzer(compileCommands, mainExecutable);
     }
+
+    if (option::hasCostHistoryPath() && !history.save(option::costHistoryPath()))
+    {
+        llvm::errs() << "Cannot write cost history to " << option::costHistoryPath() << ".\n";
+    }
 }
@@ -0,0 +1,378 @@
+#include "oclint/GlobalSummaryIndex.h"
+
+#include <cstdint>
+#include <fstream>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+
+#include "oclint/Logger.h"
+#include "oclint/RuleBase.h"
+
+using namespace oclint;
+
+static const char indexMagic[] = "OCLINTGI";
+static const uint32_t indexVersion = 2;
+
+enum RecordKind
+{
+    VIOLATION_RECORD,
+    ERROR_RECORD,
+    WARNING_RECORD
+};
+
+namespace
+{
+
+class IndexReader
+{
+private:
+    llvm::StringRef _remaining;
+
+public:
+    explicit IndexReader(llvm::StringRef content) : _remaining(content)
+    {
+    }
+
+    bool readMagic()
+    {
+        llvm::StringRef magic(indexMagic);
+        if (!_remaining.startswith(magic))
+        {
+            return false;
+        }
+        _remaining = _remaining.drop_front(magic.size());
+        return true;
+    }
+
+    bool read(uint32_t &value)
+    {
+        if (_remaining.size() < 4)
+        {
+            return false;
+        }
+        const unsigned char *bytes = _remaining.bytes_begin();
+        value = uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8 |
+            uint32_t(bytes[2]) << 16 | uint32_t(bytes[3]) << 24;
+        _remaining = _remaining.drop_front(4);
+        return true;
+    }
+
+    bool read(llvm::StringRef &value)
+    {
+        uint32_t length;
+        if (!read(length) || _remaining.size() < length)
+        {
+            return false;
+        }
+        value = _remaining.substr(0, length);
+        _remaining = _remaining.drop_front(length);
+        return true;
+    }
+
+    bool read(std::vector<std::pair<llvm::StringRef, llvm::StringRef>> &pairs)
+    {
+        uint32_t count;
+        if (!read(count))
+        {
+            return false;
+        }
+        for (uint32_t index = 0; index < count; index++)
+        {
+            llvm::StringRef first;
+            llvm::StringRef second;
+            if (!read(first) || !read(second))
+            {
+                return false;
+            }
+            pairs.push_back(std::make_pair(first, second));
+        }
+        return true;
+    }
+};
+
+void write(std::ostream &out, uint32_t value)
+{
+    char bytes[] = {
+        char(value & 0xff), char(value >> 8 & 0xff), char(value >> 16 & 0xff), char(value >> 24)
+    };
+    out.write(bytes, sizeof(bytes));
+}
+
+void write(std::ostream &out, llvm::StringRef value)
+{
+    write(out, uint32_t(value.size()));
+    out.write(value.data(), value.size());
+}
+
+void write(std::ostream &out, const std::vector<std::pair<llvm::StringRef, llvm::StringRef>> &pairs)
+{
+    write(out, uint32_t(pairs.size()));
+    for (const auto &pair : pairs)
+    {
+        write(out, pair.first);
+        write(out, pair.second);
+    }
+}
+
+} // end namespace
+
+GlobalSummaryIndex::GlobalSummaryIndex(std::string scope, const std::vector<RuleBase *> &rules)
+    : _scope(std::move(scope))
+{
+    for (RuleBase *rule : rules)
+    {
+        _rules[rule->identifier()] = rule;
+    }
+}
+
+llvm::StringRef GlobalSummaryIndex::keep(std::string value)
+{
+    _strings.push_back(std::move(value));
+    return _strings.back();
+}
+
+std::string GlobalSummaryIndex::digest(llvm::StringRef content)
+{
+    llvm::MD5 hash;
+    hash.update(content);
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    llvm::SmallString<32> hex;
+    llvm::MD5::stringifyResult(result, hex);
+    return hex.str().str();
+}
+
+const std::string &GlobalSummaryIndex::digestOfFile(const std::string &path)
+{
+    auto known = _fileDigests.find(path);
+    if (known != _fileDigests.end())
+    {
+        return known->second;
+    }
+    std::string fileDigest;
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+        llvm::MemoryBuffer::getFile(path, -1, false);
+    if (buffer)
+    {
+        fileDigest = digest(buffer.get()->getBuffer());
+    }
+    return _fileDigests.emplace(path, fileDigest).first->second;
+}
+
+bool GlobalSummaryIndex::load(const std::string &path)
+{
+    _entries.clear();
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+        llvm::MemoryBuffer::getFile(path, -1, false);
+    if (!buffer)
+    {
+        LOG_VERBOSE_LINE(("No global index at " + path).c_str());
+        return false;
+    }
+    _mapped = std::move(buffer.get());
+
+    IndexReader reader(_mapped->getBuffer());
+    uint32_t version;
+    llvm::StringRef scope;
+    uint32_t count;
+    if (!reader.readMagic() || !reader.read(version) || version != indexVersion ||
+        !reader.read(scope) || !reader.read(count))
+    {
+        LOG_VERBOSE_LINE(("Ignoring unreadable global index at " + path).c_str());
+        return false;
+    }
+    if (scope != _scope)
+    {
+        LOG_VERBOSE_LINE("Ignoring global index of other rules or configurations");
+        return false;
+    }
+    for (uint32_t index = 0; index < count; index++)
+    {
+        llvm::StringRef key;
+        Entry entry;
+        entry.current = false;
+        uint32_t numberOfRecords = 0;
+        bool readable = reader.read(key) && reader.read(entry.dependencies) &&
+            reader.read(entry.summaries) && reader.read(numberOfRecords);
+        for (uint32_t record = 0; readable && record < numberOfRecords; record++)
+        {
+            Record value;
+            readable = reader.read(value.kind) && reader.read(value.rule) &&
+                reader.read(value.path) && reader.read(value.range[0]) &&
+                reader.read(value.range[1]) && reader.read(value.range[2]) &&
+                reader.read(value.range[3]) && reader.read(value.message);
+            entry.records.push_back(value);
+        }
+        if (!readable)
+        {
+            LOG_VERBOSE_LINE(("Ignoring truncated global index at " + path).c_str());
+            _entries.clear();
+            return false;
+        }
+        _entries[key.str()] = entry;
+    }
+    return true;
+}
+
+bool GlobalSummaryIndex::save(const std::string &path) const
+{
+    std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream out(temporaryPath, std::ios::binary | std::ios::trunc);
+        out.write(indexMagic, sizeof(indexMagic) - 1);
+        write(out, indexVersion);
+        write(out, _scope);
+
+        // translation units that were not part of this run are dropped
+        uint32_t count = 0;
+        for (const auto &entry : _entries)
+        {
+            count += entry.second.current;
+        }
+        write(out, count);
+        for (const auto &entry : _entries)
+        {
+            if (entry.second.current)
+            {
+                write(out, entry.first);
+                write(out, entry.second.dependencies);
+                write(out, entry.second.summaries);
+                write(out, uint32_t(entry.second.records.size()));
+                for (const auto &record : entry.second.records)
+                {
+                    write(out, record.kind);
+                    write(out, record.rule);
+                    write(out, record.path);
+                    for (uint32_t value : record.range)
+                    {
+                        write(out, value);
+                    }
+                    write(out, record.message);
+                }
+            }
+        }
+        if (!out)
+        {
+            return false;
+        }
+    }
+    return !llvm::sys::fs::rename(temporaryPath, path);
+}
+
+bool GlobalSummaryIndex::lookup(const std::string &key, TranslationUnitSummaries &summaries,
+    TranslationUnitResults &results)
+{
+    auto found = _entries.find(key);
+    if (found == _entries.end())
+    {
+        return false;
+    }
+    for (const auto &dependency : found->second.dependencies)
+    {
+        const std::string &fileDigest = digestOfFile(dependency.first);
+        if (fileDigest.empty() || fileDigest != dependency.second)
+        {
+            return false;
+        }
+    }
+    TranslationUnitResults foundResults;
+    for (const auto &record : found->second.records)
+    {
+        RuleBase *rule = nullptr;
+        if (record.kind == VIOLATION_RECORD)
+        {
+            auto known = _rules.find(record.rule.str());
+            if (known == _rules.end())
+            {
+                return false;
+            }
+            rule = known->second;
+        }
+        Violation violation(rule, record.path.str(), record.range[0], record.range[1],
+            record.range[2], record.range[3], record.message.str());
+        switch (record.kind)
+        {
+            case VIOLATION_RECORD:
+                foundResults.violations.push_back(violation);
+                break;
+            case ERROR_RECORD:
+                foundResults.errors.push_back(violation);
+                break;
+            default:
+                foundResults.warnings.push_back(violation);
+                break;
+        }
+    }
+    for (const auto &summary : found->second.summaries)
+    {
+        summaries[summary.first] = summary.second;
+    }
+    results = foundResults;
+    found->second.current = true;
+    return true;
+}
+
+void GlobalSummaryIndex::keep(uint32_t kind, const std::vector<Violation> &violations,
+    std::vector<Record> &records)
+{
+    for (const auto &violation : violations)
+    {
+        Record record;
+        record.kind = kind;
+        record.rule = violation.rule ? keep(violation.rule->identifier()) : llvm::StringRef();
+        record.path = keep(violation.path);
+        record.range[0] = violation.startLine;
+        record.range[1] = violation.startColumn;
+        record.range[2] = violation.endLine;
+        record.range[3] = violation.endColumn;
+        record.message = keep(violation.message);
+        records.push_back(record);
+    }
+}
+
+void GlobalSummaryIndex::update(const std::string &key,
+    const std::vector<std::string> &dependencyPaths, const TranslationUnitSummaries &summaries,
+    const TranslationUnitResults &results)
+{
+    Entry entry;
+    for (const auto &dependencyPath : dependencyPaths)
+    {
+        const std::string &fileDigest = digestOfFile(dependencyPath);
+        if (fileDigest.empty())
+        {
+            // a file that cannot be read back cannot be validated next time
+            _entries.erase(key);
+            return;
+        }
+        entry.dependencies.push_back(std::make_pair(keep(dependencyPath), llvm::StringRef(fileDigest)));
+    }
+    for (const auto &summary : summaries)
+    {
+        entry.summaries.push_back(std::make_pair(keep(summary.first), keep(summary.second)));
+    }
+    keep(VIOLATION_RECORD, results.violations, entry.records);
+    keep(ERROR_RECORD, results.errors, entry.records);
+    keep(WARNING_RECORD, results.warnings, entry.records);
+    entry.current = true;
+    _entries[key] = entry;
+}
+
+void GlobalSummaryIndex::invalidate(const std::string &key)
+{
+    _entries.erase(key);
+}
+
+void GlobalSummaryIndex::keepUnvisitedEntries()
+{
+    for (auto &entry : _entries)
+    {
+        entry.second.current = true;
+    }
+}
+
+int GlobalSummaryIndex::numberOfEntries() const
+{
+    return _entries.size();
+}
@@ -0,0 +1,140 @@
+#include "oclint/LexicalPrerequisites.h"
+
+#include <algorithm>
+
+#include <clang/AST/ASTContext.h>
+#include <clang/Basic/CharInfo.h>
+#include <clang/Basic/IdentifierTable.h>
+#include <clang/Basic/SourceManager.h>
+
+#include "oclint/RuleBase.h"
+
+using namespace oclint;
+
+static bool isIdentifier(llvm::StringRef text)
+{
+    return !text.empty() && clang::isIdentifierHead(text.front()) &&
+        std::all_of(text.begin(), text.end(),
+            [](char eachChar) { return clang::isIdentifierBody(eachChar); });
+}
+
+static bool isKeyword(const clang::IdentifierInfo &identifier)
+{
+    return identifier.getTokenID() != clang::tok::identifier ||
+        identifier.getObjCKeywordID() != clang::tok::objc_not_keyword ||
+        identifier.getPPKeywordID() != clang::tok::pp_not_keyword;
+}
+
+static bool containsWord(llvm::StringRef buffer, llvm::StringRef word)
+{
+    for (size_t position = buffer.find(word); position != llvm::StringRef::npos;
+        position = buffer.find(word, position + 1))
+    {
+        size_t end = position + word.size();
+        if ((position == 0 || !clang::isIdentifierBody(buffer[position - 1])) &&
+            (end == buffer.size() || !clang::isIdentifierBody(buffer[end])))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static std::vector<llvm::StringRef> loadedBuffers(clang::SourceManager &sourceManager)
+{
+    std::vector<llvm::StringRef> buffers;
+    for (auto it = sourceManager.fileinfo_begin(); it != sourceManager.fileinfo_end(); ++it)
+    {
+        const llvm::MemoryBuffer *buffer = it->second->getRawBuffer();
+        if (buffer)
+        {
+            buffers.push_back(buffer->getBuffer());
+        }
+    }
+    return buffers;
+}
+
+static bool isPresent(llvm::StringRef prerequisite,
+    clang::IdentifierTable &identifiers, const std::vector<llvm::StringRef> &buffers)
+{
+    bool identifier = isIdentifier(prerequisite);
+    if (identifier)
+    {
+        auto identifierIt = identifiers.find(prerequisite);
+        if (identifierIt == identifiers.end())
+        {
+            return false;
+        }
+        if (!isKeyword(*identifierIt->getValue()))
+        {
+            return true;
+        }
+    }
+
+    // keywords are always in the identifier table, so look for them in the text
+    return std::any_of(buffers.begin(), buffers.end(), [&](llvm::StringRef buffer) {
+        return identifier ? containsWord(buffer, prerequisite) :
+            buffer.find(prerequisite) != llvm::StringRef::npos;
+    });
+}
+
+LexicalPrerequisites::LexicalPrerequisites(const std::vector<RuleBase *> &rules)
+{
+    for (RuleBase *rule : rules)
+    {
+        std::vector<unsigned> indices;
+        for (const std::string &prerequisite : rule->lexicalPrerequisites())
+        {
+            auto prerequisiteIt =
+                std::find(_prerequisites.begin(), _prerequisites.end(), prerequisite);
+            indices.push_back(prerequisiteIt - _prerequisites.begin());
+            if (prerequisiteIt == _prerequisites.end())
+            {
+                _prerequisites.push_back(prerequisite);
+            }
+        }
+        _rulePrerequisites.push_back(indices);
+    }
+}
+
+std::vector<bool> LexicalPrerequisites::presence(clang::ASTContext &context,
+    const std::vector<unsigned> &ruleIndices) const
+{
+    std::vector<bool> present(_prerequisites.size(), true);
+    // identifiers and headers from precompiled headers or modules are loaded lazily,
+    // so nothing can be ruled out
+    if (_prerequisites.empty() || context.getExternalSource())
+    {
+        return present;
+    }
+
+    std::vector<bool> needed(_prerequisites.size(), false);
+    for (unsigned ruleIndex : ruleIndices)
+    {
+        for (unsigned index : _rulePrerequisites.at(ruleIndex))
+        {
+            needed[index] = true;
+        }
+    }
+    if (std::find(needed.begin(), needed.end(), true) == needed.end())
+    {
+        return present;
+    }
+
+    std::vector<llvm::StringRef> buffers = loadedBuffers(context.getSourceManager());
+    for (unsigned index = 0; index < _prerequisites.size(); index++)
+    {
+        if (needed[index])
+        {
+            present[index] = isPresent(_prerequisites[index], context.Idents, buffers);
+        }
+    }
+    return present;
+}
+
+bool LexicalPrerequisites::isSatisfied(unsigned ruleIndex, const std::vector<bool> &presence) const
+{
+    const std::vector<unsigned> &indices = _rulePrerequisites.at(ruleIndex);
+    return std::all_of(indices.begin(), indices.end(),
+        [&presence](unsigned index) { return presence[index]; });
+}
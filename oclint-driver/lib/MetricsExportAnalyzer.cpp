@@ -0,0 +1,97 @@
+#include "oclint/MetricsExportAnalyzer.h"
+
+#include <clang/AST/AST.h>
+#include <clang/AST/RecursiveASTVisitor.h>
+
+#include "oclint/Logger.h"
+#include "oclint/MetricsExportWriter.h"
+#include "oclint/Statistics.h"
+
+using namespace oclint;
+
+namespace
+{
+
+class FunctionMetricsExporter : public clang::RecursiveASTVisitor<FunctionMetricsExporter>
+{
+private:
+    clang::SourceManager &_sourceManager;
+    MetricsExportWriter &_writer;
+
+    void exportMetrics(clang::Decl *decl, const std::string &name)
+    {
+        FunctionMetricsRecord record;
+        clang::PresumedLoc location = _sourceManager.getPresumedLoc(decl->getLocStart());
+        record.path = location.isValid() ? location.getFilename() : "";
+        record.line = location.isValid() ? location.getLine() : 0;
+        record.column = location.isValid() ? location.getColumn() : 0;
+        record.name = name;
+        record.metrics = CombinedMetric().calculate(decl);
+        _writer.write(record);
+    }
+
+public:
+    FunctionMetricsExporter(clang::SourceManager &sourceManager, MetricsExportWriter &writer)
+        : _sourceManager(sourceManager), _writer(writer)
+    {
+    }
+
+    bool VisitFunctionDecl(clang::FunctionDecl *decl)
+    {
+        if (decl->doesThisDeclarationHaveABody())
+        {
+            exportMetrics(decl, decl->getQualifiedNameAsString());
+        }
+        return true;
+    }
+
+    bool VisitObjCMethodDecl(clang::ObjCMethodDecl *decl)
+    {
+        if (decl->hasBody())
+        {
+            std::string className;
+            if (decl->getClassInterface())
+            {
+                className = decl->getClassInterface()->getNameAsString();
+            }
+            exportMetrics(decl, std::string(decl->isInstanceMethod() ? "-[" : "+[") +
+                className + " " + decl->getSelector().getAsString() + "]");
+        }
+        return true;
+    }
+};
+
+} // end namespace
+
+MetricsExportAnalyzer::MetricsExportAnalyzer(MetricsExportWriter &writer) : _writer(writer)
+{
+}
+
+void MetricsExportAnalyzer::analyze(std::vector<clang::ASTContext *> &contexts)
+{
+    for (const auto& context : contexts)
+    {
+        clang::SourceManager &sourceManager = context->getSourceManager();
+        LOG_VERBOSE("Exporting metrics of ");
+        LOG_VERBOSE(sourceManager.getFilename(
+            sourceManager.getLocForStartOfFile(sourceManager.getMainFileID())).str().c_str());
+
+        FunctionMetricsExporter exporter(sourceManager, _writer);
+        clang::DeclContext *tu = context->getTranslationUnitDecl();
+        for (clang::DeclContext::decl_iterator it = tu->decls_begin(), declEnd = tu->decls_end();
+            it != declEnd; ++it)
+        {
+            clang::SourceLocation startLocation = (*it)->getLocStart();
+            if (startLocation.isValid() &&
+                sourceManager.getMainFileID() == sourceManager.getFileID(startLocation))
+            {
+                (void) /* explicitly ignore the return of this function */
+                    exporter.TraverseDecl(*it);
+            }
+        }
+        _writer.flush();
+
+        Statistics::translationUnitAnalyzed();
+        LOG_VERBOSE_LINE(" - Done");
+    }
+}
@@ -0,0 +1,147 @@
+#include "oclint/MetricsExportWriter.h"
+
+using namespace oclint;
+
+static void writeCSVField(std::ostream &out, const std::string &value)
+{
+    if (value.find_first_of(",\"\r\n") == std::string::npos)
+    {
+        out << value;
+        return;
+    }
+    out << '"';
+    for (char c : value)
+    {
+        if (c == '"')
+        {
+            out << '"';
+        }
+        out << c;
+    }
+    out << '"';
+}
+
+static void writeJSONString(std::ostream &out, const std::string &value)
+{
+    static const char *hexDigits = "0123456789abcdef";
+    out << '"';
+    for (char c : value)
+    {
+        switch (c)
+        {
+        case '"':
+            out << "\\\"";
+            break;
+        case '\\':
+            out << "\\\\";
+            break;
+        case '\n':
+            out << "\\n";
+            break;
+        case '\r':
+            out << "\\r";
+            break;
+        case '\t':
+            out << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                out << "\\u00" << hexDigits[(c >> 4) & 0xf] << hexDigits[c & 0xf];
+            }
+            else
+            {
+                out << c;
+            }
+        }
+    }
+    out << '"';
+}
+
+MetricsExportWriter::MetricsExportWriter(std::ostream &out, Format format)
+    : _out(out), _format(format), _started(false)
+{
+}
+
+bool MetricsExportWriter::parseFormat(const std::string &name, Format &format)
+{
+    if (name == "csv")
+    {
+        format = CSV;
+        return true;
+    }
+    if (name == "json")
+    {
+        format = JSON;
+        return true;
+    }
+    return false;
+}
+
+void MetricsExportWriter::writeCSVHeader()
+{
+    if (!_started)
+    {
+        _out << "path,line,column,function,ccn,npath,ncss,depth,lines\n";
+        _started = true;
+    }
+}
+
+void MetricsExportWriter::writeCSV(const FunctionMetricsRecord &record)
+{
+    writeCSVField(_out, record.path);
+    _out << ',' << record.line << ',' << record.column << ',';
+    writeCSVField(_out, record.name);
+    _out << ',' << record.metrics.cyclomaticComplexity
+        << ',' << record.metrics.nPathComplexity
+        << ',' << record.metrics.ncss
+        << ',' << record.metrics.stmtDepth
+        << ',' << record.metrics.lineCount << '\n';
+}
+
+void MetricsExportWriter::writeJSON(const FunctionMetricsRecord &record)
+{
+    _out << "{\"path\":";
+    writeJSONString(_out, record.path);
+    _out << ",\"line\":" << record.line << ",\"column\":" << record.column << ",\"function\":";
+    writeJSONString(_out, record.name);
+    _out << ",\"ccn\":" << record.metrics.cyclomaticComplexity
+        << ",\"npath\":" << record.metrics.nPathComplexity
+        << ",\"ncss\":" << record.metrics.ncss
+        << ",\"depth\":" << record.metrics.stmtDepth
+        << ",\"lines\":" << record.metrics.lineCount << "}";
+}
+
+void MetricsExportWriter::write(const FunctionMetricsRecord &record)
+{
+    if (_format == CSV)
+    {
+        writeCSVHeader();
+        writeCSV(record);
+    }
+    else
+    {
+        _out << (_started ? ",\n" : "[\n");
+        _started = true;
+        writeJSON(record);
+    }
+}
+
+void MetricsExportWriter::flush()
+{
+    _out.flush();
+}
+
+void MetricsExportWriter::finish()
+{
+    if (_format == CSV)
+    {
+        writeCSVHeader();
+    }
+    else
+    {
+        _out << (_started ? "\n]\n" : "[]\n");
+        _started = true;
+    }
+    flush();
+}
@@ -28,6 +28,18 @@ static llvm::cl::opt<std::string> argOutput("o",
     llvm::cl::value_desc("path"),
     llvm::cl::init("-"),
     llvm::cl::cat(OCLintOptionCategory));
+static llvm::cl::opt<std::string> argCompress("compress",
+    llvm::cl::desc("Compress the output written with -o, as gzip or zstd "
+        "(by default chosen by a .gz or .zst extension, none to disable)"),
+    llvm::cl::value_desc("format"),
+    llvm::cl::init(""),
+    llvm::cl::cat(OCLintOptionCategory));
+static llvm::cl::opt<std::string> argReportDirectory("report-directory",
+    llvm::cl::desc("Write the report as several pages into <directory>, "
+        "for report types that support it"),
+    llvm::cl::value_desc("directory"),
+    llvm::cl::init(""),
+    llvm::cl::cat(OCLintOptionCategory));
 
 /* --------------------
    oclint configuration
@@ -78,11 +90,49 @@ static llvm::cl::opt<int> argMaxP3("max-priority-3",
     llvm::cl::value_desc("threshold"),
     llvm::cl::init(20),
     llvm::cl::cat(OCLintOptionCategory));
+static llvm::cl::opt<unsigned> argTranslationUnitTimeout("tu-timeout",
+    llvm::cl::desc("Give up on a source after <seconds> of analysis, 0 for no limit"),
+    llvm::cl::value_desc("seconds"),
+    llvm::cl::init(0),
+    llvm::cl::cat(OCLintOptionCategory));
+static llvm::cl::opt<unsigned> argRuleTimeout("rule-timeout",
+    llvm::cl::desc("Stop a rule after <seconds> on one source, 0 for no limit"),
+    llvm::cl::value_desc("seconds"),
+    llvm::cl::init(0),
+    llvm::cl::cat(OCLintOptionCategory));
+static llvm::cl::opt<bool> argFailFast("fail-fast",
+    llvm::cl::desc("Stop analyzing once a priority threshold is exceeded, and report so far"),
+    llvm::cl::init(false),
+    llvm::cl::cat(OCLintOptionCategory));
 static llvm::cl::opt<bool> argGlobalAnalysis("enable-global-analysis",
-    llvm::cl::desc("Compile every source, and analyze across global contexts "
-        "(depends on number of source files, could results in high memory load)"),
+    llvm::cl::desc("Summarize every source one at a time, and analyze across the summaries"),
     llvm::cl::init(false),
     llvm::cl::cat(OCLintOptionCategory));
+static llvm::cl::opt<std::string> argGlobalIndex("global-index",
+    llvm::cl::desc("Keep global analysis summaries in <path>, and reuse them for unchanged sources"),
+    llvm::cl::value_desc("path"),
+    llvm::cl::init(""),
+    llvm::cl::cat(OCLintOptionCategory));
+static llvm::cl::opt<std::string> argBaseline("baseline",
+    llvm::cl::desc("Leave out the violations recorded in the baseline <path>"),
+    llvm::cl::value_desc("path"),
+    llvm::cl::init(""),
+    llvm::cl::cat(OCLintOptionCategory));
+static llvm::cl::opt<std::string> argWriteBaseline("write-baseline",
+    llvm::cl::desc("Record all violations of this run as the baseline <path>"),
+    llvm::cl::value_desc("path"),
+    llvm::cl::init(""),
+    llvm::cl::cat(OCLintOptionCategory));
+static llvm::cl::opt<std::string> argDiff("diff",
+    llvm::cl::desc("Only analyze the lines changed by the unified diff <path>"),
+    llvm::cl::value_desc("path"),
+    llvm::cl::init(""),
+    llvm::cl::cat(OCLintOptionCategory));
+static llvm::cl::opt<std::string> argCostHistory("cost-history",
+    llvm::cl::desc("Record how long each source takes to analyze in the history <path>"),
+    llvm::cl::value_desc("path"),
+    llvm::cl::init(""),
+    llvm::cl::cat(OCLintOptionCategory));
 static llvm::cl::opt<bool> argClangChecker("enable-clang-static-analyzer",
     llvm::cl::desc("Enable Clang Static Analyzer, and integrate results into OCLint report"),
     llvm::cl::init(false),
@@ -91,6 +141,19 @@ static llvm::cl::opt<bool> argDuplications("allow-duplicated-violations",
     llvm::cl::desc("Allow duplicated violations in the OCLint report"),
     llvm::cl::init(false),
     llvm::cl::cat(OCLintOptionCategory));
+static llvm::cl::opt<bool> argMetricsOnly("metrics-only",
+    llvm::cl::desc("Skip the rules and export the metrics of every function instead"),
+    llvm::cl::init(false),
+    llvm::cl::cat(OCLintOptionCategory));
+static llvm::cl::opt<std::string> argMetricsFormat("metrics-format",
+    llvm::cl::desc("Change the metrics export format (csv or json)"),
+    llvm::cl::value_desc("format"),
+    llvm::cl::init("csv"),
+    llvm::cl::cat(OCLintOptionCategory));
+static llvm::cl::opt<bool> argPrintStats("print-stats",
+    llvm::cl::desc("Print how often each rule was applied or skipped"),
+    llvm::cl::init(false),
+    llvm::cl::cat(OCLintOptionCategory));
 static llvm::cl::opt<bool> argNoAnalytics("no-analytics",
     llvm::cl::desc("Disable the anonymous analytics"),
     llvm::cl::init(false),
@@ -116,6 +179,7 @@ static std::unique_ptr<llvm::opt::OptTable> Options(clang::driver::createDriverO
    ------- */
 
 static oclint::RulesetFilter filter;
+static std::vector<std::string> ruleConfigurationPairs;
 static std::string absoluteWorkingPath("");
 static std::string executablePath("");
 
@@ -131,6 +195,7 @@ void updateArgIfSet(llvm::cl::opt<T> &argValue, const llvm::Optional<T> &configV
 static void consumeRuleConfiguration(std::string key, std::string value)
 {
   oclint::RuleConfiguration::addConfiguration(key, value);
+  ruleConfigurationPairs.push_back(key + "=" + value);
   oclint::Analytics::ruleConfiguration(key, value);
 }
 
@@ -287,6 +352,39 @@ std::string oclint::option::outputPath()
     return argOutput.at(0) == '/' ? argOutput : workingPath() + "/" + argOutput;
 }
 
+std::string oclint::option::compression()
+{
+    if (argCompress == "none" || !hasOutputPath())
+    {
+        return "";
+    }
+    if (!argCompress.empty())
+    {
+        return argCompress;
+    }
+    llvm::StringRef output(argOutput);
+    if (output.endswith(".gz"))
+    {
+        return "gzip";
+    }
+    if (output.endswith(".zst"))
+    {
+        return "zstd";
+    }
+    return "";
+}
+
+bool oclint::option::hasReportDirectory()
+{
+    return !argReportDirectory.empty();
+}
+
+std::string oclint::option::reportDirectory()
+{
+    return argReportDirectory.at(0) == '/' ?
+        argReportDirectory : workingPath() + "/" + argReportDirectory;
+}
+
 std::string oclint::option::reportType()
 {
     return argReportType;
@@ -297,6 +395,11 @@ const oclint::RulesetFilter &oclint::option::rulesetFilter()
     return filter;
 }
 
+std::vector<std::string> oclint::option::ruleConfigurations()
+{
+    return ruleConfigurationPairs;
+}
+
 int oclint::option::maxP1()
 {
     return argMaxP1;
@@ -317,11 +420,77 @@ bool oclint::option::showEnabledRules()
     return argListEnabledRules;
 }
 
+unsigned oclint::option::translationUnitTimeout()
+{
+    return argTranslationUnitTimeout;
+}
+
+unsigned oclint::option::ruleTimeout()
+{
+    return argRuleTimeout;
+}
+
+bool oclint::option::failFast()
+{
+    return argFailFast;
+}
+
 bool oclint::option::enableGlobalAnalysis()
 {
     return argGlobalAnalysis;
 }
 
+bool oclint::option::hasGlobalIndexPath()
+{
+    return !argGlobalIndex.empty();
+}
+
+std::string oclint::option::globalIndexPath()
+{
+    return argGlobalIndex.at(0) == '/' ? argGlobalIndex : workingPath() + "/" + argGlobalIndex;
+}
+
+bool oclint::option::hasBaselinePath()
+{
+    return !argBaseline.empty();
+}
+
+std::string oclint::option::baselinePath()
+{
+    return argBaseline.at(0) == '/' ? argBaseline : workingPath() + "/" + argBaseline;
+}
+
+bool oclint::option::hasWriteBaselinePath()
+{
+    return !argWriteBaseline.empty();
+}
+
+std::string oclint::option::writeBaselinePath()
+{
+    return argWriteBaseline.at(0) == '/' ?
+        argWriteBaseline : workingPath() + "/" + argWriteBaseline;
+}
+
+bool oclint::option::hasDiffPath()
+{
+    return !argDiff.empty();
+}
+
+std::string oclint::option::diffPath()
+{
+    return argDiff.at(0) == '/' ? argDiff : workingPath() + "/" + argDiff;
+}
+
+bool oclint::option::hasCostHistoryPath()
+{
+    return !argCostHistory.empty();
+}
+
+std::string oclint::option::costHistoryPath()
+{
+    return argCostHistory.at(0) == '/' ? argCostHistory : workingPath() + "/" + argCostHistory;
+}
+
 bool oclint::option::enableClangChecker()
 {
     return argClangChecker;
@@ -332,6 +501,21 @@ bool oclint::option::allowDuplicatedViolations()
     return argDuplications;
 }
 
+bool oclint::option::metricsOnly()
+{
+    return argMetricsOnly;
+}
+
+std::string oclint::option::metricsFormat()
+{
+    return argMetricsFormat;
+}
+
+bool oclint::option::printStats()
+{
+    return argPrintStats;
+}
+
 bool oclint::option::disableAnalytics()
 {
   return argNoAnalytics;
@@ -1,5 +1,6 @@
 #include "oclint/RulesetBasedAnalyzer.h"
 
+#include <string>
 #include <utility>
 
 #include <clang/AST/AST.h>
@@ -10,15 +11,70 @@
 #include "oclint/RuleBase.h"
 #include "oclint/RuleCarrier.h"
 #include "oclint/RuleSet.h"
+#include "oclint/Statistics.h"
+#include "oclint/TimeBudget.h"
+#include "oclint/Violation.h"
 #include "oclint/ViolationSet.h"
 
 using namespace oclint;
 
-RulesetBasedAnalyzer::RulesetBasedAnalyzer(std::vector<RuleBase*> filteredRules)
-    : _filteredRules(std::move(filteredRules))
+RulesetBasedAnalyzer::RulesetBasedAnalyzer(std::vector<RuleBase*> filteredRules,
+    bool globalAnalysis, const ChangedLines *changedLines)
+    : _filteredRules(std::move(filteredRules)), _prerequisites(_filteredRules),
+    _globalAnalysis(globalAnalysis), _changedLines(changedLines), _lastSummariesComplete(true)
 {
 }
 
+std::vector<RuleBase *> RulesetBasedAnalyzer::applicableRules(clang::ASTContext &context) const
+{
+    std::vector<unsigned> languageApplicable;
+    for (unsigned index = 0; index < _filteredRules.size(); index++)
+    {
+        if (_filteredRules[index]->isApplicable(context.getLangOpts()))
+        {
+            languageApplicable.push_back(index);
+        }
+        else
+        {
+            Statistics::ruleOutcome(_filteredRules[index], RULE_SKIPPED_FOR_LANGUAGE);
+        }
+    }
+
+    std::vector<bool> presence = _prerequisites.presence(context, languageApplicable);
+    std::vector<RuleBase *> rules;
+    for (unsigned index : languageApplicable)
+    {
+        if (_prerequisites.isSatisfied(index, presence))
+        {
+            rules.push_back(_filteredRules[index]);
+        }
+        else
+        {
+            Statistics::ruleOutcome(_filteredRules[index], RULE_SKIPPED_FOR_PREREQUISITES);
+        }
+    }
+    return rules;
+}
+
+void RulesetBasedAnalyzer::preprocess(std::vector<clang::ASTContext *> &)
+{
+    if (!_globalAnalysis)
+    {
+        return;
+    }
+    _incompleteRules.clear();
+    for (RuleBase *rule : _filteredRules)
+    {
+        rule->beginGlobalAnalysis();
+    }
+}
+
+void RulesetBasedAnalyzer::summaryMissing(RuleBase *rule)
+{
+    _lastSummariesComplete = false;
+    _incompleteRules.insert(rule);
+}
+
 void RulesetBasedAnalyzer::analyze(std::vector<clang::ASTContext *> &contexts)
 {
     for (const auto& context : contexts)
@@ -27,14 +83,128 @@ void RulesetBasedAnalyzer::analyze(std::vector<clang::ASTContext *> &contexts)
         
         LOG_VERBOSE("Analyzing ");
         auto violationSet = new ViolationSet();
-        auto carrier = new RuleCarrier(context, violationSet);
-        LOG_VERBOSE(carrier->getMainFilePath().c_str());
-        for (RuleBase *rule : _filteredRules)
+        RuleCarrier carrier(context, violationSet, _changedLines);
+        std::string mainFilePath = carrier.getMainFilePath();
+        LOG_VERBOSE(mainFilePath.c_str());
+        _lastSummaries.clear();
+        _lastSummariesComplete = true;
+        bool timedOut = false;
+        for (RuleBase *rule : applicableRules(*context))
         {
-            rule->takeoff(carrier);
+            if (timedOut)
+            {
+                Statistics::ruleOutcome(rule, RULE_TIMED_OUT);
+                summaryMissing(rule);
+                continue;
+            }
+            carrier.setDeadline(TimeBudget::ruleDeadline());
+            rule->takeoff(&carrier);
+            bool cancelled = carrier.isCancelled();
+            if (!cancelled)
+            {
+                Statistics::ruleOutcome(rule, RULE_APPLIED);
+            }
+            else if (TimeBudget::isTranslationUnitExpired())
+            {
+                Statistics::ruleOutcome(rule, RULE_TIMED_OUT);
+                timedOut = true;
+            }
+            else
+            {
+                Statistics::ruleOutcome(rule, RULE_TIMED_OUT);
+                ResultCollector::getInstance()->addWarning(Violation(nullptr, mainFilePath,
+                    0, 0, 0, 0, "rule " + rule->name() + " exceeded the time budget of " +
+                    std::to_string(TimeBudget::ruleBudget().count() / 1000) +
+                    " seconds, its violations are incomplete"));
+            }
+            if (_globalAnalysis)
+            {
+                // the summary of a cancelled rule is taken to reset the rule, then dropped
+                std::string summary = rule->summarizeTranslationUnit();
+                if (cancelled)
+                {
+                    summaryMissing(rule);
+                }
+                else if (!summary.empty())
+                {
+                    _lastSummaries[rule->identifier()] = summary;
+                    _summaries[rule].push_back(std::move(summary));
+                }
+            }
         }
+        Statistics::translationUnitAnalyzed();
         ResultCollector *results = ResultCollector::getInstance();
         results->add(violationSet);
-        LOG_VERBOSE_LINE(" - Done");
+        if (timedOut)
+        {
+            Statistics::translationUnitTimedOut(mainFilePath, "rules");
+            results->addWarning(Violation(nullptr, mainFilePath, 0, 0, 0, 0,
+                "analysis exceeded the time budget of " +
+                std::to_string(TimeBudget::translationUnitBudget().count() / 1000) +
+                " seconds, the remaining rules were skipped"));
+            LOG_VERBOSE_LINE(" - Timed out");
+        }
+        else
+        {
+            LOG_VERBOSE_LINE(" - Done");
+        }
+    }
+}
+
+void RulesetBasedAnalyzer::postprocess(std::vector<clang::ASTContext *> &)
+{
+    if (!_globalAnalysis)
+    {
+        return;
+    }
+    auto violationSet = new ViolationSet();
+    for (RuleBase *rule : _filteredRules)
+    {
+        if (!_incompleteRules.count(rule))
+        {
+            rule->endGlobalAnalysis(_summaries[rule], violationSet);
+        }
+        else if (!_summaries[rule].empty())
+        {
+            ResultCollector::getInstance()->addWarning(Violation(nullptr, "", 0, 0, 0, 0,
+                "rule " + rule->name() + " skipped the global analysis, " +
+                "the summaries of some sources are incomplete"));
+        }
+    }
+    _summaries.clear();
+    ResultCollector::getInstance()->add(violationSet);
+}
+
+TranslationUnitSummaries RulesetBasedAnalyzer::lastSummaries()
+{
+    return _lastSummaries;
+}
+
+bool RulesetBasedAnalyzer::lastSummariesComplete()
+{
+    return _lastSummariesComplete;
+}
+
+void RulesetBasedAnalyzer::reuseSummaries(const TranslationUnitSummaries &summaries)
+{
+    for (RuleBase *rule : _filteredRules)
+    {
+        auto summary = summaries.find(rule->identifier());
+        if (summary != summaries.end())
+        {
+            _summaries[rule].push_back(summary->second);
+        }
+    }
+}
+
+void RulesetBasedAnalyzer::summariesMissing()
+{
+    if (!_globalAnalysis)
+    {
+        return;
+    }
+    for (RuleBase *rule : _filteredRules)
+    {
+        summaryMissing(rule);
     }
 }
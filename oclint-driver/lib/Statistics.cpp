@@ -0,0 +1,106 @@
+#include "oclint/Statistics.h"
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "oclint/RuleBase.h"
+
+using namespace oclint;
+
+typedef std::array<int, NUMBER_OF_RULE_OUTCOMES> OutcomeCounters;
+
+static const char *outcomeDescriptions[NUMBER_OF_RULE_OUTCOMES] = {
+    "applied",
+    "skipped for language",
+    "skipped for missing prerequisites",
+    "timed out"
+};
+
+static int translationUnits = 0;
+static std::unordered_map<const RuleBase *, OutcomeCounters> ruleCounters;
+static std::vector<std::pair<std::string, std::string>> timedOutUnits;
+
+void Statistics::translationUnitAnalyzed()
+{
+    translationUnits++;
+}
+
+void Statistics::ruleOutcome(const RuleBase *rule, RuleOutcome outcome)
+{
+    auto countersIt = ruleCounters.find(rule);
+    if (countersIt == ruleCounters.end())
+    {
+        OutcomeCounters counters;
+        counters.fill(0);
+        countersIt = ruleCounters.emplace(rule, counters).first;
+    }
+    countersIt->second[outcome]++;
+}
+
+void Statistics::translationUnitTimedOut(const std::string &path, const std::string &stage)
+{
+    timedOutUnits.emplace_back(path, stage);
+}
+
+int Statistics::numberOfTranslationUnits()
+{
+    return translationUnits;
+}
+
+int Statistics::numberOfOutcomes(const RuleBase *rule, RuleOutcome outcome)
+{
+    auto countersIt = ruleCounters.find(rule);
+    return countersIt == ruleCounters.end() ? 0 : countersIt->second[outcome];
+}
+
+const std::vector<std::pair<std::string, std::string>> &Statistics::timedOutTranslationUnits()
+{
+    return timedOutUnits;
+}
+
+void Statistics::print(llvm::raw_ostream &out)
+{
+    std::vector<std::pair<std::string, const OutcomeCounters *>> rules;
+    for (const auto &ruleCounter : ruleCounters)
+    {
+        rules.emplace_back(ruleCounter.first->name(), &ruleCounter.second);
+    }
+    std::sort(rules.begin(), rules.end());
+
+    out << "Statistics:\n";
+    out << "Translation units: " << translationUnits << "\n";
+    for (const auto &rule : rules)
+    {
+        out << "- " << rule.first << ":";
+        const char *separator = " ";
+        for (int outcome = 0; outcome < NUMBER_OF_RULE_OUTCOMES; outcome++)
+        {
+            int count = (*rule.second)[outcome];
+            if (count > 0)
+            {
+                out << separator << outcomeDescriptions[outcome] << " " << count;
+                separator = ", ";
+            }
+        }
+        out << "\n";
+    }
+    if (!timedOutUnits.empty())
+    {
+        out << "Timed out translation units: " << timedOutUnits.size() << "\n";
+        for (const auto &timedOutUnit : timedOutUnits)
+        {
+            out << "- " << timedOutUnit.first << " (" << timedOutUnit.second << ")\n";
+        }
+    }
+}
+
+void Statistics::reset()
+{
+    translationUnits = 0;
+    ruleCounters.clear();
+    timedOutUnits.clear();
+}
@@ -0,0 +1,49 @@
+#include "oclint/TimeBudget.h"
+
+#include <algorithm>
+
+using namespace oclint;
+
+static std::chrono::milliseconds translationUnitMilliseconds(0);
+static std::chrono::milliseconds ruleMilliseconds(0);
+static TimeBudget::Clock::time_point translationUnitDeadline =
+    TimeBudget::Clock::time_point::max();
+
+void TimeBudget::configure(std::chrono::milliseconds translationUnitBudget,
+    std::chrono::milliseconds ruleBudget)
+{
+    translationUnitMilliseconds = translationUnitBudget;
+    ruleMilliseconds = ruleBudget;
+    translationUnitDeadline = Clock::time_point::max();
+}
+
+void TimeBudget::startTranslationUnit()
+{
+    translationUnitDeadline = translationUnitMilliseconds.count() > 0 ?
+        Clock::now() + translationUnitMilliseconds : Clock::time_point::max();
+}
+
+bool TimeBudget::isTranslationUnitExpired()
+{
+    return translationUnitDeadline != Clock::time_point::max() &&
+        Clock::now() >= translationUnitDeadline;
+}
+
+TimeBudget::Clock::time_point TimeBudget::ruleDeadline()
+{
+    if (ruleMilliseconds.count() == 0)
+    {
+        return translationUnitDeadline;
+    }
+    return std::min(translationUnitDeadline, Clock::now() + ruleMilliseconds);
+}
+
+std::chrono::milliseconds TimeBudget::translationUnitBudget()
+{
+    return translationUnitMilliseconds;
+}
+
+std::chrono::milliseconds TimeBudget::ruleBudget()
+{
+    return ruleMilliseconds;
+}
@@ -6,13 +6,20 @@
 #include <memory>
 
 #include <clang/Tooling/CommonOptionsParser.h>
+#include <llvm/Support/FileSystem.h>
 
 #include "oclint/Analytics.h"
 #include "oclint/Analyzer.h"
+#include "oclint/Baseline.h"
 #include "oclint/CompilerInstance.h"
+#include "oclint/CompressedOutputStream.h"
+#include "oclint/DiffScope.h"
 #include "oclint/Driver.h"
 #include "oclint/ExitCode.h"
 #include "oclint/GenericException.h"
+#include "oclint/Logger.h"
+#include "oclint/MetricsExportAnalyzer.h"
+#include "oclint/MetricsExportWriter.h"
 #include "oclint/Options.h"
 #include "oclint/RawResults.h"
 #include "oclint/Reporter.h"
@@ -21,6 +28,7 @@
 #include "oclint/RuleSet.h"
 #include "oclint/RulesetFilter.h"
 #include "oclint/RulesetBasedAnalyzer.h"
+#include "oclint/Statistics.h"
 #include "oclint/UniqueResults.h"
 #include "oclint/Version.h"
 #include "oclint/ViolationSet.h"
@@ -49,6 +57,26 @@ bool numberOfViolationsExceedThreshold(oclint::Results *results)
         results->numberOfViolationsWithPriority(3) > oclint::option::maxP3();
 }
 
+ostream* compressedOutStream(const string &output, const string &compression)
+{
+    oclint::CompressedOutputStream::Format format;
+    if (!oclint::CompressedOutputStream::formatOf(compression, format))
+    {
+        throw oclint::GenericException("unknown compression " + compression);
+    }
+    if (!oclint::CompressedOutputStream::isFormatAvailable(format))
+    {
+        throw oclint::GenericException(compression + " compression is not available");
+    }
+    auto out = new oclint::CompressedOutputStream(output, format);
+    if (!out->is_open())
+    {
+        delete out;
+        throw oclint::GenericException("cannot open report output file " + output);
+    }
+    return out;
+}
+
 ostream* outStream()
 {
     if (!oclint::option::hasOutputPath())
@@ -56,6 +84,11 @@ ostream* outStream()
         return &cout;
     }
     string output = oclint::option::outputPath();
+    string compression = oclint::option::compression();
+    if (!compression.empty())
+    {
+        return compressedOutStream(output, compression);
+    }
     auto out = new ofstream(output.c_str());
     if (!out->is_open())
     {
@@ -68,11 +101,32 @@ void disposeOutStream(ostream* out)
 {
     if (out && oclint::option::hasOutputPath())
     {
+        if (!oclint::option::compression().empty())
+        {
+            std::unique_ptr<oclint::CompressedOutputStream> compressed(
+                (oclint::CompressedOutputStream *)out);
+            compressed->close();
+            return;
+        }
         ofstream *fout = (ofstream *)out;
         fout->close();
     }
 }
 
+void reportToDirectory(oclint::Results *results)
+{
+    string directory = oclint::option::reportDirectory();
+    if (llvm::sys::fs::create_directories(directory))
+    {
+        throw oclint::GenericException("cannot create report directory " + directory);
+    }
+    if (!reporter()->reportToDirectory(results, directory))
+    {
+        throw oclint::GenericException("report type " + oclint::option::reportType() +
+            " cannot write a report directory");
+    }
+}
+
 void listRules()
 {
     cerr << "Enabled rules:\n";
@@ -112,6 +166,38 @@ std::unique_ptr<oclint::Results> getResults()
     return results;
 }
 
+std::unique_ptr<oclint::Results> applyBaseline(std::unique_ptr<oclint::Results> results)
+{
+    if (oclint::option::hasWriteBaselinePath())
+    {
+        oclint::Baseline baseline(oclint::option::workingPath());
+        for (const auto& violation : results->allViolations())
+        {
+            baseline.add(violation);
+        }
+        if (!baseline.save(oclint::option::writeBaselinePath()))
+        {
+            throw oclint::GenericException(
+                "cannot write baseline " + oclint::option::writeBaselinePath());
+        }
+    }
+    if (!oclint::option::hasBaselinePath())
+    {
+        return results;
+    }
+    oclint::Baseline baseline(oclint::option::workingPath());
+    if (!baseline.load(oclint::option::baselinePath()))
+    {
+        throw oclint::GenericException(
+            "cannot read baseline " + oclint::option::baselinePath());
+    }
+    std::unique_ptr<oclint::BaselineResults> filtered(
+        new oclint::BaselineResults(std::move(results), baseline));
+    LOG_VERBOSE_LINE("Left out " << filtered->numberOfBaselineViolations()
+        << " violations found in the baseline");
+    return std::move(filtered);
+}
+
 int prepare()
 {
     try
@@ -157,6 +243,50 @@ static void oclintVersionPrinter()
     outs() << "  Built " << __DATE__ << " (" << __TIME__ << ").\n";
 }
 
+static int exportMetrics(CommonOptionsParser &optionsParser)
+{
+    oclint::MetricsExportWriter::Format format;
+    if (!oclint::MetricsExportWriter::parseFormat(oclint::option::metricsFormat(), format))
+    {
+        printErrorLine(("unknown metrics format " + oclint::option::metricsFormat()).c_str());
+        return ERROR_WHILE_REPORTING;
+    }
+
+    ostream *out = nullptr;
+    try
+    {
+        out = outStream();
+    }
+    catch (const exception& e)
+    {
+        printErrorLine(e.what());
+        return ERROR_WHILE_REPORTING;
+    }
+
+    oclint::MetricsExportWriter writer(*out, format);
+    oclint::MetricsExportAnalyzer analyzer(writer);
+    oclint::Driver driver;
+    try
+    {
+        driver.run(optionsParser.getCompilations(), optionsParser.getSourcePathList(), analyzer);
+    }
+    catch (const exception& e)
+    {
+        printErrorLine(e.what());
+        disposeOutStream(out);
+        return ERROR_WHILE_PROCESSING;
+    }
+    writer.finish();
+    disposeOutStream(out);
+
+    if (oclint::option::printStats())
+    {
+        oclint::Statistics::print(errs());
+    }
+
+    return SUCCESS;
+}
+
 extern llvm::cl::OptionCategory OCLintOptionCategory;
 
 int main(int argc, const char **argv)
@@ -165,6 +295,23 @@ int main(int argc, const char **argv)
     CommonOptionsParser optionsParser(argc, argv, OCLintOptionCategory);
     oclint::option::process(argv[0]);
 
+    if (oclint::option::metricsOnly())
+    {
+        return sendAnalyticsAndExit(exportMetrics(optionsParser));
+    }
+
+    if (oclint::option::hasGlobalIndexPath() && !oclint::option::enableGlobalAnalysis())
+    {
+        printErrorLine("-global-index requires -enable-global-analysis");
+        return sendAnalyticsAndExit(ERROR_WHILE_PROCESSING);
+    }
+    // summaries of the unchanged code would be missing, so everything it uses looks unused
+    if (oclint::option::hasDiffPath() && oclint::option::enableGlobalAnalysis())
+    {
+        printErrorLine("-diff cannot be combined with -enable-global-analysis");
+        return sendAnalyticsAndExit(ERROR_WHILE_PROCESSING);
+    }
+
     int prepareStatus = prepare();
     if (prepareStatus)
     {
@@ -176,11 +323,25 @@ int main(int argc, const char **argv)
         listRules();
     }
 
-    oclint::RulesetBasedAnalyzer analyzer(oclint::option::rulesetFilter().filteredRules());
+    std::unique_ptr<oclint::DiffScope> diffScope;
+    if (oclint::option::hasDiffPath())
+    {
+        diffScope.reset(new oclint::DiffScope());
+        if (!diffScope->load(oclint::option::diffPath(), oclint::option::workingPath()))
+        {
+            printErrorLine(("cannot read diff " + oclint::option::diffPath()).c_str());
+            return sendAnalyticsAndExit(ERROR_WHILE_PROCESSING);
+        }
+    }
+
+    oclint::RulesetBasedAnalyzer analyzer(oclint::option::rulesetFilter().filteredRules(),
+        oclint::option::enableGlobalAnalysis(),
+        diffScope ? &diffScope->changedLines() : nullptr);
     oclint::Driver driver;
     try
     {
-        driver.run(optionsParser.getCompilations(), optionsParser.getSourcePathList(), analyzer);
+        driver.run(optionsParser.getCompilations(), optionsParser.getSourcePathList(), analyzer,
+            diffScope.get());
     }
     catch (const exception& e)
     {
@@ -188,13 +349,35 @@ int main(int argc, const char **argv)
         return sendAnalyticsAndExit(ERROR_WHILE_PROCESSING);
     }
 
+    if (oclint::option::printStats())
+    {
+        oclint::Statistics::print(errs());
+    }
+
     std::unique_ptr<oclint::Results> results(std::move(getResults()));
 
     try
     {
-        ostream *out = outStream();
-        reporter()->report(results.get(), *out);
-        disposeOutStream(out);
+        results = applyBaseline(std::move(results));
+    }
+    catch (const exception& e)
+    {
+        printErrorLine(e.what());
+        return sendAnalyticsAndExit(ERROR_WHILE_PROCESSING);
+    }
+
+    try
+    {
+        if (oclint::option::hasReportDirectory())
+        {
+            reportToDirectory(results.get());
+        }
+        else
+        {
+            ostream *out = outStream();
+            reporter()->report(results.get(), *out);
+            disposeOutStream(out);
+        }
     }
     catch (const exception& e)
     {
@@ -202,7 +385,8 @@ int main(int argc, const char **argv)
         return sendAnalyticsAndExit(ERROR_WHILE_REPORTING);
     }
 
-    if (numberOfViolationsExceedThreshold(results.get()))
+    // a run that stopped early exceeded the thresholds, whatever the partial results say
+    if (numberOfViolationsExceedThreshold(results.get()) || results->isTruncated())
     {
         printViolationsExceedThresholdError(results.get());
         return sendAnalyticsAndExit(VIOLATIONS_EXCEED_THRESHOLD);
@@ -0,0 +1,208 @@
+#include <fstream>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+
+#include "oclint/Baseline.h"
+#include "oclint/RuleBase.h"
+
+using namespace ::testing;
+using namespace oclint;
+
+static std::string temporaryDirectory()
+{
+    llvm::SmallString<128> path;
+    llvm::sys::fs::createUniqueDirectory("BaselineTest", path);
+    return path.str();
+}
+
+static void writeFile(const std::string &path, const std::string &content)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << content;
+}
+
+class BaselineTestRule : public RuleBase
+{
+private:
+    std::string _name;
+    int _priority;
+
+public:
+    BaselineTestRule(std::string name, int priority) : _name(name), _priority(priority)
+    {
+    }
+
+    virtual void apply() override
+    {
+    }
+
+    virtual const std::string name() const override
+    {
+        return _name;
+    }
+
+    virtual const std::string category() const override
+    {
+        return "test";
+    }
+
+    virtual int priority() const override
+    {
+        return _priority;
+    }
+};
+
+class BaselineTestResults : public Results
+{
+public:
+    std::vector<Violation> violations;
+    std::vector<Violation> none;
+
+    virtual std::vector<Violation> allViolations() const override { return violations; }
+    virtual int numberOfViolations() const override { return violations.size(); }
+    virtual int numberOfViolationsWithPriority(int) const override { return -1; }
+    virtual int numberOfFiles() const override { return 3; }
+    virtual int numberOfFilesWithViolations() const override { return -1; }
+    virtual int numberOfErrors() const override { return 0; }
+    virtual bool hasErrors() const override { return false; }
+    virtual const std::vector<Violation>& allErrors() const override { return none; }
+    virtual int numberOfWarnings() const override { return 0; }
+    virtual bool hasWarnings() const override { return false; }
+    virtual const std::vector<Violation>& allWarnings() const override { return none; }
+    virtual int numberOfCheckerBugs() const override { return 0; }
+    virtual bool hasCheckerBugs() const override { return false; }
+    virtual const std::vector<Violation>& allCheckerBugs() const override { return none; }
+};
+
+class BaselineTest : public ::testing::Test
+{
+protected:
+    BaselineTestRule emptyIf{"empty if statement", 2};
+    BaselineTestRule longLine{"long line", 3};
+    std::string directory;
+    std::string sourcePath;
+
+    virtual void SetUp() override
+    {
+        directory = temporaryDirectory();
+        sourcePath = directory + "/a.m";
+        writeFile(sourcePath, "void f() {\n    if (x) {}\n}\n");
+    }
+
+    virtual void TearDown() override
+    {
+        llvm::sys::fs::remove_directories(directory);
+    }
+};
+
+TEST_F(BaselineTest, FingerprintIgnoresLineNumbersAndWhitespace)
+{
+    Baseline baseline(directory);
+    uint64_t before = baseline.fingerprint(Violation(&emptyIf, sourcePath, 2, 5, 2, 14));
+
+    writeFile(sourcePath, "// moved\n\nvoid f() {\n  if (x)   {}\n}\n");
+    Baseline moved(directory);
+    EXPECT_THAT(moved.fingerprint(Violation(&emptyIf, sourcePath, 4, 3, 4, 13)), Eq(before));
+}
+
+TEST_F(BaselineTest, FingerprintDependsOnRuleAndSource)
+{
+    Baseline baseline(directory);
+    uint64_t fingerprint = baseline.fingerprint(Violation(&emptyIf, sourcePath, 2, 5, 2, 14));
+    EXPECT_THAT(baseline.fingerprint(Violation(&longLine, sourcePath, 2, 5, 2, 14)),
+        Ne(fingerprint));
+    EXPECT_THAT(baseline.fingerprint(Violation(&emptyIf, sourcePath, 1, 1, 1, 10)),
+        Ne(fingerprint));
+}
+
+TEST_F(BaselineTest, FingerprintUsesPathsRelativeToWorkingDirectory)
+{
+    std::string otherDirectory = temporaryDirectory();
+    writeFile(otherDirectory + "/a.m", "void f() {\n    if (x) {}\n}\n");
+    Baseline baseline(directory);
+    Baseline otherBaseline(otherDirectory);
+    Violation otherViolation(&emptyIf, otherDirectory + "/a.m", 2, 5, 2, 14);
+    EXPECT_THAT(otherBaseline.fingerprint(otherViolation),
+        Eq(baseline.fingerprint(Violation(&emptyIf, sourcePath, 2, 5, 2, 14))));
+    llvm::sys::fs::remove_directories(otherDirectory);
+}
+
+TEST_F(BaselineTest, FingerprintReadsEachFileOnce)
+{
+    writeFile(directory + "/b.m", "void g() {}\n");
+    Baseline baseline(directory);
+    Violation violation(&emptyIf, sourcePath, 2, 5, 2, 14);
+    uint64_t fingerprint = baseline.fingerprint(violation);
+    baseline.fingerprint(Violation(&longLine, directory + "/b.m", 1, 1, 1, 10));
+
+    writeFile(sourcePath, "void f() {\n    if (y) {}\n}\n");
+    EXPECT_THAT(baseline.fingerprint(violation), Eq(fingerprint));
+}
+
+TEST_F(BaselineTest, MatchConsumesOccurrences)
+{
+    Violation violation(&emptyIf, sourcePath, 2, 5, 2, 14);
+    Baseline baseline(directory);
+    baseline.add(violation);
+    EXPECT_THAT(baseline.numberOfFingerprints(), Eq(1));
+    EXPECT_TRUE(baseline.match(violation));
+    EXPECT_FALSE(baseline.match(violation));
+}
+
+TEST_F(BaselineTest, SaveAndLoad)
+{
+    Violation violation(&emptyIf, sourcePath, 2, 5, 2, 14);
+    Baseline baseline(directory);
+    baseline.add(violation);
+    baseline.add(violation);
+    baseline.add(Violation(&longLine, sourcePath, 1, 1, 1, 10));
+    std::string baselinePath = directory + "/baseline";
+    ASSERT_TRUE(baseline.save(baselinePath));
+
+    Baseline loaded(directory);
+    ASSERT_TRUE(loaded.load(baselinePath));
+    EXPECT_THAT(loaded.numberOfFingerprints(), Eq(3));
+    EXPECT_TRUE(loaded.match(violation));
+    EXPECT_TRUE(loaded.match(violation));
+    EXPECT_FALSE(loaded.match(violation));
+}
+
+TEST_F(BaselineTest, RejectMalformedFiles)
+{
+    std::string baselinePath = directory + "/baseline";
+    Baseline baseline(directory);
+    EXPECT_FALSE(baseline.load(baselinePath));
+    writeFile(baselinePath, "not a baseline\n");
+    EXPECT_FALSE(baseline.load(baselinePath));
+    writeFile(baselinePath, "oclint-baseline 1\nxyz\n");
+    EXPECT_FALSE(baseline.load(baselinePath));
+}
+
+TEST_F(BaselineTest, LeaveOutBaselineViolations)
+{
+    std::unique_ptr<BaselineTestResults> results(new BaselineTestResults());
+    results->violations.push_back(Violation(&emptyIf, sourcePath, 2, 5, 2, 14));
+    results->violations.push_back(Violation(&longLine, sourcePath, 1, 1, 1, 10));
+    results->violations.push_back(Violation(&longLine, directory + "/b.m", 1, 1, 1, 10));
+    Baseline baseline(directory);
+    baseline.add(results->violations[0]);
+
+    BaselineResults filtered(std::move(results), baseline);
+    EXPECT_THAT(filtered.numberOfBaselineViolations(), Eq(1));
+    EXPECT_THAT(filtered.numberOfViolations(), Eq(2));
+    EXPECT_THAT(filtered.allViolations()[0].rule, Eq(&longLine));
+    EXPECT_THAT(filtered.numberOfViolationsWithPriority(2), Eq(0));
+    EXPECT_THAT(filtered.numberOfViolationsWithPriority(3), Eq(2));
+    EXPECT_THAT(filtered.numberOfFilesWithViolations(), Eq(2));
+    EXPECT_THAT(filtered.numberOfFiles(), Eq(3));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
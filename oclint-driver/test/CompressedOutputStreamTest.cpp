@@ -0,0 +1,141 @@
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "oclint/CompressedOutputStream.h"
+
+using namespace ::testing;
+using namespace oclint;
+
+class CompressedOutputStreamTest : public ::testing::Test
+{
+protected:
+    std::string path;
+
+    virtual void SetUp() override
+    {
+        char pathTemplate[] = "/tmp/CompressedOutputStreamTest.XXXXXX";
+        int descriptor = mkstemp(pathTemplate);
+        ASSERT_THAT(descriptor, Ne(-1));
+        close(descriptor);
+        path = pathTemplate;
+    }
+
+    virtual void TearDown() override
+    {
+        remove(path.c_str());
+    }
+
+    /* larger than a few blocks, so several of them are in flight */
+    static std::string report()
+    {
+        std::string content;
+        for (int index = 0; index < 200000; index++)
+        {
+            content += "<violation line=\"" + std::to_string(index) + "\">message</violation>\n";
+        }
+        return content;
+    }
+
+    std::string gunzip()
+    {
+        std::string content;
+        gzFile file = gzopen(path.c_str(), "rb");
+        char buffer[65536];
+        int size;
+        while ((size = gzread(file, buffer, sizeof(buffer))) > 0)
+        {
+            content.append(buffer, size);
+        }
+        gzclose(file);
+        return content;
+    }
+};
+
+TEST_F(CompressedOutputStreamTest, FormatOfName)
+{
+    CompressedOutputStream::Format format;
+    EXPECT_TRUE(CompressedOutputStream::formatOf("gzip", format));
+    EXPECT_THAT(format, Eq(CompressedOutputStream::GZIP));
+    EXPECT_TRUE(CompressedOutputStream::formatOf("zstd", format));
+    EXPECT_THAT(format, Eq(CompressedOutputStream::ZSTD));
+    EXPECT_FALSE(CompressedOutputStream::formatOf("bzip2", format));
+    EXPECT_TRUE(CompressedOutputStream::isFormatAvailable(CompressedOutputStream::GZIP));
+}
+
+TEST_F(CompressedOutputStreamTest, WriteGzip)
+{
+    std::string content = report();
+    CompressedOutputStream out(path, CompressedOutputStream::GZIP);
+    ASSERT_TRUE(out.is_open());
+    out << content.substr(0, 1000);
+    out.flush();
+    out << content.substr(1000);
+    out.close();
+    EXPECT_THAT(gunzip(), Eq(content));
+}
+
+TEST_F(CompressedOutputStreamTest, WriteEmptyGzip)
+{
+    CompressedOutputStream out(path, CompressedOutputStream::GZIP);
+    out.close();
+    EXPECT_THAT(gunzip(), StrEq(""));
+}
+
+TEST_F(CompressedOutputStreamTest, CannotOpenFile)
+{
+    CompressedOutputStream out("/nonexistent/directory/report.gz", CompressedOutputStream::GZIP);
+    EXPECT_FALSE(out.is_open());
+}
+
+#ifdef HAVE_ZSTD
+
+TEST_F(CompressedOutputStreamTest, WriteZstd)
+{
+    std::string content = report();
+    {
+        CompressedOutputStream out(path, CompressedOutputStream::ZSTD);
+        out << content;
+        out.close();
+    }
+
+    FILE *file = fopen(path.c_str(), "rb");
+    ASSERT_THAT(file, NotNull());
+    ZSTD_DStream *stream = ZSTD_createDStream();
+    ZSTD_initDStream(stream);
+    std::string decompressed;
+    std::vector<char> input(ZSTD_DStreamInSize());
+    std::vector<char> output(ZSTD_DStreamOutSize());
+    size_t size;
+    while ((size = fread(input.data(), 1, input.size(), file)) > 0)
+    {
+        ZSTD_inBuffer in = { input.data(), size, 0 };
+        while (in.pos < in.size)
+        {
+            ZSTD_outBuffer out = { output.data(), output.size(), 0 };
+            ASSERT_FALSE(ZSTD_isError(ZSTD_decompressStream(stream, &out, &in)));
+            decompressed.append(output.data(), out.pos);
+        }
+    }
+    ZSTD_freeDStream(stream);
+    fclose(file);
+    EXPECT_THAT(decompressed, Eq(content));
+}
+
+#endif
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
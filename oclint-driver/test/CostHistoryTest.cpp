@@ -0,0 +1,90 @@
+#include <fstream>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+
+#include "oclint/CostHistory.h"
+
+using namespace ::testing;
+using namespace oclint;
+
+static void writeFile(const std::string &path, const std::string &content)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << content;
+}
+
+class CostHistoryTest : public ::testing::Test
+{
+protected:
+    std::string directory;
+
+    virtual void SetUp() override
+    {
+        llvm::SmallString<128> path;
+        llvm::sys::fs::createUniqueDirectory("CostHistoryTest", path);
+        directory = path.str();
+        writeFile(directory + "/small.m", std::string(100, 'x'));
+        writeFile(directory + "/large.m", std::string(1000, 'x'));
+    }
+
+    virtual void TearDown() override
+    {
+        llvm::sys::fs::remove_directories(directory);
+    }
+};
+
+TEST_F(CostHistoryTest, EstimateFromSizeWithoutHistory)
+{
+    CostHistory history;
+    EXPECT_THAT(history.estimate(directory + "/large.m"),
+        Gt(history.estimate(directory + "/small.m")));
+    EXPECT_THAT(history.estimate(directory + "/missing.m"), Eq(0u));
+}
+
+TEST_F(CostHistoryTest, PreferRecordedTimes)
+{
+    CostHistory history;
+    history.record(directory + "/small.m", std::chrono::milliseconds(500));
+    EXPECT_THAT(history.estimate(directory + "/small.m"), Eq(500u));
+    // 5 milliseconds per byte, learned from small.m
+    EXPECT_THAT(history.estimate(directory + "/large.m"), Eq(5000u));
+
+    history.record(directory + "/large.m", std::chrono::milliseconds(20));
+    EXPECT_THAT(history.estimate(directory + "/large.m"), Eq(20u));
+}
+
+TEST_F(CostHistoryTest, SaveAndLoad)
+{
+    CostHistory history;
+    history.record(directory + "/small.m", std::chrono::milliseconds(42));
+    history.record(directory + "/with space.m", std::chrono::milliseconds(7));
+    std::string historyPath = directory + "/history";
+    ASSERT_TRUE(history.save(historyPath));
+
+    CostHistory loaded;
+    ASSERT_TRUE(loaded.load(historyPath));
+    EXPECT_THAT(loaded.numberOfEntries(), Eq(2));
+    EXPECT_THAT(loaded.estimate(directory + "/small.m"), Eq(42u));
+    EXPECT_THAT(loaded.estimate(directory + "/with space.m"), Eq(7u));
+}
+
+TEST_F(CostHistoryTest, RejectMalformedFiles)
+{
+    std::string historyPath = directory + "/history";
+    CostHistory history;
+    EXPECT_FALSE(history.load(historyPath));
+    writeFile(historyPath, "not a history\n");
+    EXPECT_FALSE(history.load(historyPath));
+    writeFile(historyPath, "oclint-cost-history 1\n12 abc /a.m\n");
+    EXPECT_FALSE(history.load(historyPath));
+    EXPECT_THAT(history.numberOfEntries(), Eq(0));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
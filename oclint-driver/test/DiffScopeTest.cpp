@@ -0,0 +1,144 @@
+#include <fstream>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <clang/Tooling/CompilationDatabase.h>
+
+#include "oclint/DiffScope.h"
+
+using namespace ::testing;
+using namespace oclint;
+
+static std::string temporaryDirectory()
+{
+    llvm::SmallString<128> path;
+    llvm::sys::fs::createUniqueDirectory("DiffScopeTest", path);
+    return path.str();
+}
+
+static void writeFile(const std::string &path, const std::string &content)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << content;
+}
+
+static const char gitDiff[] =
+    "diff --git a/src/a.m b/src/a.m\n"
+    "index 1111111..2222222 100644\n"
+    "--- a/src/a.m\n"
+    "+++ b/src/a.m\n"
+    "@@ -3,4 +3,5 @@ void f()\n"
+    " context\n"
+    "-removed\n"
+    "+added\n"
+    "+added\n"
+    " context\n"
+    "\n"
+    "@@ -20 +21,0 @@\n"
+    "--- removed line that looks like a header\n"
+    "\\ No newline at end of file\n"
+    "diff --git a/gone.m b/gone.m\n"
+    "--- a/gone.m\n"
+    "+++ /dev/null\n"
+    "@@ -1 +0,0 @@\n"
+    "-gone\n";
+
+TEST(DiffScopeTest, ParseAddedLines)
+{
+    DiffScope scope;
+    ASSERT_TRUE(scope.parse(gitDiff, "/base"));
+    const ChangedLines &changedLines = scope.changedLines();
+    EXPECT_THAT(changedLines.paths(), ElementsAre("/base/src/a.m"));
+    EXPECT_FALSE(changedLines.intersects("/base/src/a.m", 1, 2));
+    EXPECT_TRUE(changedLines.intersects("/base/src/a.m", 4, 4));
+    EXPECT_TRUE(changedLines.intersects("/base/src/a.m", 5, 5));
+    EXPECT_FALSE(changedLines.intersects("/base/src/a.m", 6, 19));
+}
+
+TEST(DiffScopeTest, MarkRemovedLinesAroundTheirPlace)
+{
+    DiffScope scope;
+    ASSERT_TRUE(scope.parse(gitDiff, "/base"));
+    EXPECT_TRUE(scope.changedLines().intersects("/base/src/a.m", 20, 20));
+    EXPECT_TRUE(scope.changedLines().intersects("/base/src/a.m", 21, 21));
+    EXPECT_FALSE(scope.changedLines().intersects("/base/src/a.m", 22, 30));
+}
+
+TEST(DiffScopeTest, ParseUnifiedDiffWithoutPrefixes)
+{
+    DiffScope scope;
+    ASSERT_TRUE(scope.parse(
+        "--- a.h\t2018-01-01 00:00:00\n"
+        "+++ /abs/a.h\t2018-01-02 00:00:00\n"
+        "@@ -1,0 +2 @@\n"
+        "+added\n", "/base"));
+    EXPECT_TRUE(scope.changedLines().intersects("/abs/a.h", 2, 2));
+}
+
+TEST(DiffScopeTest, RejectMalformedHunks)
+{
+    DiffScope scope;
+    EXPECT_FALSE(scope.parse("+++ b/a.m\n@@ -x +1 @@\n", "/base"));
+    EXPECT_FALSE(scope.parse("+++ b/a.m\n@@ -1 +1 @@\n?\n", "/base"));
+    EXPECT_FALSE(scope.load("/nonexistent/diff", "/base"));
+}
+
+class DiffScopeIncludeTest : public ::testing::Test
+{
+protected:
+    std::string directory;
+    clang::tooling::CompileCommand compileCommand;
+
+    virtual void SetUp() override
+    {
+        directory = temporaryDirectory();
+        llvm::sys::fs::create_directories(directory + "/include");
+        writeFile(directory + "/a.m", "#import \"b.h\"\nint a;\n");
+        writeFile(directory + "/b.h", "  #  include <c.h>\n");
+        writeFile(directory + "/include/c.h", "int c;\n");
+        writeFile(directory + "/d.m", "#include <stdio.h>\n");
+        compileCommand.Directory = directory;
+        compileCommand.CommandLine = { "clang", "-I", "include", "-c", "a.m" };
+    }
+
+    virtual void TearDown() override
+    {
+        llvm::sys::fs::remove_directories(directory);
+    }
+
+    DiffScope scopeOf(const std::string &changedPath)
+    {
+        DiffScope scope;
+        scope.parse("+++ b/" + changedPath + "\n@@ -1 +1 @@\n-old\n+new\n", directory);
+        return scope;
+    }
+};
+
+TEST_F(DiffScopeIncludeTest, ChangedSource)
+{
+    DiffScope scope = scopeOf("a.m");
+    EXPECT_TRUE(scope.isInScope(directory + "/a.m", compileCommand));
+    EXPECT_FALSE(scope.isInScope(directory + "/d.m", compileCommand));
+}
+
+TEST_F(DiffScopeIncludeTest, ChangedHeaders)
+{
+    DiffScope direct = scopeOf("b.h");
+    EXPECT_TRUE(direct.isInScope(directory + "/a.m", compileCommand));
+    EXPECT_FALSE(direct.isInScope(directory + "/d.m", compileCommand));
+
+    DiffScope transitive = scopeOf("include/c.h");
+    EXPECT_TRUE(transitive.isInScope(directory + "/a.m", compileCommand));
+
+    compileCommand.CommandLine = { "clang", "-c", "a.m" };
+    DiffScope unresolved = scopeOf("include/c.h");
+    EXPECT_FALSE(unresolved.isInScope(directory + "/a.m", compileCommand));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,191 @@
+#include <fstream>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+
+#include "oclint/GlobalSummaryIndex.h"
+#include "oclint/RuleBase.h"
+
+using namespace ::testing;
+using namespace oclint;
+
+static std::string temporaryPath(const std::string &suffix)
+{
+    llvm::SmallString<128> path;
+    llvm::sys::fs::createTemporaryFile("GlobalSummaryIndexTest", suffix, path);
+    return path.str();
+}
+
+static void writeFile(const std::string &path, const std::string &content)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << content;
+}
+
+class GlobalSummaryIndexTestRule : public RuleBase
+{
+public:
+    virtual void apply() override
+    {
+    }
+
+    virtual const std::string name() const override
+    {
+        return "method usage";
+    }
+
+    virtual const std::string category() const override
+    {
+        return "test";
+    }
+
+    virtual int priority() const override
+    {
+        return 2;
+    }
+};
+
+class GlobalSummaryIndexTest : public ::testing::Test
+{
+protected:
+    std::string indexPath;
+    std::string sourcePath;
+    TranslationUnitSummaries summaries;
+    GlobalSummaryIndexTestRule rule;
+    std::vector<RuleBase *> rules { &rule };
+    TranslationUnitResults results;
+
+    virtual void SetUp() override
+    {
+        indexPath = temporaryPath("index");
+        sourcePath = temporaryPath("m");
+        writeFile(sourcePath, "@implementation A\n@end\n");
+        summaries["method usage"] = std::string("line\nwith\0zero", 14);
+
+        results.violations.push_back(Violation(&rule, "a.m", 1, 2, 3, 4, "unused"));
+        results.errors.push_back(Violation(nullptr, "a.m", 5, 6, 0, 0, "error"));
+        results.warnings.push_back(Violation(nullptr, "b.h", 7, 8, 0, 0, "warning"));
+
+        GlobalSummaryIndex index("scope", rules);
+        index.update("a.m", { sourcePath }, summaries, results);
+        ASSERT_TRUE(index.save(indexPath));
+    }
+
+    virtual void TearDown() override
+    {
+        llvm::sys::fs::remove(indexPath);
+        llvm::sys::fs::remove(sourcePath);
+    }
+};
+
+TEST_F(GlobalSummaryIndexTest, ReuseUnchangedTranslationUnit)
+{
+    GlobalSummaryIndex index("scope", rules);
+    EXPECT_TRUE(index.load(indexPath));
+    TranslationUnitSummaries reused;
+    TranslationUnitResults reusedResults;
+    EXPECT_TRUE(index.lookup("a.m", reused, reusedResults));
+    EXPECT_THAT(reused, Eq(summaries));
+    EXPECT_THAT(reusedResults.violations, ElementsAreArray(results.violations));
+    EXPECT_THAT(reusedResults.violations[0].rule, Eq(&rule));
+    EXPECT_THAT(reusedResults.errors, ElementsAreArray(results.errors));
+    EXPECT_THAT(reusedResults.warnings, ElementsAreArray(results.warnings));
+    EXPECT_FALSE(index.lookup("b.m", reused, reusedResults));
+}
+
+TEST_F(GlobalSummaryIndexTest, ViolationOfUnknownRuleIsStale)
+{
+    GlobalSummaryIndex index("scope");
+    EXPECT_TRUE(index.load(indexPath));
+    TranslationUnitSummaries reused;
+    TranslationUnitResults reusedResults;
+    EXPECT_FALSE(index.lookup("a.m", reused, reusedResults));
+}
+
+TEST_F(GlobalSummaryIndexTest, ChangedDependencyIsStale)
+{
+    writeFile(sourcePath, "@implementation B\n@end\n");
+    GlobalSummaryIndex index("scope", rules);
+    EXPECT_TRUE(index.load(indexPath));
+    TranslationUnitSummaries reused;
+    TranslationUnitResults reusedResults;
+    EXPECT_FALSE(index.lookup("a.m", reused, reusedResults));
+}
+
+TEST_F(GlobalSummaryIndexTest, OtherScopeIsDiscarded)
+{
+    GlobalSummaryIndex index("other scope");
+    EXPECT_FALSE(index.load(indexPath));
+    EXPECT_THAT(index.numberOfEntries(), Eq(0));
+}
+
+TEST_F(GlobalSummaryIndexTest, KeepOnlyTranslationUnitsOfLastRun)
+{
+    GlobalSummaryIndex firstRun("scope");
+    EXPECT_TRUE(firstRun.load(indexPath));
+    firstRun.update("b.m", { sourcePath }, TranslationUnitSummaries(), TranslationUnitResults());
+    EXPECT_TRUE(firstRun.save(indexPath));
+
+    GlobalSummaryIndex secondRun("scope");
+    EXPECT_TRUE(secondRun.load(indexPath));
+    EXPECT_THAT(secondRun.numberOfEntries(), Eq(1));
+    TranslationUnitSummaries reused;
+    TranslationUnitResults reusedResults;
+    EXPECT_TRUE(secondRun.lookup("b.m", reused, reusedResults));
+    EXPECT_THAT(reused.size(), Eq(0u));
+    EXPECT_TRUE(reusedResults.violations.empty());
+}
+
+TEST_F(GlobalSummaryIndexTest, KeepUnvisitedEntriesWhenAsked)
+{
+    GlobalSummaryIndex firstRun("scope", rules);
+    EXPECT_TRUE(firstRun.load(indexPath));
+    firstRun.update("b.m", { sourcePath }, TranslationUnitSummaries(), TranslationUnitResults());
+    firstRun.keepUnvisitedEntries();
+    EXPECT_TRUE(firstRun.save(indexPath));
+
+    GlobalSummaryIndex secondRun("scope", rules);
+    EXPECT_TRUE(secondRun.load(indexPath));
+    EXPECT_THAT(secondRun.numberOfEntries(), Eq(2));
+    TranslationUnitSummaries reused;
+    TranslationUnitResults reusedResults;
+    EXPECT_TRUE(secondRun.lookup("a.m", reused, reusedResults));
+    EXPECT_THAT(reused, Eq(summaries));
+}
+
+TEST_F(GlobalSummaryIndexTest, InvalidatedEntryIsDropped)
+{
+    GlobalSummaryIndex index("scope", rules);
+    EXPECT_TRUE(index.load(indexPath));
+    index.invalidate("a.m");
+    index.keepUnvisitedEntries();
+    TranslationUnitSummaries reused;
+    TranslationUnitResults reusedResults;
+    EXPECT_FALSE(index.lookup("a.m", reused, reusedResults));
+    EXPECT_THAT(index.numberOfEntries(), Eq(0));
+}
+
+TEST_F(GlobalSummaryIndexTest, TruncatedIndexIsIgnored)
+{
+    std::ifstream in(indexPath, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    writeFile(indexPath, content.substr(0, content.size() - 1));
+
+    GlobalSummaryIndex index("scope");
+    EXPECT_FALSE(index.load(indexPath));
+    EXPECT_THAT(index.numberOfEntries(), Eq(0));
+}
+
+TEST(GlobalSummaryIndexDigestTest, DigestIsStable)
+{
+    EXPECT_THAT(GlobalSummaryIndex::digest(""), StrEq("d41d8cd98f00b204e9800998ecf8427e"));
+    EXPECT_THAT(GlobalSummaryIndex::digest("a"), Ne(GlobalSummaryIndex::digest("b")));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,89 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <clang/Frontend/ASTUnit.h>
+#include <clang/Tooling/Tooling.h>
+
+#include "oclint/LexicalPrerequisites.h"
+#include "oclint/RuleBase.h"
+
+using namespace ::testing;
+using namespace oclint;
+
+class TestRule : public RuleBase
+{
+private:
+    std::vector<std::string> _prerequisites;
+public:
+    explicit TestRule(std::vector<std::string> prerequisites) : _prerequisites(prerequisites) {}
+    void apply() {}
+    const std::string name() const
+    { return "test rule"; }
+    const std::string category() const
+    { return "test"; }
+    int priority() const
+    { return 0; }
+    const std::vector<std::string> lexicalPrerequisites() const
+    { return _prerequisites; }
+};
+
+static bool satisfied(const std::string &code, const std::vector<std::string> &prerequisites)
+{
+    TestRule rule(prerequisites);
+    std::vector<RuleBase *> rules = {&rule};
+    LexicalPrerequisites lexicalPrerequisites(rules);
+    std::unique_ptr<clang::ASTUnit> ast = clang::tooling::buildASTFromCode(code);
+    std::vector<bool> presence = lexicalPrerequisites.presence(ast->getASTContext(), {0});
+    return lexicalPrerequisites.isSatisfied(0, presence);
+}
+
+TEST(LexicalPrerequisitesTest, NoPrerequisite)
+{
+    EXPECT_TRUE(satisfied("void a() {}", {}));
+}
+
+TEST(LexicalPrerequisitesTest, Identifier)
+{
+    EXPECT_TRUE(satisfied("void foo() {}", {"foo"}));
+    EXPECT_FALSE(satisfied("void bar() {}", {"foo"}));
+    EXPECT_FALSE(satisfied("void bar() {} // foo", {"foo"}));
+}
+
+TEST(LexicalPrerequisitesTest, Keyword)
+{
+    EXPECT_TRUE(satisfied("void a() { goto b; b: ; }", {"goto"}));
+    EXPECT_FALSE(satisfied("void a() { int gotoCount; }", {"goto"}));
+}
+
+TEST(LexicalPrerequisitesTest, String)
+{
+    EXPECT_TRUE(satisfied("void a() __attribute__((annotate(\"oclint:enforce[x]\")));",
+        {"oclint:enforce"}));
+    EXPECT_FALSE(satisfied("void a() __attribute__((annotate(\"oclint:suppress\")));",
+        {"oclint:enforce"}));
+}
+
+TEST(LexicalPrerequisitesTest, AllPrerequisitesAreRequired)
+{
+    EXPECT_FALSE(satisfied("void foo() {}", {"foo", "bar"}));
+    EXPECT_TRUE(satisfied("void foo() { int bar; }", {"foo", "bar"}));
+}
+
+TEST(LexicalPrerequisitesTest, OnlyRequestedRulesAreLookedUp)
+{
+    TestRule rule({"foo"});
+    std::vector<RuleBase *> rules = {&rule};
+    LexicalPrerequisites lexicalPrerequisites(rules);
+    std::unique_ptr<clang::ASTUnit> ast = clang::tooling::buildASTFromCode("void a() {}");
+    EXPECT_TRUE(lexicalPrerequisites.isSatisfied(0,
+        lexicalPrerequisites.presence(ast->getASTContext(), {})));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
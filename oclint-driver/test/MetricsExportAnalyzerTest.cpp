@@ -0,0 +1,54 @@
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <clang/Frontend/ASTUnit.h>
+#include <clang/Tooling/Tooling.h>
+
+#include "oclint/MetricsExportAnalyzer.h"
+#include "oclint/MetricsExportWriter.h"
+
+using namespace ::testing;
+using namespace oclint;
+
+static std::string exportMetrics(const std::string &code)
+{
+    std::unique_ptr<clang::ASTUnit> ast = clang::tooling::buildASTFromCode(code, "input.cpp");
+    std::vector<clang::ASTContext *> contexts = {&ast->getASTContext()};
+    std::ostringstream out;
+    MetricsExportWriter writer(out, MetricsExportWriter::CSV);
+    MetricsExportAnalyzer analyzer(writer);
+    analyzer.analyze(contexts);
+    writer.finish();
+    return out.str();
+}
+
+TEST(MetricsExportAnalyzerTest, ExportFunctionDefinitionsOnly)
+{
+    EXPECT_THAT(exportMetrics("void f();\n"
+        "namespace n {\n"
+        "int g(int a)\n"
+        "{\n"
+        "    if (a) { return 1; }\n"
+        "    return 0;\n"
+        "}\n"
+        "}\n"),
+        StrEq("path,line,column,function,ccn,npath,ncss,depth,lines\n"
+        "input.cpp,3,1,n::g,2,2,4,2,4\n"));
+}
+
+TEST(MetricsExportAnalyzerTest, ExportMethodsOfClasses)
+{
+    EXPECT_THAT(exportMetrics("struct S { void m() {} };"),
+        StrEq("path,line,column,function,ccn,npath,ncss,depth,lines\n"
+        "input.cpp,1,12,S::m,1,1,1,1,1\n"));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,82 @@
+#include <sstream>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "oclint/MetricsExportWriter.h"
+
+using namespace ::testing;
+using namespace oclint;
+
+static FunctionMetricsRecord record(const std::string &path, const std::string &name)
+{
+    FunctionMetricsRecord result;
+    result.path = path;
+    result.line = 3;
+    result.column = 1;
+    result.name = name;
+    result.metrics.cyclomaticComplexity = 2;
+    result.metrics.nPathComplexity = 4;
+    result.metrics.ncss = 5;
+    result.metrics.stmtDepth = 1;
+    result.metrics.lineCount = 7;
+    return result;
+}
+
+TEST(MetricsExportWriterTest, ParseFormat)
+{
+    MetricsExportWriter::Format format;
+    EXPECT_TRUE(MetricsExportWriter::parseFormat("csv", format));
+    EXPECT_THAT(format, Eq(MetricsExportWriter::CSV));
+    EXPECT_TRUE(MetricsExportWriter::parseFormat("json", format));
+    EXPECT_THAT(format, Eq(MetricsExportWriter::JSON));
+    EXPECT_FALSE(MetricsExportWriter::parseFormat("xml", format));
+}
+
+TEST(MetricsExportWriterTest, CSVWithoutRecords)
+{
+    std::ostringstream out;
+    MetricsExportWriter writer(out, MetricsExportWriter::CSV);
+    writer.finish();
+    EXPECT_THAT(out.str(), StrEq("path,line,column,function,ccn,npath,ncss,depth,lines\n"));
+}
+
+TEST(MetricsExportWriterTest, CSVQuotesFieldsWhenNeeded)
+{
+    std::ostringstream out;
+    MetricsExportWriter writer(out, MetricsExportWriter::CSV);
+    writer.write(record("/a.cpp", "f"));
+    writer.write(record("/b,\"c\".cpp", "g"));
+    writer.finish();
+    EXPECT_THAT(out.str(), StrEq("path,line,column,function,ccn,npath,ncss,depth,lines\n"
+        "/a.cpp,3,1,f,2,4,5,1,7\n"
+        "\"/b,\"\"c\"\".cpp\",3,1,g,2,4,5,1,7\n"));
+}
+
+TEST(MetricsExportWriterTest, JSONWithoutRecords)
+{
+    std::ostringstream out;
+    MetricsExportWriter writer(out, MetricsExportWriter::JSON);
+    writer.finish();
+    EXPECT_THAT(out.str(), StrEq("[]\n"));
+}
+
+TEST(MetricsExportWriterTest, JSONEscapesStrings)
+{
+    std::ostringstream out;
+    MetricsExportWriter writer(out, MetricsExportWriter::JSON);
+    writer.write(record("/a.cpp", "f"));
+    writer.write(record("/b\\\"c\".m", "-[A b:]"));
+    writer.finish();
+    EXPECT_THAT(out.str(), StrEq("[\n"
+        "{\"path\":\"/a.cpp\",\"line\":3,\"column\":1,\"function\":\"f\","
+        "\"ccn\":2,\"npath\":4,\"ncss\":5,\"depth\":1,\"lines\":7},\n"
+        "{\"path\":\"/b\\\\\\\"c\\\".m\",\"line\":3,\"column\":1,\"function\":\"-[A b:]\","
+        "\"ccn\":2,\"npath\":4,\"ncss\":5,\"depth\":1,\"lines\":7}\n"
+        "]\n"));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
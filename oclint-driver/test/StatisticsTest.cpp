@@ -0,0 +1,87 @@
+#include <string>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "oclint/RuleBase.h"
+#include "oclint/Statistics.h"
+
+using namespace ::testing;
+using namespace oclint;
+
+class TestRule : public RuleBase
+{
+private:
+    std::string ruleName;
+public:
+    explicit TestRule(std::string ruleName) : ruleName(ruleName) {}
+    void apply() {}
+    const std::string name() const
+    { return ruleName; }
+    const std::string category() const
+    { return "test"; }
+    int priority() const
+    { return 0; }
+};
+
+TEST(StatisticsTest, CountOutcomes)
+{
+    Statistics::reset();
+    TestRule rule("test rule");
+    Statistics::translationUnitAnalyzed();
+    Statistics::ruleOutcome(&rule, RULE_APPLIED);
+    Statistics::ruleOutcome(&rule, RULE_APPLIED);
+    Statistics::ruleOutcome(&rule, RULE_SKIPPED_FOR_LANGUAGE);
+    EXPECT_THAT(Statistics::numberOfTranslationUnits(), Eq(1));
+    EXPECT_THAT(Statistics::numberOfOutcomes(&rule, RULE_APPLIED), Eq(2));
+    EXPECT_THAT(Statistics::numberOfOutcomes(&rule, RULE_SKIPPED_FOR_LANGUAGE), Eq(1));
+}
+
+TEST(StatisticsTest, PrintOnlyRecordedOutcomesSortedByRuleName)
+{
+    Statistics::reset();
+    TestRule ruleB("b rule");
+    TestRule ruleA("a rule");
+    Statistics::translationUnitAnalyzed();
+    Statistics::translationUnitAnalyzed();
+    Statistics::ruleOutcome(&ruleB, RULE_APPLIED);
+    Statistics::ruleOutcome(&ruleA, RULE_SKIPPED_FOR_LANGUAGE);
+    Statistics::ruleOutcome(&ruleA, RULE_APPLIED);
+
+    std::string output;
+    llvm::raw_string_ostream out(output);
+    Statistics::print(out);
+    EXPECT_THAT(out.str(), StrEq("Statistics:\n"
+        "Translation units: 2\n"
+        "- a rule: applied 1, skipped for language 1\n"
+        "- b rule: applied 1\n"));
+}
+
+TEST(StatisticsTest, ListTimedOutTranslationUnits)
+{
+    Statistics::reset();
+    TestRule rule("test rule");
+    Statistics::translationUnitAnalyzed();
+    Statistics::ruleOutcome(&rule, RULE_TIMED_OUT);
+    Statistics::translationUnitTimedOut("/a.m", "rules");
+    Statistics::translationUnitTimedOut("/b.m", "frontend");
+    EXPECT_THAT(Statistics::timedOutTranslationUnits().size(), Eq(2u));
+
+    std::string output;
+    llvm::raw_string_ostream out(output);
+    Statistics::print(out);
+    EXPECT_THAT(out.str(), StrEq("Statistics:\n"
+        "Translation units: 1\n"
+        "- test rule: timed out 1\n"
+        "Timed out translation units: 2\n"
+        "- /a.m (rules)\n"
+        "- /b.m (frontend)\n"));
+
+    Statistics::reset();
+    EXPECT_TRUE(Statistics::timedOutTranslationUnits().empty());
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "oclint/TimeBudget.h"
+
+using namespace ::testing;
+using namespace oclint;
+
+TEST(TimeBudgetTest, UnlimitedByDefault)
+{
+    TimeBudget::configure(std::chrono::milliseconds(0), std::chrono::milliseconds(0));
+    TimeBudget::startTranslationUnit();
+    EXPECT_FALSE(TimeBudget::isTranslationUnitExpired());
+    EXPECT_THAT(TimeBudget::ruleDeadline(), Eq(TimeBudget::Clock::time_point::max()));
+}
+
+TEST(TimeBudgetTest, TranslationUnitExpires)
+{
+    TimeBudget::configure(std::chrono::milliseconds(1), std::chrono::milliseconds(0));
+    TimeBudget::startTranslationUnit();
+    TimeBudget::Clock::time_point deadline = TimeBudget::ruleDeadline();
+    EXPECT_THAT(deadline, Lt(TimeBudget::Clock::time_point::max()));
+    while (TimeBudget::Clock::now() < deadline)
+    {
+    }
+    EXPECT_TRUE(TimeBudget::isTranslationUnitExpired());
+
+    TimeBudget::configure(std::chrono::hours(1), std::chrono::milliseconds(0));
+    TimeBudget::startTranslationUnit();
+    EXPECT_FALSE(TimeBudget::isTranslationUnitExpired());
+}
+
+TEST(TimeBudgetTest, RuleDeadlineWithinTranslationUnit)
+{
+    TimeBudget::configure(std::chrono::hours(1), std::chrono::milliseconds(10));
+    TimeBudget::startTranslationUnit();
+    TimeBudget::Clock::time_point before = TimeBudget::Clock::now();
+    TimeBudget::Clock::time_point ruleDeadline = TimeBudget::ruleDeadline();
+    EXPECT_THAT(ruleDeadline, Ge(before + std::chrono::milliseconds(10)));
+    EXPECT_THAT(ruleDeadline, Lt(before + std::chrono::minutes(1)));
+
+    TimeBudget::configure(std::chrono::milliseconds(10), std::chrono::hours(1));
+    TimeBudget::startTranslationUnit();
+    EXPECT_THAT(TimeBudget::ruleDeadline(),
+        Lt(TimeBudget::Clock::now() + std::chrono::minutes(1)));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,112 @@
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <clang/AST/AST.h>
+#include <clang/Frontend/ASTUnit.h>
+#include <clang/Tooling/Tooling.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "oclint/metric/CombinedMetric.h"
+#include "oclint/metric/CyclomaticComplexityMetric.h"
+#include "oclint/metric/NcssMetric.h"
+#include "oclint/metric/NPathComplexityMetric.h"
+#include "oclint/metric/StmtDepthMetric.h"
+
+/*
+ * Measures the four separate metrics against the combined metric on large
+ * synthetic functions. Run without arguments; every function is measured
+ * the given number of times, 20 by default.
+ */
+
+static const int numberOfRepetitions = 20;
+
+static std::string sequentialFunction(int numberOfStatements)
+{
+    std::string code = "int m(int a, int b) {\n";
+    for (int index = 0; index < numberOfStatements; index++)
+    {
+        std::string number = std::to_string(index);
+        code += "  if (a > " + number + " && b) { a++; } else { b = a ? b : " + number + "; }\n";
+        code += "  switch (b) { case 1: a--; break; case 2: case 3: b++; break; default: break; }\n";
+    }
+    return code + "  return a;\n}\n";
+}
+
+static std::string nestedFunction(int depth)
+{
+    std::string code = "int m(int a, int b) {\n";
+    for (int level = 0; level < depth; level++)
+    {
+        code += level % 2 ? "while (a-- > b) {\n" : "if (a || b) { b = a ? 1 : 2;\n";
+    }
+    code += "a++;\n";
+    for (int level = 0; level < depth; level++)
+    {
+        code += "}\n";
+    }
+    return code + "  return a;\n}\n";
+}
+
+static clang::FunctionDecl *findFunction(clang::ASTUnit &unit)
+{
+    clang::TranslationUnitDecl *translationUnit = unit.getASTContext().getTranslationUnitDecl();
+    for (clang::Decl *decl : translationUnit->decls())
+    {
+        clang::FunctionDecl *functionDecl = clang::dyn_cast<clang::FunctionDecl>(decl);
+        if (functionDecl && functionDecl->getNameAsString() == "m")
+        {
+            return functionDecl;
+        }
+    }
+    return nullptr;
+}
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void benchmark(const std::string &name, const std::string &code)
+{
+    std::unique_ptr<clang::ASTUnit> unit = clang::tooling::buildASTFromCode(code, "input.c");
+    clang::FunctionDecl *decl = unit ? findFunction(*unit) : nullptr;
+    if (!decl)
+    {
+        llvm::errs() << name << ": failed to parse\n";
+        return;
+    }
+
+    oclint::FunctionMetrics separate = { 0, 0, 0, 0, 0 };
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int repetition = 0; repetition < numberOfRepetitions; repetition++)
+    {
+        separate.cyclomaticComplexity = getCyclomaticComplexity(decl);
+        separate.nPathComplexity = oclint::NPathComplexityMetric().nPath(decl->getBody());
+        separate.ncss = getNcssCount(decl);
+        separate.stmtDepth = getStmtDepth(decl->getBody());
+    }
+    double separateTime = millisecondsSince(start);
+
+    oclint::FunctionMetrics combined = { 0, 0, 0, 0, 0 };
+    start = std::chrono::steady_clock::now();
+    for (int repetition = 0; repetition < numberOfRepetitions; repetition++)
+    {
+        combined = getFunctionMetrics(decl);
+    }
+    double combinedTime = millisecondsSince(start);
+
+    bool sameValues = separate.cyclomaticComplexity == combined.cyclomaticComplexity &&
+        separate.nPathComplexity == combined.nPathComplexity &&
+        separate.ncss == combined.ncss && separate.stmtDepth == combined.stmtDepth;
+    llvm::outs() << name << ": separate " << separateTime << " ms, combined "
+        << combinedTime << " ms" << (sameValues ? "" : " (values differ)") << "\n";
+}
+
+int main()
+{
+    benchmark("sequential 1000", sequentialFunction(1000));
+    benchmark("sequential 10000", sequentialFunction(10000));
+    benchmark("nested 200", nestedFunction(200));
+    return 0;
+}
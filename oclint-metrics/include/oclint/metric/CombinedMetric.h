@@ -0,0 +1,78 @@
+#ifndef OCLINT_METRIC_COMBINEDMETRIC_H
+#define OCLINT_METRIC_COMBINEDMETRIC_H
+
+#include <utility>
+#include <vector>
+
+#include <clang/AST/AST.h>
+
+#include "oclint/metric/NPathComplexityMetric.h"
+#include "oclint/metric/StmtDepthMetric.h"
+
+namespace oclint
+{
+
+struct FunctionMetrics
+{
+    int cyclomaticComplexity;
+    int64_t nPathComplexity;
+    int ncss;
+    int stmtDepth;
+    int lineCount;
+};
+
+/*
+ * Computes the cyclomatic complexity, NPath complexity, NCSS, statement depth and
+ * line count of a function or method in a single post-order pass over its body.
+ * The values are the same as those of the individual metrics, but the walk keeps
+ * its own stack instead of recursing, so arbitrarily deep code can be measured.
+ * NPath complexity is exact, saturating at the largest 64-bit value.
+ */
+class CombinedMetric
+{
+private:
+    struct Values
+    {
+        int64_t nPath;
+        int64_t exprNPath;
+        int64_t switchBodyNPath;
+        int ncss;
+        int depth;
+    };
+
+    struct Frame
+    {
+        clang::Stmt *stmt;
+        size_t firstChild;
+        bool expanded;
+    };
+
+    CompoundStmtDepthMap *_compoundDepths;
+    bool _countsComplexity;
+    int _complexity;
+    std::vector<Frame> _frames;
+    std::vector<std::pair<clang::Stmt *, Values>> _values;
+
+    Values walk(clang::Stmt *root);
+    void push(clang::Stmt *stmt);
+    void expand(clang::Stmt *stmt);
+    void countComplexity(clang::Stmt *stmt);
+    void countComplexity(clang::Decl *decl);
+    Values finish(clang::Stmt *stmt, size_t firstChild);
+    const Values &valuesOf(clang::Stmt *child, size_t firstChild) const;
+
+public:
+    /*
+     * When a depth map is given, the depth of every compound statement in the body
+     * is recorded there, the same way StmtDepthMetric records it.
+     */
+    explicit CombinedMetric(CompoundStmtDepthMap *compoundDepths = nullptr);
+
+    FunctionMetrics calculate(clang::Decl *decl);
+};
+
+} // end namespace oclint
+
+extern "C" oclint::FunctionMetrics getFunctionMetrics(clang::Decl *decl);
+
+#endif
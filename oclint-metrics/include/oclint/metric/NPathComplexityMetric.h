@@ -4,6 +4,9 @@
 #define DISPATH(STMT_TYPE) if (clang::isa<STMT_TYPE>(node)) \
 return nPath(clang::dyn_cast<STMT_TYPE>(node))
 
+#include <cstdint>
+#include <limits>
+
 #include <clang/AST/AST.h>
 
 /*
@@ -15,10 +18,43 @@ return nPath(clang::dyn_cast<STMT_TYPE>(node))
 namespace oclint
 {
 
+/* npath values are never negative, their sums and products saturate instead of overflowing */
+inline int64_t saturatingAdd(int64_t lhs, int64_t rhs)
+{
+    return lhs > std::numeric_limits<int64_t>::max() - rhs ?
+        std::numeric_limits<int64_t>::max() : lhs + rhs;
+}
+
+inline int64_t saturatingMultiply(int64_t lhs, int64_t rhs)
+{
+    if (lhs == 0 || rhs == 0)
+    {
+        return 0;
+    }
+    return lhs > std::numeric_limits<int64_t>::max() / rhs ?
+        std::numeric_limits<int64_t>::max() : lhs * rhs;
+}
+
 class NPathComplexityMetric
 {
+private:
+    int64_t _bound;
+    bool _stoppedEarly;
+
+    bool isProvablyNonZero(clang::Stmt *stmt);
+
 public:
-    int nPath(clang::Stmt *node)
+    /*
+     * Without a bound, the exact npath complexity is evaluated. With a bound, the walk
+     * stops as soon as the value is known to exceed it; any result above the bound is
+     * then only a lower bound of the exact value, while results within it are exact.
+     */
+    explicit NPathComplexityMetric(int64_t bound = std::numeric_limits<int64_t>::max());
+
+    /* whether statements were skipped after exceeding the bound */
+    bool stoppedEarly() const;
+
+    int64_t nPath(clang::Stmt *node)
     {
         if (node)
         {
@@ -34,7 +70,7 @@ public:
         return 1;
     }
 
-    int nPath(clang::Expr *node)
+    int64_t nPath(clang::Expr *node)
     {
         if (node)
         {
@@ -46,18 +82,18 @@ public:
         return 0;
     }
 
-    int nPath(clang::CompoundStmt *stmt);
-    int nPath(clang::IfStmt *stmt);
-    int nPath(clang::WhileStmt *stmt);
-    int nPath(clang::DoStmt *stmt);
-    int nPath(clang::ForStmt *stmt);
-    int nPath(clang::ObjCForCollectionStmt *stmt);
-    int nPath(clang::SwitchStmt *stmt);
-    int nPath(clang::SwitchCase *stmt);
-    int nPath(clang::ConditionalOperator *expr);
-    int nPath(clang::BinaryOperator *expr);
-    int nPath(clang::ParenExpr *expr);
-    int nPath(clang::CastExpr *expr);
+    int64_t nPath(clang::CompoundStmt *stmt);
+    int64_t nPath(clang::IfStmt *stmt);
+    int64_t nPath(clang::WhileStmt *stmt);
+    int64_t nPath(clang::DoStmt *stmt);
+    int64_t nPath(clang::ForStmt *stmt);
+    int64_t nPath(clang::ObjCForCollectionStmt *stmt);
+    int64_t nPath(clang::SwitchStmt *stmt);
+    int64_t nPath(clang::SwitchCase *stmt);
+    int64_t nPath(clang::ConditionalOperator *expr);
+    int64_t nPath(clang::BinaryOperator *expr);
+    int64_t nPath(clang::ParenExpr *expr);
+    int64_t nPath(clang::CastExpr *expr);
 };
 
 } // end namespace oclint
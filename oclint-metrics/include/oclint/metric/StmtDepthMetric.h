@@ -4,14 +4,31 @@
 #define DISPATH(STMT_TYPE) if (clang::isa<STMT_TYPE>(node)) \
 return depth(clang::dyn_cast<STMT_TYPE>(node))
 
+#include <unordered_map>
+
 #include <clang/AST/AST.h>
 
 namespace oclint
 {
 
+/* depths of the compound statements already measured, keyed by statement */
+typedef std::unordered_map<const clang::CompoundStmt *, int> CompoundStmtDepthMap;
+
 class StmtDepthMetric
 {
+private:
+    CompoundStmtDepthMap *_compoundDepths;
+
 public:
+    /*
+     * When a depth map is given, the depth of every compound statement measured on
+     * the way is recorded there and reused by later calls sharing the same map.
+     */
+    explicit StmtDepthMetric(CompoundStmtDepthMap *compoundDepths = nullptr)
+        : _compoundDepths(compoundDepths)
+    {
+    }
+
     int depth(clang::Stmt *node)
     {
         if (node)
@@ -0,0 +1,421 @@
+#include "oclint/metric/CombinedMetric.h"
+
+#include <algorithm>
+
+#include "oclint/metric/CyclomaticComplexityMetric.h"
+
+using namespace oclint;
+
+CombinedMetric::CombinedMetric(CompoundStmtDepthMap *compoundDepths)
+    : _compoundDepths(compoundDepths), _countsComplexity(true), _complexity(0)
+{
+}
+
+FunctionMetrics CombinedMetric::calculate(clang::Decl *decl)
+{
+    _complexity = 0;
+    _countsComplexity = true;
+
+    // like the cyclomatic complexity visitor, count the default arguments and the written
+    // initializers of the declaration, but the body only when this declaration defines it
+    clang::FunctionDecl *functionDecl = clang::dyn_cast<clang::FunctionDecl>(decl);
+    if (functionDecl)
+    {
+        for (clang::ParmVarDecl *parameter : functionDecl->parameters())
+        {
+            if (parameter->hasDefaultArg() && !parameter->hasUnparsedDefaultArg())
+            {
+                walk(parameter->hasUninstantiatedDefaultArg() ?
+                    parameter->getUninstantiatedDefaultArg() : parameter->getDefaultArg());
+            }
+        }
+        clang::CXXConstructorDecl *constructor = clang::dyn_cast<clang::CXXConstructorDecl>(decl);
+        if (constructor)
+        {
+            for (clang::CXXCtorInitializer *initializer : constructor->inits())
+            {
+                if (initializer->isWritten())
+                {
+                    walk(initializer->getInit());
+                }
+            }
+        }
+        _countsComplexity = functionDecl->isThisDeclarationADefinition();
+    }
+    clang::ObjCMethodDecl *methodDecl = clang::dyn_cast<clang::ObjCMethodDecl>(decl);
+    if (methodDecl)
+    {
+        _countsComplexity = methodDecl->isThisDeclarationADefinition();
+    }
+
+    FunctionMetrics metrics = { 1, 1, 0, 0, 0 };
+    clang::Stmt *body = decl->getBody();
+    if (body)
+    {
+        Values values = walk(body);
+        const clang::SourceManager &sourceManager = decl->getASTContext().getSourceManager();
+        metrics.nPathComplexity = values.nPath;
+        metrics.ncss = values.ncss;
+        metrics.stmtDepth = values.depth;
+        metrics.lineCount = sourceManager.getPresumedLineNumber(body->getLocEnd()) -
+            sourceManager.getPresumedLineNumber(body->getLocStart()) + 1;
+    }
+    if (decl->hasBody())
+    {
+        metrics.ncss++;
+    }
+    metrics.cyclomaticComplexity = _complexity + 1;
+    return metrics;
+}
+
+CombinedMetric::Values CombinedMetric::walk(clang::Stmt *root)
+{
+    Values rootValues = { 1, 0, 0, 0, 0 };
+    if (!root)
+    {
+        return rootValues;
+    }
+
+    push(root);
+    while (!_frames.empty())
+    {
+        Frame &frame = _frames.back();
+        if (!frame.expanded)
+        {
+            frame.expanded = true;
+            frame.firstChild = _values.size();
+            clang::Stmt *stmt = frame.stmt;
+            if (_countsComplexity)
+            {
+                countComplexity(stmt);
+            }
+            size_t firstFrame = _frames.size();
+            expand(stmt);
+            // children are popped in source order, so their values follow each other
+            std::reverse(_frames.begin() + firstFrame, _frames.end());
+            continue;
+        }
+
+        clang::Stmt *stmt = frame.stmt;
+        size_t firstChild = frame.firstChild;
+        _frames.pop_back();
+        Values values = finish(stmt, firstChild);
+        _values.resize(firstChild);
+        _values.push_back(std::make_pair(stmt, values));
+    }
+
+    rootValues = _values.back().second;
+    _values.clear();
+    return rootValues;
+}
+
+void CombinedMetric::push(clang::Stmt *stmt)
+{
+    if (stmt)
+    {
+        Frame frame = { stmt, 0, false };
+        _frames.push_back(frame);
+    }
+}
+
+/*
+ * Children are the ones the cyclomatic complexity visitor traverses. Where that differs
+ * from Stmt::children(), the traversal of RecursiveASTVisitor is followed.
+ */
+void CombinedMetric::expand(clang::Stmt *stmt)
+{
+    if (clang::DeclStmt *declStmt = clang::dyn_cast<clang::DeclStmt>(stmt))
+    {
+        for (clang::Decl *decl : declStmt->decls())
+        {
+            clang::VarDecl *varDecl = clang::dyn_cast<clang::VarDecl>(decl);
+            if (!varDecl)
+            {
+                countComplexity(decl);
+            }
+            else if (!varDecl->isCXXForRangeDecl())
+            {
+                push(varDecl->getInit());
+            }
+        }
+    }
+    else if (clang::CXXForRangeStmt *forRangeStmt = clang::dyn_cast<clang::CXXForRangeStmt>(stmt))
+    {
+        push(forRangeStmt->getLoopVarStmt());
+        push(forRangeStmt->getRangeInit());
+        push(forRangeStmt->getBody());
+    }
+    else if (clang::BlockExpr *blockExpr = clang::dyn_cast<clang::BlockExpr>(stmt))
+    {
+        push(blockExpr->getBlockDecl()->getBody());
+    }
+    else if (clang::PseudoObjectExpr *pseudoObjectExpr = clang::dyn_cast<clang::PseudoObjectExpr>(stmt))
+    {
+        push(pseudoObjectExpr->getSyntacticForm());
+        for (clang::PseudoObjectExpr::semantics_iterator semantic =
+            pseudoObjectExpr->semantics_begin(), semanticEnd = pseudoObjectExpr->semantics_end();
+            semantic != semanticEnd; semantic++)
+        {
+            clang::OpaqueValueExpr *opaqueValue = clang::dyn_cast<clang::OpaqueValueExpr>(*semantic);
+            push(opaqueValue ? opaqueValue->getSourceExpr() : *semantic);
+        }
+    }
+    else if (clang::InitListExpr *initListExpr = clang::dyn_cast<clang::InitListExpr>(stmt))
+    {
+        clang::InitListExpr *syntacticForm =
+            initListExpr->isSemanticForm() ? initListExpr->getSyntacticForm() : initListExpr;
+        clang::InitListExpr *semanticForm =
+            initListExpr->isSemanticForm() ? initListExpr : initListExpr->getSemanticForm();
+        for (clang::InitListExpr *form : { syntacticForm, semanticForm })
+        {
+            if (form)
+            {
+                for (clang::Stmt *child : form->children())
+                {
+                    push(child);
+                }
+            }
+        }
+    }
+    else
+    {
+        for (clang::Stmt *child : stmt->children())
+        {
+            push(child);
+        }
+    }
+}
+
+void CombinedMetric::countComplexity(clang::Stmt *stmt)
+{
+    if (clang::isa<clang::IfStmt>(stmt) ||
+        clang::isa<clang::ForStmt>(stmt) ||
+        clang::isa<clang::ObjCForCollectionStmt>(stmt) ||
+        clang::isa<clang::WhileStmt>(stmt) ||
+        clang::isa<clang::DoStmt>(stmt) ||
+        clang::isa<clang::CaseStmt>(stmt) ||
+        clang::isa<clang::ObjCAtCatchStmt>(stmt) ||
+        clang::isa<clang::CXXCatchStmt>(stmt) ||
+        clang::isa<clang::ConditionalOperator>(stmt))
+    {
+        _complexity++;
+    }
+    else if (clang::BinaryOperator *binaryOperator = clang::dyn_cast<clang::BinaryOperator>(stmt))
+    {
+        if (binaryOperator->getOpcode() == clang::BO_LAnd ||
+            binaryOperator->getOpcode() == clang::BO_LOr)
+        {
+            _complexity++;
+        }
+    }
+}
+
+/* local classes and other declarations in a function body are rare enough to visit */
+void CombinedMetric::countComplexity(clang::Decl *decl)
+{
+    if (_countsComplexity)
+    {
+        CyclomaticComplexityMetric ccnMetric;
+        _complexity += ccnMetric.calculate(decl) - 1;
+    }
+}
+
+const CombinedMetric::Values &CombinedMetric::valuesOf(clang::Stmt *child, size_t firstChild) const
+{
+    static const Values nullValues = { 1, 0, 0, 0, 0 };
+    if (child)
+    {
+        for (size_t index = firstChild; index != _values.size(); index++)
+        {
+            if (_values[index].first == child)
+            {
+                return _values[index].second;
+            }
+        }
+    }
+    return nullValues;
+}
+
+static clang::Stmt *objCBlockOf(clang::Stmt *stmt)
+{
+    if (clang::ObjCAtCatchStmt *catchStmt = clang::dyn_cast<clang::ObjCAtCatchStmt>(stmt))
+    {
+        return catchStmt->getCatchBody();
+    }
+    if (clang::ObjCAtFinallyStmt *finallyStmt = clang::dyn_cast<clang::ObjCAtFinallyStmt>(stmt))
+    {
+        return finallyStmt->getFinallyBody();
+    }
+    if (clang::ObjCAtSynchronizedStmt *synchronizedStmt =
+        clang::dyn_cast<clang::ObjCAtSynchronizedStmt>(stmt))
+    {
+        return synchronizedStmt->getSynchBody();
+    }
+    if (clang::ObjCAutoreleasePoolStmt *autoreleasePoolStmt =
+        clang::dyn_cast<clang::ObjCAutoreleasePoolStmt>(stmt))
+    {
+        return autoreleasePoolStmt->getSubStmt();
+    }
+    return nullptr;
+}
+
+CombinedMetric::Values CombinedMetric::finish(clang::Stmt *stmt, size_t firstChild)
+{
+    // a statement without structure: one path, one statement, no depth
+    Values values = { 1, 0, 0, 1, 0 };
+
+    if (clang::CompoundStmt *compoundStmt = clang::dyn_cast<clang::CompoundStmt>(stmt))
+    {
+        int64_t nPathOfCases = 0, nPathOfCase = 0;
+        int maxDepth = 0;
+        values.ncss = 0;
+        for (size_t index = firstChild; index != _values.size(); index++)
+        {
+            const Values &child = _values[index].second;
+            values.nPath = saturatingMultiply(values.nPath, child.nPath);
+            values.ncss += child.ncss;
+            maxDepth = std::max(maxDepth, child.depth);
+            if (clang::isa<clang::SwitchCase>(_values[index].first))
+            {
+                nPathOfCases = saturatingAdd(nPathOfCases, nPathOfCase);
+                nPathOfCase = child.nPath;
+            }
+            else
+            {
+                nPathOfCase = saturatingMultiply(nPathOfCase, child.nPath);
+            }
+        }
+        values.switchBodyNPath = saturatingAdd(nPathOfCases, nPathOfCase);
+        values.depth = 1 + maxDepth;
+        if (_compoundDepths)
+        {
+            (*_compoundDepths)[compoundStmt] = values.depth;
+        }
+    }
+    else if (clang::IfStmt *ifStmt = clang::dyn_cast<clang::IfStmt>(stmt))
+    {
+        const Values &thenValues = valuesOf(ifStmt->getThen(), firstChild);
+        int64_t nPathOfElse = 1;
+        values.ncss = 1 + thenValues.ncss;
+        values.depth = thenValues.depth;
+        clang::Stmt *elseStmt = ifStmt->getElse();
+        if (elseStmt)
+        {
+            const Values &elseValues = valuesOf(elseStmt, firstChild);
+            nPathOfElse = elseValues.nPath;
+            values.ncss += elseValues.ncss + 1;
+            values.depth = std::max(values.depth, elseValues.depth);
+        }
+        values.nPath = saturatingAdd(saturatingAdd(valuesOf(ifStmt->getCond(), firstChild).exprNPath,
+            thenValues.nPath), nPathOfElse);
+    }
+    else if (clang::WhileStmt *whileStmt = clang::dyn_cast<clang::WhileStmt>(stmt))
+    {
+        const Values &bodyValues = valuesOf(whileStmt->getBody(), firstChild);
+        values.nPath = saturatingAdd(saturatingAdd(valuesOf(whileStmt->getCond(), firstChild).exprNPath,
+            bodyValues.nPath), 1);
+        values.ncss = 1 + bodyValues.ncss;
+        values.depth = bodyValues.depth;
+    }
+    else if (clang::DoStmt *doStmt = clang::dyn_cast<clang::DoStmt>(stmt))
+    {
+        const Values &bodyValues = valuesOf(doStmt->getBody(), firstChild);
+        values.nPath = saturatingAdd(saturatingAdd(valuesOf(doStmt->getCond(), firstChild).exprNPath,
+            bodyValues.nPath), 1);
+        values.ncss = 2 + bodyValues.ncss;
+        values.depth = bodyValues.depth;
+    }
+    else if (clang::ForStmt *forStmt = clang::dyn_cast<clang::ForStmt>(stmt))
+    {
+        const Values &bodyValues = valuesOf(forStmt->getBody(), firstChild);
+        int64_t nPathOfHeader = saturatingAdd(saturatingAdd(valuesOf(forStmt->getInit(), firstChild).nPath,
+            valuesOf(forStmt->getCond(), firstChild).exprNPath), valuesOf(forStmt->getInc(), firstChild).exprNPath);
+        values.nPath = saturatingAdd(saturatingAdd(nPathOfHeader, bodyValues.nPath), 1);
+        values.ncss = 1 + bodyValues.ncss;
+        values.depth = bodyValues.depth;
+    }
+    else if (clang::ObjCForCollectionStmt *forCollectionStmt =
+        clang::dyn_cast<clang::ObjCForCollectionStmt>(stmt))
+    {
+        const Values &bodyValues = valuesOf(forCollectionStmt->getBody(), firstChild);
+        values.nPath = saturatingAdd(bodyValues.nPath, 2);
+        values.ncss = 1 + bodyValues.ncss;
+        values.depth = bodyValues.depth;
+    }
+    else if (clang::SwitchStmt *switchStmt = clang::dyn_cast<clang::SwitchStmt>(stmt))
+    {
+        clang::Stmt *body = switchStmt->getBody();
+        const Values &bodyValues = valuesOf(body, firstChild);
+        values.nPath = saturatingAdd(valuesOf(switchStmt->getCond(), firstChild).exprNPath,
+            clang::isa<clang::CompoundStmt>(body) ? bodyValues.switchBodyNPath : bodyValues.nPath);
+        values.ncss = 1 + bodyValues.ncss;
+        values.depth = bodyValues.depth;
+    }
+    else if (clang::SwitchCase *switchCase = clang::dyn_cast<clang::SwitchCase>(stmt))
+    {
+        const Values &subValues = valuesOf(switchCase->getSubStmt(), firstChild);
+        values.nPath = subValues.nPath;
+        values.ncss = 1 + subValues.ncss;
+        values.depth = subValues.depth;
+    }
+    else if (clang::isa<clang::CXXTryStmt>(stmt) || clang::isa<clang::ObjCAtTryStmt>(stmt))
+    {
+        // try block, handlers and finally block are all children
+        for (size_t index = firstChild; index != _values.size(); index++)
+        {
+            const Values &child = _values[index].second;
+            values.ncss += child.ncss;
+            values.depth = std::max(values.depth, child.depth);
+        }
+    }
+    else if (clang::CXXCatchStmt *catchStmt = clang::dyn_cast<clang::CXXCatchStmt>(stmt))
+    {
+        const Values &blockValues = valuesOf(catchStmt->getHandlerBlock(), firstChild);
+        values.ncss = 1 + blockValues.ncss;
+        values.depth = blockValues.depth;
+    }
+    else if (clang::Stmt *block = objCBlockOf(stmt))
+    {
+        const Values &blockValues = valuesOf(block, firstChild);
+        values.ncss = 1 + blockValues.ncss;
+        values.depth = blockValues.depth;
+    }
+    else if (clang::isa<clang::NullStmt>(stmt))
+    {
+        values.ncss = 0;
+    }
+    else if (clang::ConditionalOperator *conditionalOperator =
+        clang::dyn_cast<clang::ConditionalOperator>(stmt))
+    {
+        values.exprNPath = saturatingAdd(saturatingAdd(saturatingAdd(
+            valuesOf(conditionalOperator->getCond(), firstChild).exprNPath,
+            valuesOf(conditionalOperator->getTrueExpr(), firstChild).exprNPath),
+            valuesOf(conditionalOperator->getFalseExpr(), firstChild).exprNPath), 2);
+    }
+    else if (clang::BinaryOperator *binaryOperator = clang::dyn_cast<clang::BinaryOperator>(stmt))
+    {
+        if (binaryOperator->getOpcode() == clang::BO_LAnd ||
+            binaryOperator->getOpcode() == clang::BO_LOr)
+        {
+            values.exprNPath = saturatingAdd(saturatingAdd(1,
+                valuesOf(binaryOperator->getLHS(), firstChild).exprNPath),
+                valuesOf(binaryOperator->getRHS(), firstChild).exprNPath);
+        }
+    }
+    else if (clang::ParenExpr *parenExpr = clang::dyn_cast<clang::ParenExpr>(stmt))
+    {
+        values.exprNPath = valuesOf(parenExpr->getSubExpr(), firstChild).exprNPath;
+    }
+    else if (clang::CastExpr *castExpr = clang::dyn_cast<clang::CastExpr>(stmt))
+    {
+        values.exprNPath = valuesOf(castExpr->getSubExpr(), firstChild).exprNPath;
+    }
+
+    return values;
+}
+
+extern "C" oclint::FunctionMetrics getFunctionMetrics(clang::Decl *decl)
+{
+    CombinedMetric combinedMetric;
+    return combinedMetric.calculate(decl);
+}
@@ -2,39 +2,103 @@
 
 using namespace oclint;
 
-int NPathComplexityMetric::nPath(clang::CompoundStmt *stmt)
+NPathComplexityMetric::NPathComplexityMetric(int64_t bound)
+    : _bound(bound), _stoppedEarly(false)
 {
-    int npath = 1;
+}
+
+bool NPathComplexityMetric::stoppedEarly() const
+{
+    return _stoppedEarly;
+}
+
+/*
+ * Conservative: only switch statements can contribute no path at all, so anything
+ * that could contain one in an npath position is not known to be non-zero.
+ */
+bool NPathComplexityMetric::isProvablyNonZero(clang::Stmt *stmt)
+{
+    if (clang::CompoundStmt *compoundStmt = clang::dyn_cast_or_null<clang::CompoundStmt>(stmt))
+    {
+        for (clang::CompoundStmt::body_iterator body = compoundStmt->body_begin(),
+            bodyEnd = compoundStmt->body_end(); body != bodyEnd; body++)
+        {
+            if (!isProvablyNonZero(*body))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (clang::IfStmt *ifStmt = clang::dyn_cast_or_null<clang::IfStmt>(stmt))
+    {
+        return !ifStmt->getElse() ||
+            isProvablyNonZero(ifStmt->getThen()) || isProvablyNonZero(ifStmt->getElse());
+    }
+    if (clang::SwitchCase *switchCase = clang::dyn_cast_or_null<clang::SwitchCase>(stmt))
+    {
+        return isProvablyNonZero(switchCase->getSubStmt());
+    }
+    return !stmt || !clang::isa<clang::SwitchStmt>(stmt);
+}
+
+int64_t NPathComplexityMetric::nPath(clang::CompoundStmt *stmt)
+{
+    int64_t npath = 1;
+    clang::CompoundStmt::body_iterator lastPossiblyZero = stmt->body_begin();
+    bool checkedRemainingStmts = false;
     for (clang::CompoundStmt::body_iterator body = stmt->body_begin(), bodyEnd = stmt->body_end();
         body != bodyEnd; body++)
     {
-        npath *= nPath(*body);
+        npath = saturatingMultiply(npath, nPath(*body));
+        if (npath > _bound)
+        {
+            // the rest can only keep the product above the bound unless one of them is zero
+            if (!checkedRemainingStmts)
+            {
+                checkedRemainingStmts = true;
+                lastPossiblyZero = body;
+                for (clang::CompoundStmt::body_iterator remaining = body + 1;
+                    remaining != bodyEnd; remaining++)
+                {
+                    if (!isProvablyNonZero(*remaining))
+                    {
+                        lastPossiblyZero = remaining;
+                    }
+                }
+            }
+            if (body >= lastPossiblyZero && body + 1 != bodyEnd)
+            {
+                _stoppedEarly = true;
+                return npath;
+            }
+        }
     }
     return npath;
 }
 
-int NPathComplexityMetric::nPath(clang::IfStmt *stmt)
+int64_t NPathComplexityMetric::nPath(clang::IfStmt *stmt)
 {
-    int nPathElseStmt = 1;
+    int64_t nPathElseStmt = 1;
     clang::Stmt *elseStmt = stmt->getElse();
     if (elseStmt)
     {
         nPathElseStmt = nPath(elseStmt);
     }
-    return nPath(stmt->getCond()) + nPath(stmt->getThen()) + nPathElseStmt;
+    return saturatingAdd(saturatingAdd(nPath(stmt->getCond()), nPath(stmt->getThen())), nPathElseStmt);
 }
 
-int NPathComplexityMetric::nPath(clang::WhileStmt *stmt)
+int64_t NPathComplexityMetric::nPath(clang::WhileStmt *stmt)
 {
-    return nPath(stmt->getCond()) + nPath(stmt->getBody()) + 1;
+    return saturatingAdd(saturatingAdd(nPath(stmt->getCond()), nPath(stmt->getBody())), 1);
 }
 
-int NPathComplexityMetric::nPath(clang::DoStmt *stmt)
+int64_t NPathComplexityMetric::nPath(clang::DoStmt *stmt)
 {
-    return nPath(stmt->getCond()) + nPath(stmt->getBody()) + 1;
+    return saturatingAdd(saturatingAdd(nPath(stmt->getCond()), nPath(stmt->getBody())), 1);
 }
 
-int NPathComplexityMetric::nPath(clang::ForStmt *stmt)
+int64_t NPathComplexityMetric::nPath(clang::ForStmt *stmt)
 {
     // TODO:
     // Base on Nejmeh's NPATH, the first expression is used to initialize a loop control variable,
@@ -59,11 +123,12 @@ int NPathComplexityMetric::nPath(clang::ForStmt *stmt)
     // As a conclusion, in my opinion, same logic in different formats should not reduce
     // the complexity. However, here, I will follow Nejmeh's NPath
 
-    return nPath(stmt->getInit()) + nPath(stmt->getCond()) + nPath(stmt->getInc())
-        + nPath(stmt->getBody()) + 1;
+    int64_t nPathOfHeader =
+        saturatingAdd(saturatingAdd(nPath(stmt->getInit()), nPath(stmt->getCond())), nPath(stmt->getInc()));
+    return saturatingAdd(saturatingAdd(nPathOfHeader, nPath(stmt->getBody())), 1);
 }
 
-int NPathComplexityMetric::nPath(clang::ObjCForCollectionStmt *stmt)
+int64_t NPathComplexityMetric::nPath(clang::ObjCForCollectionStmt *stmt)
 {
     // If we convert a foreach loop to a simple for loop, it will looks like
     // for (int i = 0; i < [anArray count]; i++) {
@@ -73,16 +138,16 @@ int NPathComplexityMetric::nPath(clang::ObjCForCollectionStmt *stmt)
     // So, convert to same logic in for statement, we assume the NPath complexity as below
     // NP(Foreach) := NP((for-range)) + 2
 
-    return nPath(stmt->getBody()) + 2;
+    return saturatingAdd(nPath(stmt->getBody()), 2);
 }
 
-int NPathComplexityMetric::nPath(clang::SwitchStmt *stmt)
+int64_t NPathComplexityMetric::nPath(clang::SwitchStmt *stmt)
 {
-    int internalNPath = 0, nPathSwitchStmt = nPath(stmt->getCond());
+    int64_t internalNPath = 0, nPathSwitchStmt = nPath(stmt->getCond());
     clang::Stmt *body = stmt->getBody();
     if(!clang::isa<clang::CompoundStmt>(body))
     {
-        return nPathSwitchStmt + nPath(body);
+        return saturatingAdd(nPathSwitchStmt, nPath(body));
     }
     clang::CompoundStmt *compound = clang::dyn_cast<clang::CompoundStmt>(body);
     for (clang::CompoundStmt::body_iterator bodyStmt = compound->body_begin(),
@@ -90,42 +155,43 @@ int NPathComplexityMetric::nPath(clang::SwitchStmt *stmt)
     {
         if (clang::isa<clang::SwitchCase>(*bodyStmt))
         {
-            nPathSwitchStmt += internalNPath;
+            nPathSwitchStmt = saturatingAdd(nPathSwitchStmt, internalNPath);
             internalNPath = nPath(*bodyStmt);
         }
         else
         {
-            internalNPath *= nPath(*bodyStmt);
+            internalNPath = saturatingMultiply(internalNPath, nPath(*bodyStmt));
         }
     }
-    return nPathSwitchStmt + internalNPath;
+    return saturatingAdd(nPathSwitchStmt, internalNPath);
 }
 
-int NPathComplexityMetric::nPath(clang::SwitchCase *expr)
+int64_t NPathComplexityMetric::nPath(clang::SwitchCase *expr)
 {
     return nPath(expr->getSubStmt());
 }
 
-int NPathComplexityMetric::nPath(clang::ConditionalOperator *expr)
+int64_t NPathComplexityMetric::nPath(clang::ConditionalOperator *expr)
 {
-    return nPath(expr->getCond()) + nPath(expr->getTrueExpr()) + nPath(expr->getFalseExpr()) + 2;
+    return saturatingAdd(saturatingAdd(saturatingAdd(nPath(expr->getCond()),
+        nPath(expr->getTrueExpr())), nPath(expr->getFalseExpr())), 2);
 }
 
-int NPathComplexityMetric::nPath(clang::BinaryOperator *expr)
+int64_t NPathComplexityMetric::nPath(clang::BinaryOperator *expr)
 {
     if (expr->getOpcode() == clang::BO_LAnd || expr->getOpcode() == clang::BO_LOr)
     {
-        return 1 + nPath(expr->getLHS()) + nPath(expr->getRHS());
+        return saturatingAdd(saturatingAdd(1, nPath(expr->getLHS())), nPath(expr->getRHS()));
     }
     return 0;
 }
 
-int NPathComplexityMetric::nPath(clang::ParenExpr *expr)
+int64_t NPathComplexityMetric::nPath(clang::ParenExpr *expr)
 {
     return nPath(expr->getSubExpr());
 }
 
-int NPathComplexityMetric::nPath(clang::CastExpr *expr)
+int64_t NPathComplexityMetric::nPath(clang::CastExpr *expr)
 {
     return nPath(expr->getSubExpr());
 }
@@ -133,5 +199,6 @@ int NPathComplexityMetric::nPath(clang::CastExpr *expr)
 extern "C" int getNPathComplexity(clang::Stmt *stmt)
 {
     NPathComplexityMetric npathMetric;
-    return npathMetric.nPath(stmt);
+    int64_t npath = npathMetric.nPath(stmt);
+    return npath > std::numeric_limits<int>::max() ? std::numeric_limits<int>::max() : int(npath);
 }
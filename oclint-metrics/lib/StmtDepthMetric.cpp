@@ -4,6 +4,15 @@ using namespace oclint;
 
 int StmtDepthMetric::depth(clang::CompoundStmt *stmt)
 {
+    if (_compoundDepths)
+    {
+        CompoundStmtDepthMap::const_iterator measured = _compoundDepths->find(stmt);
+        if (measured != _compoundDepths->end())
+        {
+            return measured->second;
+        }
+    }
+
     int maxDepth = 0;
     for (clang::CompoundStmt::body_iterator body = stmt->body_begin(), bodyEnd = stmt->body_end();
         body != bodyEnd; body++)
@@ -14,6 +23,10 @@ int StmtDepthMetric::depth(clang::CompoundStmt *stmt)
             maxDepth = depthOfSubStmt;
         }
     }
+    if (_compoundDepths)
+    {
+        (*_compoundDepths)[stmt] = 1 + maxDepth;
+    }
     return 1 + maxDepth;
 }
 
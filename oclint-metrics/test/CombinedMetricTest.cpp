@@ -0,0 +1,203 @@
+#include "TestHeaders.h"
+
+#include "oclint/metric/CombinedMetric.h"
+#include "oclint/metric/CyclomaticComplexityMetric.h"
+#include "oclint/metric/NcssMetric.h"
+#include "oclint/metric/NPathComplexityMetric.h"
+
+using namespace oclint;
+
+DeclarationMatcher functionDeclMatcher = functionDecl(hasName("m")).bind("functionDecl");
+
+class SameAsSeparateMetricsCallback : public MatchFinder::MatchCallback
+{
+public:
+    virtual void run(const MatchFinder::MatchResult &results)
+    {
+        FunctionDecl *functionDecl = (FunctionDecl *)
+            results.Nodes.getNodeAs<FunctionDecl>("functionDecl");
+        if (functionDecl)
+        {
+            FunctionMetrics metrics = getFunctionMetrics(functionDecl);
+            EXPECT_EQ(getCyclomaticComplexity(functionDecl), metrics.cyclomaticComplexity);
+            EXPECT_EQ(getNPathComplexity(functionDecl->getBody()), metrics.nPathComplexity);
+            EXPECT_EQ(getNcssCount(functionDecl), metrics.ncss);
+            EXPECT_EQ(getStmtDepth(functionDecl->getBody()), metrics.stmtDepth);
+        }
+        else
+        {
+            FAIL();
+        }
+    }
+};
+
+class MetricsCallback : public MatchFinder::MatchCallback
+{
+private:
+    FunctionMetrics _expected;
+
+public:
+    MetricsCallback(int ccn, int npath, int ncss, int depth, int lines)
+    {
+        _expected.cyclomaticComplexity = ccn;
+        _expected.nPathComplexity = npath;
+        _expected.ncss = ncss;
+        _expected.stmtDepth = depth;
+        _expected.lineCount = lines;
+    }
+
+    virtual void run(const MatchFinder::MatchResult &results)
+    {
+        FunctionDecl *functionDecl = (FunctionDecl *)
+            results.Nodes.getNodeAs<FunctionDecl>("functionDecl");
+        if (functionDecl)
+        {
+            FunctionMetrics metrics = getFunctionMetrics(functionDecl);
+            EXPECT_EQ(_expected.cyclomaticComplexity, metrics.cyclomaticComplexity);
+            EXPECT_EQ(_expected.nPathComplexity, metrics.nPathComplexity);
+            EXPECT_EQ(_expected.ncss, metrics.ncss);
+            EXPECT_EQ(_expected.stmtDepth, metrics.stmtDepth);
+            EXPECT_EQ(_expected.lineCount, metrics.lineCount);
+        }
+        else
+        {
+            FAIL();
+        }
+    }
+};
+
+class CompoundDepthsCallback : public MatchFinder::MatchCallback
+{
+public:
+    virtual void run(const MatchFinder::MatchResult &results)
+    {
+        FunctionDecl *functionDecl = (FunctionDecl *)
+            results.Nodes.getNodeAs<FunctionDecl>("functionDecl");
+        ASSERT_TRUE(functionDecl);
+
+        CompoundStmtDepthMap depths;
+        CombinedMetric combinedMetric(&depths);
+        combinedMetric.calculate(functionDecl);
+        EXPECT_EQ(3u, depths.size());
+
+        CompoundStmtDepthMap measuredDepths;
+        StmtDepthMetric stmtDepthMetric(&measuredDepths);
+        stmtDepthMetric.depth(functionDecl->getBody());
+        EXPECT_EQ(measuredDepths, depths);
+    }
+};
+
+TEST(CombinedMetricTest, EmptyFunction)
+{
+    MetricsCallback metricsCallback(1, 1, 1, 1, 1);
+    MatchFinder finder;
+    finder.addMatcher(functionDeclMatcher, &metricsCallback);
+
+    testMatcherOnCode(finder, "void m() {}");
+}
+
+TEST(CombinedMetricTest, FunctionDeclarationWithoutBody)
+{
+    MetricsCallback metricsCallback(1, 1, 0, 0, 0);
+    MatchFinder finder;
+    finder.addMatcher(functionDeclMatcher, &metricsCallback);
+
+    testMatcherOnCode(finder, "void m();");
+}
+
+TEST(CombinedMetricTest, AllMetricsOfOneFunction)
+{
+    MetricsCallback metricsCallback(4, 4, 4, 3, 5);
+    MatchFinder finder;
+    finder.addMatcher(functionDeclMatcher, &metricsCallback);
+
+    testMatcherOnCode(finder, "void m(int a) {\n"
+        "  if (a && a > 1) {\n"
+        "    while (a) { a--; }\n"
+        "  }\n"
+        "}");
+}
+
+TEST(CombinedMetricTest, SameAsSeparateMetricsForBranches)
+{
+    SameAsSeparateMetricsCallback metricsCallback;
+    MatchFinder finder;
+    finder.addMatcher(functionDeclMatcher, &metricsCallback);
+
+    testMatcherOnCode(finder, "void m(int a, int b) { if (a) {} else if (b || a) { b++; } else {} "
+        "if (a ? b : 0) { if (b) {;} } a = a && b ? 1 : 2; }");
+}
+
+TEST(CombinedMetricTest, SameAsSeparateMetricsForLoops)
+{
+    SameAsSeparateMetricsCallback metricsCallback;
+    MatchFinder finder;
+    finder.addMatcher(functionDeclMatcher, &metricsCallback);
+
+    testMatcherOnCode(finder, "void m(int a) { for (int i = 0; i < a && a; i++) { while (a > 0) a--; } "
+        "do { { a++; } } while (a < 10 || a == 20); for (;;) {} }");
+}
+
+TEST(CombinedMetricTest, SameAsSeparateMetricsForSwitch)
+{
+    SameAsSeparateMetricsCallback metricsCallback;
+    MatchFinder finder;
+    finder.addMatcher(functionDeclMatcher, &metricsCallback);
+
+    testMatcherOnCode(finder, "void m(int a) { switch (a) { case 1: if (a) {} break; "
+        "case 2: case 3: { a++; } break; default: break; } switch (a) case 1: break; }");
+}
+
+TEST(CombinedMetricTest, SameAsSeparateMetricsForCXX)
+{
+    SameAsSeparateMetricsCallback metricsCallback;
+    MatchFinder finder;
+    finder.addMatcher(functionDeclMatcher, &metricsCallback);
+
+    testMatcherOnCXXCode(finder, "void m(int a) { try { if (a) {} } catch (int) { a++; } catch (...) {} "
+        "int v[] = {a ? 1 : 0, a && a}; if (v[0]) {} }");
+}
+
+TEST(CombinedMetricTest, SameAsSeparateMetricsForObjC)
+{
+    SameAsSeparateMetricsCallback metricsCallback;
+    MatchFinder finder;
+    finder.addMatcher(functionDeclMatcher, &metricsCallback);
+
+    testMatcherOnObjCCode(finder, "void m(id a) { @try { for (id i in a) {} } @catch (id e) { if (e) {} } "
+        "@finally { @synchronized(a) { @autoreleasepool { int b = a ? 1 : 2; } } } }");
+}
+
+TEST(CombinedMetricTest, SameAsSeparateMetricsForLocalClass)
+{
+    SameAsSeparateMetricsCallback metricsCallback;
+    MatchFinder finder;
+    finder.addMatcher(functionDeclMatcher, &metricsCallback);
+
+    testMatcherOnCXXCode(finder, "void m(int a) { struct S { int f(int b) { return b ? 1 : 0; } }; "
+        "if (a) { S().f(a); } }");
+}
+
+TEST(CombinedMetricTest, DefaultArgumentsCountTowardsComplexity)
+{
+    SameAsSeparateMetricsCallback metricsCallback;
+    MatchFinder finder;
+    finder.addMatcher(functionDeclMatcher, &metricsCallback);
+
+    testMatcherOnCXXCode(finder, "void m(int a, int b = 1 ? 2 : 3) { if (a) {} }");
+}
+
+TEST(CombinedMetricTest, RecordsTheDepthOfEveryCompoundStatement)
+{
+    CompoundDepthsCallback depthsCallback;
+    MatchFinder finder;
+    finder.addMatcher(functionDeclMatcher, &depthsCallback);
+
+    testMatcherOnCode(finder, "void m(int a) { if (a) { { a++; } } }");
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -33,6 +33,38 @@ public:
     }
 };
 
+class BoundedNPathCallback : public MatchFinder::MatchCallback
+{
+private:
+    int64_t _bound;
+    int64_t _nPath;
+    bool _stoppedEarly;
+
+public:
+    BoundedNPathCallback(int64_t bound, int64_t expectedNPath, bool expectedStoppedEarly)
+    {
+        _bound = bound;
+        _nPath = expectedNPath;
+        _stoppedEarly = expectedStoppedEarly;
+    }
+
+    virtual void run(const MatchFinder::MatchResult &results)
+    {
+        FunctionDecl *functionDecl = (FunctionDecl *)
+            results.Nodes.getNodeAs<FunctionDecl>("functionDecl");
+        if (functionDecl)
+        {
+            NPathComplexityMetric nPathMetric(_bound);
+            EXPECT_EQ(_nPath, nPathMetric.nPath(functionDecl->getBody()));
+            EXPECT_EQ(_stoppedEarly, nPathMetric.stoppedEarly());
+        }
+        else
+        {
+            FAIL();
+        }
+    }
+};
+
 TEST(NPathComplexityMetricTest, EmptyMethod)
 {
     NPathCallback nPathCallback(1);
@@ -312,6 +344,48 @@ TEST(NPathComplexityMetricTest, NastingConditionalOperator)
     testMatcherOnCode(finder, "void mthd() { if (1 ? (2 ? 3 : 4) : (5 ? 6 : 7)) {} }");
 }
 
+TEST(NPathComplexityMetricTest, BoundedEvaluationStopsOnceBoundIsExceeded)
+{
+    BoundedNPathCallback nPathCallback(3, 4, true);
+    MatchFinder finder;
+    finder.addMatcher(functionDeclMatcher, &nPathCallback);
+
+    testMatcherOnCode(finder, "void mthd() { if (1) {} if (1) {} if (1) {} while (1) {} }");
+}
+
+TEST(NPathComplexityMetricTest, BoundedEvaluationIsExactWithinBound)
+{
+    BoundedNPathCallback nPathCallback(8, 8, false);
+    MatchFinder finder;
+    finder.addMatcher(functionDeclMatcher, &nPathCallback);
+
+    testMatcherOnCode(finder, "void mthd() { if (1) {} if (1) {} if (1) {} }");
+}
+
+TEST(NPathComplexityMetricTest, BoundedEvaluationDoesNotSkipPossiblyZeroSwitch)
+{
+    BoundedNPathCallback nPathCallback(3, 0, false);
+    MatchFinder finder;
+    finder.addMatcher(functionDeclMatcher, &nPathCallback);
+
+    testMatcherOnCode(finder, "void mthd() { int i; if (1) {} if (1) {} if (1) {} switch (i) {} }");
+}
+
+TEST(NPathComplexityMetricTest, SaturatesInsteadOfOverflowing)
+{
+    BoundedNPathCallback saturatedCallback(std::numeric_limits<int64_t>::max(),
+        std::numeric_limits<int64_t>::max(), false);
+    MatchFinder finder;
+    finder.addMatcher(functionDeclMatcher, &saturatedCallback);
+
+    string code = "void mthd() {";
+    for (int index = 0; index < 70; index++)
+    {
+        code += " if (1) {}";
+    }
+    testMatcherOnCode(finder, code + " }");
+}
+
 int main(int argc, char **argv)
 {
     ::testing::InitGoogleMock(&argc, argv);
@@ -186,6 +186,35 @@ TEST(StmtDepthMetricTest, TwoCaseStatementsAndDefault)
     testMatcherOnCode(finder, "void m() { int i = 1; switch (i) { case 1: i = 2; break; case 2: break; default: break; } }");
 }
 
+class SharedDepthMapCallback : public MatchFinder::MatchCallback
+{
+public:
+    virtual void run(const MatchFinder::MatchResult &results)
+    {
+        FunctionDecl *functionDecl = (FunctionDecl *)
+            results.Nodes.getNodeAs<FunctionDecl>("functionDecl");
+        ASSERT_TRUE(functionDecl);
+        CompoundStmt *body = dyn_cast<CompoundStmt>(functionDecl->getBody());
+        CompoundStmt *innerBlock = dyn_cast<CompoundStmt>(*body->body_begin());
+
+        CompoundStmtDepthMap depths;
+        StmtDepthMetric stmtDepthMetric(&depths);
+        EXPECT_EQ(3, stmtDepthMetric.depth(body));
+        EXPECT_EQ(3u, depths.size());
+        EXPECT_EQ(2, depths[innerBlock]);
+        EXPECT_EQ(2, StmtDepthMetric(&depths).depth(innerBlock));
+    }
+};
+
+TEST(StmtDepthMetricTest, SharedDepthMapRecordsNestedBlocks)
+{
+    SharedDepthMapCallback depthCallback;
+    MatchFinder finder;
+    finder.addMatcher(functionDeclMatcher, &depthCallback);
+
+    testMatcherOnCode(finder, "void m() {{{}}}");
+}
+
 int main(int argc, char **argv)
 {
     ::testing::InitGoogleMock(&argc, argv);
@@ -0,0 +1,247 @@
+#include <dlfcn.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "oclint/Reporter.h"
+#include "oclint/Results.h"
+#include "oclint/RuleBase.h"
+#include "oclint/ViolationSet.h"
+
+using namespace oclint;
+
+/*
+ * Measures how fast each reporter formats a large report:
+ *
+ *     ReporterBenchmark [-n <violations>] reporters.dl/lib*Reporter.so ...
+ *
+ * The report goes to a stream that only counts bytes, so the numbers show the cost of
+ * formatting and escaping, not of the file system.
+ */
+
+namespace
+{
+
+class BenchmarkRule : public RuleBase
+{
+private:
+    std::string _name;
+    int _priority;
+
+public:
+    BenchmarkRule(std::string name, int priority) : _name(std::move(name)), _priority(priority)
+    {
+    }
+
+    virtual void apply() override
+    {
+    }
+
+    virtual const std::string name() const override
+    {
+        return _name;
+    }
+
+    virtual const std::string category() const override
+    {
+        return "benchmark";
+    }
+
+    virtual int priority() const override
+    {
+        return _priority;
+    }
+};
+
+class BenchmarkResults : public Results
+{
+private:
+    std::vector<Violation> _violations;
+    std::vector<Violation> _none;
+
+public:
+    explicit BenchmarkResults(std::vector<Violation> violations)
+        : _violations(std::move(violations))
+    {
+    }
+
+    virtual std::vector<Violation> allViolations() const override
+    {
+        return _violations;
+    }
+
+    virtual int numberOfViolations() const override
+    {
+        return _violations.size();
+    }
+
+    virtual int numberOfViolationsWithPriority(int priority) const override
+    {
+        int count = 0;
+        for (const auto &violation : _violations)
+        {
+            count += violation.rule->priority() == priority;
+        }
+        return count;
+    }
+
+    virtual int numberOfFiles() const override
+    {
+        return 2000;
+    }
+
+    virtual int numberOfFilesWithViolations() const override
+    {
+        return 2000;
+    }
+
+    virtual int numberOfErrors() const override
+    {
+        return 0;
+    }
+
+    virtual bool hasErrors() const override
+    {
+        return false;
+    }
+
+    virtual const std::vector<Violation>& allErrors() const override
+    {
+        return _none;
+    }
+
+    virtual int numberOfWarnings() const override
+    {
+        return 0;
+    }
+
+    virtual bool hasWarnings() const override
+    {
+        return false;
+    }
+
+    virtual const std::vector<Violation>& allWarnings() const override
+    {
+        return _none;
+    }
+
+    virtual int numberOfCheckerBugs() const override
+    {
+        return 0;
+    }
+
+    virtual bool hasCheckerBugs() const override
+    {
+        return false;
+    }
+
+    virtual const std::vector<Violation>& allCheckerBugs() const override
+    {
+        return _none;
+    }
+};
+
+class CountingBuffer : public std::streambuf
+{
+private:
+    size_t _count;
+
+protected:
+    virtual int_type overflow(int_type character) override
+    {
+        _count += character != traits_type::eof();
+        return traits_type::not_eof(character);
+    }
+
+    virtual std::streamsize xsputn(const char *, std::streamsize count) override
+    {
+        _count += count;
+        return count;
+    }
+
+public:
+    CountingBuffer() : _count(0)
+    {
+    }
+
+    size_t count() const
+    {
+        return _count;
+    }
+};
+
+std::vector<Violation> makeViolations(std::vector<std::unique_ptr<RuleBase>> &rules, int count)
+{
+    for (int index = 0; index < 20; index++)
+    {
+        rules.emplace_back(new BenchmarkRule("benchmark rule " + std::to_string(index),
+            index % 3 + 1));
+    }
+    std::vector<Violation> violations;
+    violations.reserve(count);
+    for (int index = 0; index < count; index++)
+    {
+        violations.push_back(Violation(rules[index % rules.size()].get(),
+            "/project/Sources/Module" + std::to_string(index % 50) +
+                "/File" + std::to_string(index % 2000) + ".m",
+            index % 3000 + 1, index % 80 + 1, index % 3000 + 3, index % 80 + 20,
+            "Method with a high cyclomatic complexity of " + std::to_string(index % 40 + 10) +
+                " exceeds the limit of \"10\" & should be split <see docs>"));
+    }
+    return violations;
+}
+
+} // end namespace
+
+int main(int argc, char **argv)
+{
+    int numberOfViolations = 400000;
+    int firstReporter = 1;
+    if (argc > 2 && std::string(argv[1]) == "-n")
+    {
+        numberOfViolations = atoi(argv[2]);
+        firstReporter = 3;
+    }
+    if (firstReporter >= argc)
+    {
+        std::cerr << "usage: " << argv[0] << " [-n <violations>] <reporter library>...\n";
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<RuleBase>> rules;
+    BenchmarkResults results(makeViolations(rules, numberOfViolations));
+
+    for (int index = firstReporter; index < argc; index++)
+    {
+        void *handle = dlopen(argv[index], RTLD_LAZY);
+        if (handle == nullptr)
+        {
+            std::cerr << dlerror() << "\n";
+            return 1;
+        }
+        auto create = (Reporter* (*)())dlsym(handle, "create");
+        if (create == nullptr)
+        {
+            std::cerr << argv[index] << " is not a reporter\n";
+            return 1;
+        }
+        std::unique_ptr<Reporter> reporter(create());
+
+        CountingBuffer buffer;
+        std::ostream out(&buffer);
+        auto start = std::chrono::steady_clock::now();
+        reporter->report(&results, out);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        double megabytes = buffer.count() / (1024.0 * 1024.0);
+        std::cout << reporter->name() << ": " << numberOfViolations << " violations, "
+            << megabytes << " MB in " << elapsed.count() << " s, "
+            << megabytes / elapsed.count() << " MB/s\n";
+    }
+    return 0;
+}
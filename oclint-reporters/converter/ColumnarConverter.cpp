@@ -0,0 +1,255 @@
+#include <dirent.h>
+#include <dlfcn.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "oclint/ColumnarResults.h"
+#include "oclint/Reporter.h"
+#include "oclint/Results.h"
+#include "oclint/RuleBase.h"
+#include "oclint/Violation.h"
+
+using namespace oclint;
+
+/*
+ * Turns a columnar results file back into any other report type:
+ *
+ *     oclint-convert <results file> <report type> [<reporter directory>]
+ *
+ * The reporters are loaded the same way the driver loads them, by default from
+ * lib/oclint/reporters of the installation.
+ */
+
+namespace
+{
+
+class ConvertedRule : public RuleBase
+{
+private:
+    std::string _name;
+    std::string _category;
+    int _priority;
+
+public:
+    ConvertedRule(std::string name, std::string category, int priority)
+        : _name(std::move(name)), _category(std::move(category)), _priority(priority)
+    {
+    }
+
+    virtual void apply() override
+    {
+    }
+
+    virtual const std::string name() const override
+    {
+        return _name;
+    }
+
+    virtual const std::string category() const override
+    {
+        return _category;
+    }
+
+    virtual int priority() const override
+    {
+        return _priority;
+    }
+};
+
+class ConvertedResults : public Results
+{
+private:
+    std::vector<std::unique_ptr<ConvertedRule>> _rules;
+    std::vector<Violation> _records[columnar::CHECKER_BUG + 1];
+    int _priorities[3];
+    int _numberOfFiles;
+    int _numberOfFilesWithViolations;
+    bool _truncated;
+
+public:
+    explicit ConvertedResults(const ColumnarResultsReader &reader)
+        : _priorities{0, 0, 0},
+        _numberOfFiles(reader.numberOfAnalyzedFiles()),
+        _numberOfFilesWithViolations(reader.numberOfFilesWithViolations()),
+        _truncated(reader.isTruncated())
+    {
+        for (uint32_t index = 0; index < reader.numberOfRules(); index++)
+        {
+            const columnar::Rule &rule = reader.rule(index);
+            _rules.emplace_back(new ConvertedRule(reader.string(rule.name),
+                reader.string(rule.category), rule.priority));
+        }
+        const uint32_t *rules = reader.column(columnar::RULE_COLUMN);
+        const uint32_t *files = reader.column(columnar::FILE_COLUMN);
+        const uint32_t *startLines = reader.column(columnar::START_LINE_COLUMN);
+        const uint32_t *startColumns = reader.column(columnar::START_COLUMN_COLUMN);
+        const uint32_t *endLines = reader.column(columnar::END_LINE_COLUMN);
+        const uint32_t *endColumns = reader.column(columnar::END_COLUMN_COLUMN);
+        const uint32_t *messages = reader.column(columnar::MESSAGE_COLUMN);
+        for (uint32_t index = 0; index < reader.numberOfRecords(); index++)
+        {
+            uint8_t priority = reader.priorities()[index];
+            if (reader.kinds()[index] == columnar::VIOLATION && priority >= 1 && priority <= 3)
+            {
+                _priorities[priority - 1]++;
+            }
+            RuleBase *rule = rules[index] == columnar::noRule ?
+                nullptr : _rules[rules[index]].get();
+            _records[reader.kinds()[index]].push_back(Violation(rule,
+                reader.string(reader.file(files[index]).path),
+                startLines[index], startColumns[index], endLines[index], endColumns[index],
+                reader.string(messages[index])));
+        }
+    }
+
+    virtual std::vector<Violation> allViolations() const override
+    {
+        return _records[columnar::VIOLATION];
+    }
+
+    virtual int numberOfViolations() const override
+    {
+        return _records[columnar::VIOLATION].size();
+    }
+
+    virtual int numberOfViolationsWithPriority(int priority) const override
+    {
+        return priority >= 1 && priority <= 3 ? _priorities[priority - 1] : 0;
+    }
+
+    virtual int numberOfFiles() const override
+    {
+        return _numberOfFiles;
+    }
+
+    virtual int numberOfFilesWithViolations() const override
+    {
+        return _numberOfFilesWithViolations;
+    }
+
+    virtual int numberOfErrors() const override
+    {
+        return _records[columnar::COMPILER_ERROR].size();
+    }
+
+    virtual bool hasErrors() const override
+    {
+        return numberOfErrors() > 0;
+    }
+
+    virtual const std::vector<Violation>& allErrors() const override
+    {
+        return _records[columnar::COMPILER_ERROR];
+    }
+
+    virtual int numberOfWarnings() const override
+    {
+        return _records[columnar::COMPILER_WARNING].size();
+    }
+
+    virtual bool hasWarnings() const override
+    {
+        return numberOfWarnings() > 0;
+    }
+
+    virtual const std::vector<Violation>& allWarnings() const override
+    {
+        return _records[columnar::COMPILER_WARNING];
+    }
+
+    virtual int numberOfCheckerBugs() const override
+    {
+        return _records[columnar::CHECKER_BUG].size();
+    }
+
+    virtual bool hasCheckerBugs() const override
+    {
+        return numberOfCheckerBugs() > 0;
+    }
+
+    virtual const std::vector<Violation>& allCheckerBugs() const override
+    {
+        return _records[columnar::CHECKER_BUG];
+    }
+
+    virtual bool isTruncated() const override
+    {
+        return _truncated;
+    }
+};
+
+std::string defaultReporterDirectory(const std::string &executable)
+{
+    std::string::size_type separator = executable.rfind('/');
+    std::string binDirectory = separator == std::string::npos ?
+        "." : executable.substr(0, separator);
+    return binDirectory + "/../lib/oclint/reporters";
+}
+
+Reporter *loadReporter(const std::string &directory, const std::string &reportType)
+{
+    DIR *reporterDirectory = opendir(directory.c_str());
+    if (reporterDirectory == nullptr)
+    {
+        return nullptr;
+    }
+    Reporter *selected = nullptr;
+    struct dirent *entry;
+    while (selected == nullptr && (entry = readdir(reporterDirectory)))
+    {
+        if (entry->d_name[0] == '.')
+        {
+            continue;
+        }
+        std::string path = directory + "/" + entry->d_name;
+        void *handle = dlopen(path.c_str(), RTLD_LAZY);
+        auto create = handle ? (Reporter* (*)())dlsym(handle, "create") : nullptr;
+        if (create == nullptr)
+        {
+            continue;
+        }
+        Reporter *reporter = create();
+        if (reporter->name() == reportType)
+        {
+            selected = reporter;
+        }
+        else
+        {
+            delete reporter;
+        }
+    }
+    closedir(reporterDirectory);
+    return selected;
+}
+
+} // end namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 3 || argc > 4)
+    {
+        std::cerr << "usage: " << argv[0]
+            << " <results file> <report type> [<reporter directory>]\n";
+        return 1;
+    }
+    ColumnarResultsReader reader;
+    if (!reader.open(argv[1]))
+    {
+        std::cerr << "oclint-convert: error: " << argv[1] << " is not a columnar results file\n";
+        return 1;
+    }
+    std::string reporterDirectory = argc == 4 ? argv[3] : defaultReporterDirectory(argv[0]);
+    std::unique_ptr<Reporter> reporter(loadReporter(reporterDirectory, argv[2]));
+    if (!reporter)
+    {
+        std::cerr << "oclint-convert: error: cannot find dynamic library for report type: "
+            << argv[2] << "\n";
+        return 1;
+    }
+    ConvertedResults results(reader);
+    reporter->report(&results, std::cout);
+    return 0;
+}
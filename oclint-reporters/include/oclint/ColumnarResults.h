@@ -0,0 +1,137 @@
+#ifndef OCLINT_COLUMNARRESULTS_H
+#define OCLINT_COLUMNARRESULTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace oclint
+{
+
+class Results;
+class ReportWriter;
+
+/*
+ * A compact binary form of the results, for tools that read them again and again.
+ *
+ * After a fixed header come, all little-endian and four-byte aligned:
+ *   - the string table, an offset for every string and one past the end
+ *   - the rule table, name, category and priority of every rule
+ *   - the file table, path, first record and number of records of every file
+ *   - one column per record field, records are grouped by file
+ *   - the bytes of the strings, each one followed by a NUL
+ *
+ * The layout is meant to be used in place, e.g. from a memory-mapped file.
+ */
+namespace columnar
+{
+    enum RecordKind
+    {
+        VIOLATION,
+        COMPILER_ERROR,
+        COMPILER_WARNING,
+        CHECKER_BUG
+    };
+
+    enum Column
+    {
+        FILE_COLUMN,
+        RULE_COLUMN,
+        START_LINE_COLUMN,
+        START_COLUMN_COLUMN,
+        END_LINE_COLUMN,
+        END_COLUMN_COLUMN,
+        MESSAGE_COLUMN,
+        NUMBER_OF_COLUMNS
+    };
+
+    /* bits of the header flags */
+    enum Flag
+    {
+        TRUNCATED = 1
+    };
+
+    /* the rule of compiler diagnostics and checker bugs */
+    const uint32_t noRule = UINT32_MAX;
+
+    struct Rule
+    {
+        uint32_t name;
+        uint32_t category;
+        uint32_t priority;
+    };
+
+    struct File
+    {
+        uint32_t path;
+        uint32_t firstRecord;
+        uint32_t numberOfRecords;
+    };
+
+    /* writes the violations, compiler diagnostics and checker bugs of the results */
+    void write(Results &results, ReportWriter &out);
+} // end namespace columnar
+
+class ColumnarResultsReader
+{
+private:
+    const char *_data;
+    size_t _size;
+    void *_mapping;
+    size_t _mappingSize;
+
+    uint32_t _numberOfStrings;
+    uint32_t _numberOfRules;
+    uint32_t _numberOfFiles;
+    uint32_t _numberOfRecords;
+    uint32_t _numberOfAnalyzedFiles;
+    uint32_t _numberOfFilesWithViolations;
+    uint32_t _flags;
+
+    const uint32_t *_stringOffsets;
+    const columnar::Rule *_rules;
+    const columnar::File *_files;
+    const uint32_t *_columns[columnar::NUMBER_OF_COLUMNS];
+    const uint8_t *_priorities;
+    const uint8_t *_kinds;
+    const char *_strings;
+
+    void unmap();
+
+public:
+    ColumnarResultsReader();
+    ColumnarResultsReader(const ColumnarResultsReader &) = delete;
+    ColumnarResultsReader &operator=(const ColumnarResultsReader &) = delete;
+    ~ColumnarResultsReader();
+
+    /* maps the file, false when it cannot be read or is not valid */
+    bool open(const std::string &path);
+    /* validates the data, which must stay alive and four-byte aligned while it is read */
+    bool parse(const char *data, size_t size);
+
+    uint32_t numberOfStrings() const { return _numberOfStrings; }
+    uint32_t numberOfRules() const { return _numberOfRules; }
+    uint32_t numberOfFiles() const { return _numberOfFiles; }
+    uint32_t numberOfRecords() const { return _numberOfRecords; }
+    uint32_t numberOfAnalyzedFiles() const { return _numberOfAnalyzedFiles; }
+    uint32_t numberOfFilesWithViolations() const { return _numberOfFilesWithViolations; }
+    bool isTruncated() const { return _flags & columnar::TRUNCATED; }
+
+    const char *string(uint32_t index) const { return _strings + _stringOffsets[index]; }
+    size_t stringLength(uint32_t index) const
+    {
+        return _stringOffsets[index + 1] - _stringOffsets[index] - 1;
+    }
+
+    const columnar::Rule &rule(uint32_t index) const { return _rules[index]; }
+    const columnar::File &file(uint32_t index) const { return _files[index]; }
+
+    /* numberOfRecords() values, indexed by record */
+    const uint32_t *column(columnar::Column column) const { return _columns[column]; }
+    const uint8_t *priorities() const { return _priorities; }
+    const uint8_t *kinds() const { return _kinds; }
+};
+
+} // end namespace oclint
+
+#endif
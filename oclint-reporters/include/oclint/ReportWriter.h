@@ -0,0 +1,89 @@
+#ifndef OCLINT_REPORTWRITER_H
+#define OCLINT_REPORTWRITER_H
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+namespace oclint
+{
+
+class RuleBase;
+
+/*
+ * Collects report output in a large buffer and hands it to the stream in big blocks,
+ * so reporters never flush line by line. Escaped text is scanned a machine word at a
+ * time, and the runs between characters that need escaping are copied in bulk.
+ */
+class ReportWriter
+{
+public:
+    enum Escaping
+    {
+        XML, // also used for HTML
+        JSON
+    };
+
+    static const size_t defaultCapacity = 1 << 20;
+
+private:
+    std::ostream &_out;
+    std::unique_ptr<char[]> _buffer;
+    size_t _capacity;
+    size_t _size;
+
+    void writeUnsigned(unsigned long long value, bool negative);
+
+public:
+    explicit ReportWriter(std::ostream &out, size_t capacity = defaultCapacity);
+    ReportWriter(const ReportWriter &) = delete;
+    ReportWriter &operator=(const ReportWriter &) = delete;
+    virtual ~ReportWriter();
+
+    static std::string escape(const std::string &text, Escaping escaping);
+
+    ReportWriter &write(const char *data, size_t size);
+    ReportWriter &escaped(const std::string &text, Escaping escaping);
+
+    ReportWriter &operator<<(const std::string &text);
+    ReportWriter &operator<<(const char *text);
+    ReportWriter &operator<<(char character);
+    ReportWriter &operator<<(int value);
+    ReportWriter &operator<<(long value);
+    ReportWriter &operator<<(long long value);
+    ReportWriter &operator<<(unsigned value);
+    ReportWriter &operator<<(unsigned long value);
+    ReportWriter &operator<<(unsigned long long value);
+    ReportWriter &operator<<(double value);
+
+    /* hands the buffered output to the stream, without flushing the stream itself */
+    void flush();
+};
+
+/*
+ * Report fragments that only depend on the rule, e.g. its name, category and priority
+ * already formatted and escaped, composed once per rule instead of once per violation.
+ */
+class RuleFragments
+{
+private:
+    std::unordered_map<const RuleBase *, std::string> _fragments;
+
+public:
+    template <typename Compose>
+    const std::string &get(const RuleBase *rule, Compose compose)
+    {
+        auto fragment = _fragments.find(rule);
+        if (fragment == _fragments.end())
+        {
+            fragment = _fragments.emplace(rule, compose(rule)).first;
+        }
+        return fragment->second;
+    }
+};
+
+} // end namespace oclint
+
+#endif
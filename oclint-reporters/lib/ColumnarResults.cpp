@@ -0,0 +1,368 @@
+#include "oclint/ColumnarResults.h"
+
+#include <cstring>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "oclint/ReportWriter.h"
+#include "oclint/Results.h"
+#include "oclint/RuleBase.h"
+#include "oclint/Violation.h"
+
+using namespace oclint;
+using namespace oclint::columnar;
+
+static const char columnarMagic[] = "OCLINTCR";
+static const uint32_t columnarVersion = 1;
+/* reads back as this value only on hosts with the byte order of the file */
+static const uint32_t byteOrderMark = 0x01020304;
+static const size_t headerSize = 48;
+
+namespace
+{
+
+class StringTable
+{
+private:
+    std::unordered_map<std::string, uint32_t> _indices;
+    std::vector<const std::string *> _strings;
+
+public:
+    uint32_t add(const std::string &text)
+    {
+        auto index = _indices.find(text);
+        if (index == _indices.end())
+        {
+            index = _indices.emplace(text, _strings.size()).first;
+            _strings.push_back(&index->first);
+        }
+        return index->second;
+    }
+
+    const std::vector<const std::string *> &strings() const
+    {
+        return _strings;
+    }
+};
+
+struct PendingRecord
+{
+    const Violation *violation;
+    RecordKind kind;
+};
+
+void writeU32(ReportWriter &out, uint32_t value)
+{
+    char bytes[4] = {
+        char(value & 0xff), char((value >> 8) & 0xff),
+        char((value >> 16) & 0xff), char((value >> 24) & 0xff)
+    };
+    out.write(bytes, sizeof(bytes));
+}
+
+void writePadding(ReportWriter &out, size_t size)
+{
+    static const char zeros[4] = {0, 0, 0, 0};
+    out.write(zeros, (4 - size % 4) % 4);
+}
+
+} // end namespace
+
+void columnar::write(Results &results, ReportWriter &out)
+{
+    std::vector<Violation> violations = results.allViolations();
+    std::map<std::string, std::vector<PendingRecord>> recordsByPath;
+    auto addRecords = [&recordsByPath](const std::vector<Violation> &source, RecordKind kind)
+    {
+        for (const auto& violation : source)
+        {
+            recordsByPath[violation.path].push_back(PendingRecord{&violation, kind});
+        }
+    };
+    addRecords(violations, VIOLATION);
+    addRecords(results.allErrors(), COMPILER_ERROR);
+    addRecords(results.allWarnings(), COMPILER_WARNING);
+    addRecords(results.allCheckerBugs(), CHECKER_BUG);
+
+    StringTable strings;
+    std::unordered_map<const RuleBase *, uint32_t> ruleIndices;
+    std::vector<Rule> rules;
+    std::vector<File> files;
+    std::vector<uint32_t> columns[NUMBER_OF_COLUMNS];
+    std::vector<uint8_t> priorities;
+    std::vector<uint8_t> kinds;
+    for (const auto& pathRecords : recordsByPath)
+    {
+        uint32_t fileIndex = files.size();
+        files.push_back(File{strings.add(pathRecords.first),
+            static_cast<uint32_t>(columns[FILE_COLUMN].size()),
+            static_cast<uint32_t>(pathRecords.second.size())});
+        for (const auto& record : pathRecords.second)
+        {
+            const Violation &violation = *record.violation;
+            uint32_t ruleIndex = noRule;
+            if (violation.rule)
+            {
+                auto index = ruleIndices.find(violation.rule);
+                if (index == ruleIndices.end())
+                {
+                    index = ruleIndices.emplace(violation.rule, rules.size()).first;
+                    rules.push_back(Rule{strings.add(violation.rule->name()),
+                        strings.add(violation.rule->category()),
+                        static_cast<uint32_t>(violation.rule->priority())});
+                }
+                ruleIndex = index->second;
+            }
+            columns[FILE_COLUMN].push_back(fileIndex);
+            columns[RULE_COLUMN].push_back(ruleIndex);
+            columns[START_LINE_COLUMN].push_back(violation.startLine);
+            columns[START_COLUMN_COLUMN].push_back(violation.startColumn);
+            columns[END_LINE_COLUMN].push_back(violation.endLine);
+            columns[END_COLUMN_COLUMN].push_back(violation.endColumn);
+            columns[MESSAGE_COLUMN].push_back(strings.add(violation.message));
+            priorities.push_back(ruleIndex == noRule ? 0 : rules[ruleIndex].priority);
+            kinds.push_back(record.kind);
+        }
+    }
+
+    uint32_t stringDataSize = 0;
+    for (const auto& text : strings.strings())
+    {
+        stringDataSize += text->size() + 1;
+    }
+
+    out.write(columnarMagic, 8);
+    writeU32(out, columnarVersion);
+    writeU32(out, byteOrderMark);
+    writeU32(out, strings.strings().size());
+    writeU32(out, rules.size());
+    writeU32(out, files.size());
+    writeU32(out, kinds.size());
+    writeU32(out, results.numberOfFiles());
+    writeU32(out, results.numberOfFilesWithViolations());
+    writeU32(out, stringDataSize);
+    writeU32(out, results.isTruncated() ? TRUNCATED : 0);
+
+    uint32_t offset = 0;
+    for (const auto& text : strings.strings())
+    {
+        writeU32(out, offset);
+        offset += text->size() + 1;
+    }
+    writeU32(out, offset);
+    for (const auto& rule : rules)
+    {
+        writeU32(out, rule.name);
+        writeU32(out, rule.category);
+        writeU32(out, rule.priority);
+    }
+    for (const auto& file : files)
+    {
+        writeU32(out, file.path);
+        writeU32(out, file.firstRecord);
+        writeU32(out, file.numberOfRecords);
+    }
+    for (const auto& column : columns)
+    {
+        for (uint32_t value : column)
+        {
+            writeU32(out, value);
+        }
+    }
+    out.write(reinterpret_cast<const char *>(priorities.data()), priorities.size());
+    out.write(reinterpret_cast<const char *>(kinds.data()), kinds.size());
+    writePadding(out, 2 * kinds.size());
+    for (const auto& text : strings.strings())
+    {
+        out.write(text->c_str(), text->size() + 1);
+    }
+}
+
+ColumnarResultsReader::ColumnarResultsReader()
+    : _data(nullptr), _size(0), _mapping(nullptr), _mappingSize(0),
+    _numberOfStrings(0), _numberOfRules(0), _numberOfFiles(0), _numberOfRecords(0),
+    _numberOfAnalyzedFiles(0), _numberOfFilesWithViolations(0), _flags(0),
+    _stringOffsets(nullptr), _rules(nullptr), _files(nullptr),
+    _priorities(nullptr), _kinds(nullptr), _strings(nullptr)
+{
+    memset(_columns, 0, sizeof(_columns));
+}
+
+ColumnarResultsReader::~ColumnarResultsReader()
+{
+    unmap();
+}
+
+void ColumnarResultsReader::unmap()
+{
+#ifdef _WIN32
+    delete[] static_cast<char *>(_mapping);
+#else
+    if (_mapping)
+    {
+        munmap(_mapping, _mappingSize);
+    }
+#endif
+    _mapping = nullptr;
+    _mappingSize = 0;
+    _numberOfStrings = _numberOfRules = _numberOfFiles = _numberOfRecords = 0;
+    _numberOfAnalyzedFiles = _numberOfFilesWithViolations = _flags = 0;
+}
+
+bool ColumnarResultsReader::open(const std::string &path)
+{
+    unmap();
+#ifdef _WIN32
+    std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    _mappingSize = file.tellg();
+    _mapping = new char[_mappingSize];
+    file.seekg(0);
+    if (!file.read(static_cast<char *>(_mapping), _mappingSize))
+    {
+        unmap();
+        return false;
+    }
+#else
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+        return false;
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || status.st_size == 0)
+    {
+        close(descriptor);
+        return false;
+    }
+    void *mapping = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+    _mapping = mapping;
+    _mappingSize = status.st_size;
+#endif
+    return parse(static_cast<const char *>(_mapping), _mappingSize);
+}
+
+bool ColumnarResultsReader::parse(const char *data, size_t size)
+{
+    uint32_t header[10];
+    if (size < headerSize || memcmp(data, columnarMagic, 8) != 0)
+    {
+        return false;
+    }
+    memcpy(header, data + 8, sizeof(header));
+    if (header[0] != columnarVersion || header[1] != byteOrderMark)
+    {
+        return false;
+    }
+    uint64_t numberOfStrings = header[2];
+    uint64_t numberOfRules = header[3];
+    uint64_t numberOfFiles = header[4];
+    uint64_t numberOfRecords = header[5];
+    uint64_t stringDataSize = header[8];
+    uint64_t expectedSize = headerSize + 4 * (numberOfStrings + 1) +
+        12 * numberOfRules + 12 * numberOfFiles + 4 * NUMBER_OF_COLUMNS * numberOfRecords +
+        (2 * numberOfRecords + 3) / 4 * 4 + stringDataSize;
+    if (expectedSize != size)
+    {
+        return false;
+    }
+
+    const char *position = data + headerSize;
+    const uint32_t *stringOffsets = reinterpret_cast<const uint32_t *>(position);
+    position += 4 * (numberOfStrings + 1);
+    const Rule *rules = reinterpret_cast<const Rule *>(position);
+    position += 12 * numberOfRules;
+    const File *files = reinterpret_cast<const File *>(position);
+    position += 12 * numberOfFiles;
+    const uint32_t *columns[NUMBER_OF_COLUMNS];
+    for (int column = 0; column < NUMBER_OF_COLUMNS; column++)
+    {
+        columns[column] = reinterpret_cast<const uint32_t *>(position);
+        position += 4 * numberOfRecords;
+    }
+    const uint8_t *priorities = reinterpret_cast<const uint8_t *>(position);
+    const uint8_t *kinds = priorities + numberOfRecords;
+    position += (2 * numberOfRecords + 3) / 4 * 4;
+    const char *strings = position;
+
+    // everything is checked once, so readers can index without bounds checks
+    if (stringOffsets[0] != 0 || stringOffsets[numberOfStrings] != stringDataSize)
+    {
+        return false;
+    }
+    for (uint64_t index = 0; index < numberOfStrings; index++)
+    {
+        if (stringOffsets[index + 1] <= stringOffsets[index] ||
+            strings[stringOffsets[index + 1] - 1] != '\0')
+        {
+            return false;
+        }
+    }
+    for (uint64_t index = 0; index < numberOfRules; index++)
+    {
+        if (rules[index].name >= numberOfStrings || rules[index].category >= numberOfStrings)
+        {
+            return false;
+        }
+    }
+    uint64_t nextRecord = 0;
+    for (uint64_t index = 0; index < numberOfFiles; index++)
+    {
+        if (files[index].path >= numberOfStrings || files[index].firstRecord != nextRecord)
+        {
+            return false;
+        }
+        nextRecord += files[index].numberOfRecords;
+    }
+    if (nextRecord != numberOfRecords)
+    {
+        return false;
+    }
+    for (uint64_t index = 0; index < numberOfRecords; index++)
+    {
+        uint32_t rule = columns[RULE_COLUMN][index];
+        if (columns[FILE_COLUMN][index] >= numberOfFiles ||
+            (rule != noRule && rule >= numberOfRules) ||
+            columns[MESSAGE_COLUMN][index] >= numberOfStrings ||
+            kinds[index] > CHECKER_BUG)
+        {
+            return false;
+        }
+    }
+
+    _data = data;
+    _size = size;
+    _numberOfStrings = numberOfStrings;
+    _numberOfRules = numberOfRules;
+    _numberOfFiles = numberOfFiles;
+    _numberOfRecords = numberOfRecords;
+    _numberOfAnalyzedFiles = header[6];
+    _numberOfFilesWithViolations = header[7];
+    _flags = header[9];
+    _stringOffsets = stringOffsets;
+    _rules = rules;
+    _files = files;
+    memcpy(_columns, columns, sizeof(_columns));
+    _priorities = priorities;
+    _kinds = kinds;
+    _strings = strings;
+    return true;
+}
@@ -0,0 +1,259 @@
+#include "oclint/ReportWriter.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+using namespace oclint;
+
+namespace
+{
+
+const uint64_t lowBits = 0x0101010101010101ULL;
+const uint64_t highBits = 0x8080808080808080ULL;
+
+/* nonzero when any byte of the word is below the limit, which must not exceed 0x80 */
+inline uint64_t anyByteBelow(uint64_t word, unsigned char limit)
+{
+    return (word - lowBits * limit) & ~word & highBits;
+}
+
+inline uint64_t anyByteEquals(uint64_t word, unsigned char character)
+{
+    return anyByteBelow(word ^ (lowBits * character), 1);
+}
+
+inline bool wordNeedsEscaping(uint64_t word, ReportWriter::Escaping escaping)
+{
+    if (escaping == ReportWriter::JSON)
+    {
+        return (anyByteEquals(word, '"') | anyByteEquals(word, '\\') | anyByteBelow(word, 0x20));
+    }
+    return (anyByteEquals(word, '&') | anyByteEquals(word, '<') | anyByteEquals(word, '>') |
+        anyByteEquals(word, '"') | anyByteEquals(word, '\''));
+}
+
+inline bool needsEscaping(unsigned char character, ReportWriter::Escaping escaping)
+{
+    if (escaping == ReportWriter::JSON)
+    {
+        return character == '"' || character == '\\' || character < 0x20;
+    }
+    return character == '&' || character == '<' || character == '>' ||
+        character == '"' || character == '\'';
+}
+
+/* length of the leading run of characters that are written as they are */
+size_t plainLength(const char *data, size_t size, ReportWriter::Escaping escaping)
+{
+    size_t length = 0;
+    while (length + sizeof(uint64_t) <= size)
+    {
+        uint64_t word;
+        memcpy(&word, data + length, sizeof(word));
+        if (wordNeedsEscaping(word, escaping))
+        {
+            break;
+        }
+        length += sizeof(word);
+    }
+    while (length < size && !needsEscaping(data[length], escaping))
+    {
+        length++;
+    }
+    return length;
+}
+
+/* writes the escape sequence of one character into replacement, and returns its length */
+size_t replacementOf(unsigned char character, ReportWriter::Escaping escaping, char *replacement)
+{
+    const char *sequence = nullptr;
+    if (escaping == ReportWriter::JSON)
+    {
+        switch (character)
+        {
+            case '"': sequence = "\\\""; break;
+            case '\\': sequence = "\\\\"; break;
+            case '\n': sequence = "\\n"; break;
+            case '\r': sequence = "\\r"; break;
+            case '\t': sequence = "\\t"; break;
+            case '\b': sequence = "\\b"; break;
+            case '\f': sequence = "\\f"; break;
+            default:
+            {
+                static const char hexDigits[] = "0123456789abcdef";
+                memcpy(replacement, "\\u00", 4);
+                replacement[4] = hexDigits[character >> 4];
+                replacement[5] = hexDigits[character & 0xf];
+                return 6;
+            }
+        }
+    }
+    else
+    {
+        switch (character)
+        {
+            case '&': sequence = "&amp;"; break;
+            case '<': sequence = "&lt;"; break;
+            case '>': sequence = "&gt;"; break;
+            case '"': sequence = "&quot;"; break;
+            default: sequence = "&#39;"; break;
+        }
+    }
+    size_t length = strlen(sequence);
+    memcpy(replacement, sequence, length);
+    return length;
+}
+
+} // end namespace
+
+ReportWriter::ReportWriter(std::ostream &out, size_t capacity)
+    : _out(out), _buffer(new char[capacity]), _capacity(capacity), _size(0)
+{
+}
+
+ReportWriter::~ReportWriter()
+{
+    flush();
+}
+
+std::string ReportWriter::escape(const std::string &text, Escaping escaping)
+{
+    std::string output;
+    output.reserve(text.size());
+    const char *data = text.data();
+    size_t size = text.size();
+    while (size > 0)
+    {
+        size_t length = plainLength(data, size, escaping);
+        output.append(data, length);
+        if (length == size)
+        {
+            break;
+        }
+        char replacement[8];
+        output.append(replacement, replacementOf(data[length], escaping, replacement));
+        data += length + 1;
+        size -= length + 1;
+    }
+    return output;
+}
+
+ReportWriter &ReportWriter::write(const char *data, size_t size)
+{
+    if (size > _capacity - _size)
+    {
+        flush();
+        if (size >= _capacity)
+        {
+            _out.write(data, size);
+            return *this;
+        }
+    }
+    memcpy(_buffer.get() + _size, data, size);
+    _size += size;
+    return *this;
+}
+
+ReportWriter &ReportWriter::escaped(const std::string &text, Escaping escaping)
+{
+    const char *data = text.data();
+    size_t size = text.size();
+    while (size > 0)
+    {
+        size_t length = plainLength(data, size, escaping);
+        write(data, length);
+        if (length == size)
+        {
+            break;
+        }
+        char replacement[8];
+        write(replacement, replacementOf(data[length], escaping, replacement));
+        data += length + 1;
+        size -= length + 1;
+    }
+    return *this;
+}
+
+ReportWriter &ReportWriter::operator<<(const std::string &text)
+{
+    return write(text.data(), text.size());
+}
+
+ReportWriter &ReportWriter::operator<<(const char *text)
+{
+    return write(text, strlen(text));
+}
+
+ReportWriter &ReportWriter::operator<<(char character)
+{
+    return write(&character, 1);
+}
+
+void ReportWriter::writeUnsigned(unsigned long long value, bool negative)
+{
+    char digits[24];
+    char *start = digits + sizeof(digits);
+    do
+    {
+        *--start = char('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    if (negative)
+    {
+        *--start = '-';
+    }
+    write(start, digits + sizeof(digits) - start);
+}
+
+ReportWriter &ReportWriter::operator<<(int value)
+{
+    return *this << static_cast<long long>(value);
+}
+
+ReportWriter &ReportWriter::operator<<(long value)
+{
+    return *this << static_cast<long long>(value);
+}
+
+ReportWriter &ReportWriter::operator<<(long long value)
+{
+    // negate in unsigned arithmetic, so the smallest value does not overflow
+    unsigned long long magnitude = value < 0 ?
+        0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+    writeUnsigned(magnitude, value < 0);
+    return *this;
+}
+
+ReportWriter &ReportWriter::operator<<(unsigned value)
+{
+    return *this << static_cast<unsigned long long>(value);
+}
+
+ReportWriter &ReportWriter::operator<<(unsigned long value)
+{
+    return *this << static_cast<unsigned long long>(value);
+}
+
+ReportWriter &ReportWriter::operator<<(unsigned long long value)
+{
+    writeUnsigned(value, false);
+    return *this;
+}
+
+ReportWriter &ReportWriter::operator<<(double value)
+{
+    // the same as the default formatting of std::ostream
+    char digits[32];
+    int length = snprintf(digits, sizeof(digits), "%g", value);
+    return write(digits, length);
+}
+
+void ReportWriter::flush()
+{
+    if (_size > 0)
+    {
+        _out.write(_buffer.get(), _size);
+        _size = 0;
+    }
+}
@@ -0,0 +1,28 @@
+#include "oclint/ColumnarResults.h"
+#include "oclint/Results.h"
+#include "oclint/ReportWriter.h"
+#include "oclint/Reporter.h"
+
+using namespace oclint;
+
+class ColumnarReporter : public Reporter
+{
+public:
+    virtual const std::string name() const override
+    {
+        return "columnar";
+    }
+
+    virtual void report(Results* results, std::ostream& out) override
+    {
+        ReportWriter writer(out);
+        columnar::write(*results, writer);
+        writer.flush();
+        out.flush();
+    }
+};
+
+extern "C" Reporter* create()
+{
+    return new ColumnarReporter();
+}
@@ -1,6 +1,14 @@
+#include <algorithm>
+#include <atomic>
 #include <ctime>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
 
 #include "oclint/Results.h"
+#include "oclint/ReportWriter.h"
 #include "oclint/Reporter.h"
 #include "oclint/RuleBase.h"
 #include "oclint/Version.h"
@@ -10,6 +18,68 @@ using namespace oclint;
 
 class HTMLReporter : public Reporter
 {
+public:
+    enum RowKind
+    {
+        VIOLATION,
+        COMPILER_ERROR,
+        COMPILER_WARNING,
+        CHECKER_BUG,
+        NUMBER_OF_ROW_KINDS
+    };
+
+    struct Row
+    {
+        const Violation *violation;
+        RowKind kind;
+    };
+
+    /* all rows of one source file, and how many of them there are of each kind */
+    struct FileRows
+    {
+        std::string path;
+        std::vector<Row> rows;
+        int priorities[3] = {0, 0, 0};
+        int kinds[NUMBER_OF_ROW_KINDS] = {0, 0, 0, 0};
+    };
+
+    struct Page
+    {
+        size_t fileIndex;
+        size_t part;
+        size_t numberOfParts;
+        size_t firstRow;
+        size_t lastRow;
+    };
+
+    /* keeps every page small enough for a browser to render it at once */
+    static const size_t rowsPerPage = 2000;
+
+private:
+    RuleFragments _ruleCells;
+
+    static std::string ruleCells(const RuleBase *rule)
+    {
+        std::string priority = std::to_string(rule->priority());
+        return "<td>" + ReportWriter::escape(rule->name(), ReportWriter::XML) + "</td>" +
+            "<td>" + ReportWriter::escape(rule->category(), ReportWriter::XML) + "</td>" +
+            "<td class='priority" + priority + "'>" + priority + "</td>";
+    }
+
+    void writeLocationCells(ReportWriter &out, const Violation &violation)
+    {
+        out << "<tr><td>";
+        out.escaped(violation.path, ReportWriter::XML);
+        out << "</td><td>" << violation.startLine << ":" << violation.startColumn << "</td>";
+    }
+
+    void writeMessageCell(ReportWriter &out, const Violation &violation)
+    {
+        out << "<td>";
+        out.escaped(violation.message, ReportWriter::XML);
+        out << "</td></tr>";
+    }
+
 public:
     virtual const std::string name() const override
     {
@@ -18,72 +88,330 @@ public:
 
     virtual void report(Results* results, std::ostream& out) override
     {
-        out << "<!DOCTYPE html>";
-        out << "<html>";
-        writeHead(out);
-        out << "<body>";
-        out << "<h1>OCLint Report</h1>";
-        out << "<hr />";
-        out << "<h2>Summary</h2>";
-        writeSummaryTable(out, *results);
-        out << "<hr />";
-        out << "<table><thead><tr><th>File</th><th>Location</th>"
+        ReportWriter writer(out);
+        writer << "<!DOCTYPE html>";
+        writer << "<html>";
+        writeHead(writer);
+        writer << "<body>";
+        writer << "<h1>OCLint Report</h1>";
+        writer << "<hr />";
+        writer << "<h2>Summary</h2>";
+        writeSummaryTable(writer, *results);
+        writer << "<hr />";
+        writer << "<table><thead><tr><th>File</th><th>Location</th>"
             << "<th>Rule Name</th><th>Rule Category</th>"
             << "<th>Priority</th><th>Message</th></tr></thead><tbody>";
         for (const auto& violation : results->allViolations())
         {
-            writeViolation(out, violation);
+            writeViolation(writer, violation);
         }
         if (results->hasErrors())
         {
-            writeCompilerDiagnostics(out, results->allErrors(), "error");
+            writeCompilerDiagnostics(writer, results->allErrors(), "error");
         }
         if (results->hasWarnings())
         {
-            writeCompilerDiagnostics(out, results->allWarnings(), "warning");
+            writeCompilerDiagnostics(writer, results->allWarnings(), "warning");
         }
         if (results->hasCheckerBugs())
         {
-            writeCheckerBugs(out, results->allCheckerBugs());
+            writeCheckerBugs(writer, results->allCheckerBugs());
+        }
+        writer << "</tbody></table>";
+        writer << "<hr />";
+        writeFooter(writer, Version::identifier());
+        writer << "</body>";
+        writer << "</html>";
+        writer << "\n";
+        writer.flush();
+        out.flush();
+    }
+
+    virtual bool reportToDirectory(Results* results, const std::string &directory) override
+    {
+        std::vector<Violation> violations = results->allViolations();
+        std::vector<FileRows> files;
+        std::map<std::string, size_t> fileIndices;
+        std::map<const RuleBase *, int> ruleCounts;
+        auto addRows = [&](const std::vector<Violation> &source, RowKind kind)
+        {
+            for (const auto& violation : source)
+            {
+                auto fileIndex = fileIndices.emplace(violation.path, files.size());
+                if (fileIndex.second)
+                {
+                    files.emplace_back();
+                    files.back().path = violation.path;
+                }
+                FileRows &file = files[fileIndex.first->second];
+                file.rows.push_back(Row{&violation, kind});
+                file.kinds[kind]++;
+                if (kind == VIOLATION && violation.rule)
+                {
+                    int priority = violation.rule->priority();
+                    if (priority >= 1 && priority <= 3)
+                    {
+                        file.priorities[priority - 1]++;
+                    }
+                    ruleCounts[violation.rule]++;
+                    // compose the rule cells before the pages are written concurrently,
+                    // the writers only ever look them up
+                    _ruleCells.get(violation.rule, ruleCells);
+                }
+            }
+        };
+        addRows(violations, VIOLATION);
+        addRows(results->allErrors(), COMPILER_ERROR);
+        addRows(results->allWarnings(), COMPILER_WARNING);
+        addRows(results->allCheckerBugs(), CHECKER_BUG);
+        std::sort(files.begin(), files.end(), [](const FileRows &lhs, const FileRows &rhs)
+        {
+            return lhs.path < rhs.path;
+        });
+
+        std::string version = Version::identifier();
+        writePage(directory + "/index.html", [&](ReportWriter &out)
+        {
+            writeIndex(out, *results, files, ruleCounts, version);
+        });
+        writePages(directory, files, paginate(files, rowsPerPage), version);
+        return true;
+    }
+
+    static std::vector<Page> paginate(const std::vector<FileRows> &files, size_t rowsPerPage)
+    {
+        std::vector<Page> pages;
+        for (size_t fileIndex = 0; fileIndex < files.size(); fileIndex++)
+        {
+            size_t numberOfRows = files[fileIndex].rows.size();
+            size_t numberOfParts = std::max<size_t>(1, (numberOfRows + rowsPerPage - 1) / rowsPerPage);
+            for (size_t part = 0; part < numberOfParts; part++)
+            {
+                pages.push_back(Page{fileIndex, part, numberOfParts, part * rowsPerPage,
+                    std::min(numberOfRows, (part + 1) * rowsPerPage)});
+            }
+        }
+        return pages;
+    }
+
+    static std::string pageName(size_t fileIndex, size_t part)
+    {
+        std::string name = "file" + std::to_string(fileIndex + 1);
+        if (part > 0)
+        {
+            name += "-" + std::to_string(part + 1);
+        }
+        return name + ".html";
+    }
+
+    template <typename Compose>
+    static void writePage(const std::string &path, Compose compose)
+    {
+        std::ofstream stream(path.c_str());
+        if (!stream.is_open())
+        {
+            throw std::runtime_error("cannot open report page " + path);
+        }
+        ReportWriter writer(stream);
+        compose(writer);
+        writer.flush();
+        stream.close();
+        if (stream.fail())
+        {
+            throw std::runtime_error("cannot write report page " + path);
+        }
+    }
+
+    /* the pages are independent, so they are written by one thread per core */
+    void writePages(const std::string &directory, const std::vector<FileRows> &files,
+        const std::vector<Page> &pages, const std::string &version)
+    {
+        std::atomic<size_t> nextPage(0);
+        std::mutex failureMutex;
+        std::string failure;
+        auto work = [&]()
+        {
+            for (size_t index = nextPage++; index < pages.size(); index = nextPage++)
+            {
+                const Page &page = pages[index];
+                try
+                {
+                    writePage(directory + "/" + pageName(page.fileIndex, page.part),
+                        [&](ReportWriter &out)
+                    {
+                        writeFilePage(out, files[page.fileIndex], page, version);
+                    });
+                }
+                catch (const std::exception &exception)
+                {
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    failure = exception.what();
+                    nextPage = pages.size();
+                }
+            }
+        };
+        size_t numberOfThreads = std::min<size_t>(
+            std::max(1u, std::thread::hardware_concurrency()), pages.size());
+        std::vector<std::thread> threads;
+        for (size_t index = 1; index < numberOfThreads; index++)
+        {
+            threads.emplace_back(work);
+        }
+        work();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        if (!failure.empty())
+        {
+            throw std::runtime_error(failure);
+        }
+    }
+
+    void writeIndex(ReportWriter &out, Results &results, const std::vector<FileRows> &files,
+        const std::map<const RuleBase *, int> &ruleCounts, const std::string &version)
+    {
+        out << "<!DOCTYPE html><html>";
+        writeHead(out);
+        out << "<body><h1>OCLint Report</h1><hr /><h2>Summary</h2>";
+        writeSummaryTable(out, results);
+        out << "<hr /><h2>Files</h2>";
+        writeFilesTable(out, files);
+        out << "<hr /><h2>Rules</h2>";
+        writeRulesTable(out, ruleCounts);
+        out << "<hr />";
+        writeFooter(out, version);
+        out << "</body></html>\n";
+    }
+
+    void writeFilesTable(ReportWriter &out, const std::vector<FileRows> &files)
+    {
+        out << "<table><thead><tr><th>File</th>"
+            << "<th>Priority 1</th><th>Priority 2</th><th>Priority 3</th>"
+            << "<th>Compiler Errors</th><th>Compiler Warnings</th>"
+            << "<th>Clang Static Analyzer</th></tr></thead><tbody>";
+        for (size_t index = 0; index < files.size(); index++)
+        {
+            const FileRows &file = files[index];
+            out << "<tr><td><a href='" << pageName(index, 0) << "'>";
+            out.escaped(file.path, ReportWriter::XML);
+            out << "</a></td><td class='priority1'>" << file.priorities[0]
+                << "</td><td class='priority2'>" << file.priorities[1]
+                << "</td><td class='priority3'>" << file.priorities[2]
+                << "</td><td class='cmplr-error'>" << file.kinds[COMPILER_ERROR]
+                << "</td><td class='cmplr-warning'>" << file.kinds[COMPILER_WARNING]
+                << "</td><td class='checker-bug'>" << file.kinds[CHECKER_BUG] << "</td></tr>";
+        }
+        out << "</tbody></table>";
+    }
+
+    void writeRulesTable(ReportWriter &out, const std::map<const RuleBase *, int> &ruleCounts)
+    {
+        std::vector<std::pair<const RuleBase *, int>> rules(ruleCounts.begin(), ruleCounts.end());
+        std::sort(rules.begin(), rules.end(),
+            [](const std::pair<const RuleBase *, int> &lhs,
+                const std::pair<const RuleBase *, int> &rhs)
+        {
+            return lhs.second > rhs.second ||
+                (lhs.second == rhs.second && lhs.first->name() < rhs.first->name());
+        });
+        out << "<table><thead><tr><th>Rule Name</th><th>Rule Category</th>"
+            << "<th>Priority</th><th>Violations</th></tr></thead><tbody>";
+        for (const auto& rule : rules)
+        {
+            out << "<tr>" << _ruleCells.get(rule.first, ruleCells)
+                << "<td>" << rule.second << "</td></tr>";
         }
         out << "</tbody></table>";
+    }
+
+    void writeFilePage(ReportWriter &out, const FileRows &file, const Page &page,
+        const std::string &version)
+    {
+        out << "<!DOCTYPE html><html>";
+        writeHead(out);
+        out << "<body><h1>OCLint Report</h1><h2>";
+        out.escaped(file.path, ReportWriter::XML);
+        out << "</h2>";
+        writePageNavigation(out, page);
         out << "<hr />";
-        writeFooter(out, Version::identifier());
-        out << "</body>";
-        out << "</html>";
-        out << std::endl;
+        out << "<table><thead><tr><th>File</th><th>Location</th>"
+            << "<th>Rule Name</th><th>Rule Category</th>"
+            << "<th>Priority</th><th>Message</th></tr></thead><tbody>";
+        for (size_t index = page.firstRow; index < page.lastRow; index++)
+        {
+            writeRow(out, file.rows[index]);
+        }
+        out << "</tbody></table><hr />";
+        writePageNavigation(out, page);
+        // without the time of day, ctime is not safe to call from the page writers
+        out << "<p>Generated with <a href='http://oclint.org'>OCLint v" << version << "</a>.</p>";
+        out << "</body></html>\n";
     }
 
-    void writeFooter(std::ostream &out, std::string version)
+    void writePageNavigation(ReportWriter &out, const Page &page)
+    {
+        out << "<p><a href='index.html'>Summary</a>";
+        if (page.numberOfParts > 1)
+        {
+            out << " | Page " << page.part + 1 << " of " << page.numberOfParts;
+            if (page.part > 0)
+            {
+                out << " | <a href='" << pageName(page.fileIndex, page.part - 1)
+                    << "'>Previous</a>";
+            }
+            if (page.part + 1 < page.numberOfParts)
+            {
+                out << " | <a href='" << pageName(page.fileIndex, page.part + 1) << "'>Next</a>";
+            }
+        }
+        out << "</p>";
+    }
+
+    void writeRow(ReportWriter &out, const Row &row)
+    {
+        switch (row.kind)
+        {
+            case VIOLATION:
+                writeViolation(out, *row.violation);
+                break;
+            case COMPILER_ERROR:
+                writeCompilerErrorOrWarning(out, *row.violation, "error");
+                break;
+            case COMPILER_WARNING:
+                writeCompilerErrorOrWarning(out, *row.violation, "warning");
+                break;
+            default:
+                writeCheckerBug(out, *row.violation);
+                break;
+        }
+    }
+
+    void writeFooter(ReportWriter &out, const std::string &version)
     {
         time_t now = time(nullptr);
         out << "<p>" << ctime(&now)
             << "| Generated with <a href='http://oclint.org'>OCLint v" << version << "</a>.</p>";
     }
 
-    void writeViolation(std::ostream &out, const Violation &violation)
+    void writeViolation(ReportWriter &out, const Violation &violation)
     {
-        out << "<tr><td>" << violation.path << "</td><td>" << violation.startLine
-            << ":" << violation.startColumn << "</td>";
-        const RuleBase *rule = violation.rule;
-        out << "<td>" << rule->name() << "</td>"
-            << "<td>" << rule->category() << "</td>"
-            << "<td class='priority" << rule->priority() << "'>"
-            << rule->priority() << "</td>"
-            << "<td>" << violation.message << "</td></tr>";
+        writeLocationCells(out, violation);
+        out << _ruleCells.get(violation.rule, ruleCells);
+        writeMessageCell(out, violation);
     }
 
-    void writeCompilerErrorOrWarning(std::ostream &out,
-        const Violation &violation, std::string level)
+    void writeCompilerErrorOrWarning(ReportWriter &out,
+        const Violation &violation, const std::string &level)
     {
-        out << "<tr><td>" << violation.path << "</td><td>" << violation.startLine
-            << ":" << violation.startColumn << "</td>";
+        writeLocationCells(out, violation);
         out << "<td>compiler " << level << "</td><td></td><td class='cmplr-" << level << "'>"
-            << level << "</td><td>" << violation.message << "</td></tr>";
+            << level << "</td>";
+        writeMessageCell(out, violation);
     }
 
-    void writeCompilerDiagnostics(std::ostream &out, std::vector<Violation> violations,
-        std::string level)
+    void writeCompilerDiagnostics(ReportWriter &out, const std::vector<Violation> &violations,
+        const std::string &level)
     {
         for (const auto& violation : violations)
         {
@@ -91,18 +419,23 @@ public:
         }
     }
 
-    void writeCheckerBugs(std::ostream &out, std::vector<Violation> violations)
+    void writeCheckerBugs(ReportWriter &out, const std::vector<Violation> &violations)
     {
         for (const auto& violation : violations)
         {
-            out << "<tr><td>" << violation.path << "</td><td>" << violation.startLine
-                << ":" << violation.startColumn << "</td>";
-            out << "<td>clang static analyzer</td><td></td><td class='checker-bug'>"
-                << "checker bug</td><td>" << violation.message << "</td></tr>";
+            writeCheckerBug(out, violation);
         }
     }
 
-    void writeSummaryTable(std::ostream &out, Results &results)
+    void writeCheckerBug(ReportWriter &out, const Violation &violation)
+    {
+        writeLocationCells(out, violation);
+        out << "<td>clang static analyzer</td><td></td><td class='checker-bug'>"
+            << "checker bug</td>";
+        writeMessageCell(out, violation);
+    }
+
+    void writeSummaryTable(ReportWriter &out, Results &results)
     {
         out << "<table><thead><tr><th>Total Files</th><th>Files with Violations</th>"
             << "<th>Priority 1</th><th>Priority 2</th><th>Priority 3</th>"
@@ -116,9 +449,13 @@ public:
             << results.allErrors().size() << "</td><td class='cmplr-warning'>"
             << results.allWarnings().size() << "</td><td class='checker-bug'>"
             << results.allCheckerBugs().size() << "</td></tr></tbody></table>";
+        if (results.isTruncated())
+        {
+            out << "<p>Truncated: stopped analyzing once violations exceeded the thresholds</p>";
+        }
     }
 
-    void writeHead(std::ostream &out)
+    void writeHead(ReportWriter &out)
     {
         out << "<head>";
         out << "<title>OCLint Report</title>";
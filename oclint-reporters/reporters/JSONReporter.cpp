@@ -1,6 +1,7 @@
 #include <ctime>
 
 #include "oclint/Results.h"
+#include "oclint/ReportWriter.h"
 #include "oclint/Reporter.h"
 #include "oclint/RuleBase.h"
 #include "oclint/Version.h"
@@ -10,6 +11,16 @@ using namespace oclint;
 
 class JSONReporter : public Reporter
 {
+private:
+    RuleFragments _ruleProperties;
+
+    static std::string ruleProperties(const RuleBase *rule)
+    {
+        return "\"rule\":\"" + ReportWriter::escape(rule->name(), ReportWriter::JSON) + "\"," +
+            "\"category\":\"" + ReportWriter::escape(rule->category(), ReportWriter::JSON) + "\"," +
+            "\"priority\":" + std::to_string(rule->priority()) + ",";
+    }
+
 public:
     virtual const std::string name() const override
     {
@@ -18,40 +29,42 @@ public:
 
     virtual void report(Results* results, std::ostream& out) override
     {
-        out << "{";
-        writeHeader(out, Version::identifier());
-        writeSummary(out, *results);
-        writeKey(out, "violation");
-        out << "[";
+        ReportWriter writer(out);
+        writer << "{";
+        writeHeader(writer, Version::identifier());
+        writeSummary(writer, *results);
+        writeKey(writer, "violation");
+        writer << "[";
         std::vector<Violation> violationSet = results->allViolations();
         for (int index = 0, numberOfViolations = violationSet.size();
             index < numberOfViolations; index++)
         {
             if (index != 0)
             {
-                out << ",";
+                writer << ",";
             }
-            writeViolation(out, violationSet.at(index));
+            writeViolation(writer, violationSet.at(index));
         }
-        out << "],";
-        writeKey(out, "clangStaticAnalyzer");
-        out << "[";
+        writer << "],";
+        writeKey(writer, "clangStaticAnalyzer");
+        writer << "[";
         std::vector<Violation> checkerBugs = results->allCheckerBugs();
         for (int index = 0, numberOfViolations = checkerBugs.size();
             index < numberOfViolations; index++)
         {
             if (index != 0)
             {
-                out << ",";
+                writer << ",";
             }
-            writeViolation(out, checkerBugs.at(index));
+            writeViolation(writer, checkerBugs.at(index));
         }
-        out << "]";
-        out << "}";
-        out << std::endl;
+        writer << "]";
+        writer << "}\n";
+        writer.flush();
+        out.flush();
     }
 
-    void writeHeader(std::ostream &out, std::string version)
+    void writeHeader(ReportWriter &out, const std::string &version)
     {
         writeKeyValue(out, "version", version);
         writeKeyValue(out, "url", "http://oclint.org");
@@ -59,12 +72,12 @@ public:
         writeKeyValue(out, "timestamp", now);
     }
 
-    void writeKey(std::ostream &out, std::string key)
+    void writeKey(ReportWriter &out, const char *key)
     {
         out << "\"" << key << "\":";
     }
 
-    void writeComma(std::ostream &out, bool isLast)
+    void writeComma(ReportWriter &out, bool isLast)
     {
         if (!isLast)
         {
@@ -72,21 +85,39 @@ public:
         }
     }
 
-    void writeKeyValue(std::ostream &out, std::string key, std::string value, bool last = false)
+    void writeKeyValue(ReportWriter &out, const char *key, const std::string &value,
+        bool last = false)
     {
         writeKey(out, key);
-        out << "\"" << value << "\"";
+        out << "\"";
+        out.escaped(value, ReportWriter::JSON);
+        out << "\"";
         writeComma(out, last);
     }
 
-    void writeKeyValue(std::ostream &out, std::string key, int value, bool last = false)
+    void writeKeyValue(ReportWriter &out, const char *key, const char *value, bool last = false)
+    {
+        writeKeyValue(out, key, std::string(value), last);
+    }
+
+    void writeKeyValue(ReportWriter &out, const char *key, long long value, bool last = false)
     {
         writeKey(out, key);
         out << value;
         writeComma(out, last);
     }
 
-    void writeViolation(std::ostream &out, Violation &violation)
+    void writeKeyValue(ReportWriter &out, const char *key, int value, bool last = false)
+    {
+        writeKeyValue(out, key, static_cast<long long>(value), last);
+    }
+
+    void writeKeyValue(ReportWriter &out, const char *key, long value, bool last = false)
+    {
+        writeKeyValue(out, key, static_cast<long long>(value), last);
+    }
+
+    void writeViolation(ReportWriter &out, const Violation &violation)
     {
         out << "{";
         writeKeyValue(out, "path", violation.path);
@@ -100,15 +131,13 @@ public:
         const RuleBase *rule = violation.rule;
         if (rule)
         {
-            writeKeyValue(out, "rule", rule->name());
-            writeKeyValue(out, "category", rule->category());
-            writeKeyValue(out, "priority", rule->priority());
+            out << _ruleProperties.get(rule, ruleProperties);
         }
         writeKeyValue(out, "message", violation.message, true);
         out << "}";
     }
 
-    void writePriority(std::ostream &out, Results &results, int priority)
+    void writePriority(ReportWriter &out, Results &results, int priority)
     {
         out << "{";
         writeKeyValue(out, "priority", priority);
@@ -116,12 +145,17 @@ public:
         out << "}";
     }
 
-    void writeSummary(std::ostream &out, Results &results)
+    void writeSummary(ReportWriter &out, Results &results)
     {
         writeKey(out, "summary");
         out << "{";
         writeKeyValue(out, "numberOfFiles", results.numberOfFiles());
         writeKeyValue(out, "numberOfFilesWithViolations", results.numberOfFilesWithViolations());
+        if (results.isTruncated())
+        {
+            writeKey(out, "truncated");
+            out << "true,";
+        }
         writeKey(out, "numberOfViolationsWithPriority");
         out << "[";
         writePriority(out, results, 1);
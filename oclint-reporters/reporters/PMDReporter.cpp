@@ -1,4 +1,5 @@
 #include "oclint/Results.h"
+#include "oclint/ReportWriter.h"
 #include "oclint/Reporter.h"
 #include "oclint/RuleBase.h"
 #include "oclint/Version.h"
@@ -9,26 +10,34 @@ using namespace oclint;
 class PMDReporter : public Reporter
 {
 private:
-    std::string xmlEscape(const std::string &data)
+    RuleFragments _ruleAttributes;
+
+    static std::string ruleAttributes(const RuleBase *rule)
     {
-        std::string output;
-        output.reserve(data.size());
-        for (const auto &c : data)
-        {
-            switch(c)
-            {
-                case '<':
-                    output += "&lt;";
-                    break;
-                case '>':
-                    output += "&gt;";
-                    break;
-                default:
-                    output += c;
-            }
-        }
-        return output;
+        return "priority=\"" + std::to_string(2 * rule->priority() - 1) + "\" " +
+            "rule=\"" + ReportWriter::escape(rule->name(), ReportWriter::XML) + "\" " +
+            "ruleset=\"" + ReportWriter::escape(rule->category(), ReportWriter::XML) + "\" ";
     }
+
+    void writeLocation(ReportWriter &out, const Violation &violation)
+    {
+        out << "<file name=\"";
+        out.escaped(violation.path, ReportWriter::XML);
+        out << "\">\n";
+        out << "<violation ";
+        out << "begincolumn=\"" << violation.startColumn << "\" ";
+        out << "endcolumn=\"" << violation.endColumn << "\" ";
+        out << "beginline=\"" << violation.startLine << "\" ";
+        out << "endline=\"" << violation.endLine << "\" ";
+    }
+
+    void writeMessage(ReportWriter &out, const Violation &violation)
+    {
+        out << ">\n";
+        out.escaped(violation.message, ReportWriter::XML);
+        out << "\n</violation>\n</file>\n";
+    }
+
 public:
     virtual const std::string name() const override
     {
@@ -37,67 +46,52 @@ public:
 
     virtual void report(Results* results, std::ostream& out) override
     {
-        writeHeader(out, Version::identifier());
+        ReportWriter writer(out);
+        writeHeader(writer, Version::identifier());
         for (const auto& violation : results->allViolations())
         {
-            writeViolation(out, violation);
-            out << std::endl;
+            writeViolation(writer, violation);
+            writer << "\n";
         }
         for (const auto& violation : results->allCheckerBugs())
         {
-            writeCheckerBug(out, violation);
-            out << std::endl;
+            writeCheckerBug(writer, violation);
+            writer << "\n";
         }
-        writeFooter(out);
+        writeFooter(writer);
+        writer.flush();
+        out.flush();
     }
 
-    void writeHeader(std::ostream &out, std::string version)
+    void writeHeader(ReportWriter &out, std::string version)
     {
-        out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
+        out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
         out << "<pmd version=\"oclint-" << version << "\">";
     }
 
-    void writeFooter(std::ostream &out)
+    void writeFooter(ReportWriter &out)
     {
         out << "</pmd>";
     }
 
-    void writeViolation(std::ostream &out, const Violation &violation)
+    void writeViolation(ReportWriter &out, const Violation &violation)
     {
-        out << "<file name=\"" << violation.path << "\">" << std::endl;
-        out << "<violation ";
-        out << "begincolumn=\"" << violation.startColumn << "\" ";
-        out << "endcolumn=\"" << violation.endColumn << "\" ";
-        out << "beginline=\"" << violation.startLine << "\" ";
-        out << "endline=\"" << violation.endLine << "\" ";
+        writeLocation(out, violation);
         const RuleBase *rule = violation.rule;
         if (rule)
         {
-            out << "priority=\"" << 2 * rule->priority() - 1 << "\" ";
-            out << "rule=\"" << rule->name() << "\" ";
-            out << "ruleset=\"" << rule->category() << "\" ";
+            out << _ruleAttributes.get(rule, ruleAttributes);
         }
-        out << ">" << std::endl;
-        out << violation.message << std::endl;
-        out << "</violation>" << std::endl;
-        out << "</file>" << std::endl;
+        writeMessage(out, violation);
     }
 
-    void writeCheckerBug(std::ostream &out, const Violation &violation)
+    void writeCheckerBug(ReportWriter &out, const Violation &violation)
     {
-        out << "<file name=\"" << violation.path << "\">" << std::endl;
-        out << "<violation ";
-        out << "begincolumn=\"" << violation.startColumn << "\" ";
-        out << "endcolumn=\"" << violation.endColumn << "\" ";
-        out << "beginline=\"" << violation.startLine << "\" ";
-        out << "endline=\"" << violation.endLine << "\" ";
+        writeLocation(out, violation);
         out << "priority=\"" << 2 << "\" ";
         out << "rule=\"" << "clang static analyzer" << "\" ";
         out << "ruleset=\"" << "cland static analyzer" << "\" ";
-        out << ">" << std::endl;
-        out << xmlEscape(violation.message) << std::endl;
-        out << "</violation>" << std::endl;
-        out << "</file>" << std::endl;
+        writeMessage(out, violation);
     }
 };
 
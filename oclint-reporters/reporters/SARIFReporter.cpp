@@ -0,0 +1,252 @@
+#include <cctype>
+#include <unordered_map>
+#include <vector>
+
+#include "oclint/Results.h"
+#include "oclint/ReportWriter.h"
+#include "oclint/Reporter.h"
+#include "oclint/RuleBase.h"
+#include "oclint/Version.h"
+#include "oclint/ViolationSet.h"
+
+using namespace oclint;
+
+/*
+ * Writes a SARIF 2.1.0 log. Results are written while the violations are iterated and
+ * refer to rules and files by index only, so the reporter keeps nothing but the rule
+ * and artifact tables, which are written once after the results.
+ */
+class SARIFReporter : public Reporter
+{
+private:
+    std::unordered_map<const RuleBase *, int> _ruleIndices;
+    std::vector<const RuleBase *> _rules;
+    std::unordered_map<std::string, int> _artifactIndices;
+    std::vector<const std::string *> _artifacts;
+    std::unordered_map<const RuleBase *, std::string> _resultPrefixes;
+
+    static const char *levelOf(int priority)
+    {
+        switch (priority)
+        {
+            case 1:
+                return "error";
+            case 2:
+                return "warning";
+            default:
+                return "note";
+        }
+    }
+
+    static bool isUnreservedInURI(unsigned char character)
+    {
+        return isalnum(character) || character == '-' || character == '.' ||
+            character == '_' || character == '~' || character == '/';
+    }
+
+public:
+    virtual const std::string name() const override
+    {
+        return "sarif";
+    }
+
+    virtual void report(Results* results, std::ostream& out) override
+    {
+        _ruleIndices.clear();
+        _rules.clear();
+        _artifactIndices.clear();
+        _artifacts.clear();
+        _resultPrefixes.clear();
+
+        ReportWriter writer(out);
+        writer << "{\"$schema\":\"https://json.schemastore.org/sarif-2.1.0.json\","
+            << "\"version\":\"2.1.0\",\"runs\":[{";
+        writer << "\"results\":[";
+        bool first = true;
+        for (const auto& violation : results->allViolations())
+        {
+            writeComma(writer, first);
+            writeResult(writer, violation);
+        }
+        for (const auto& violation : results->allCheckerBugs())
+        {
+            writeComma(writer, first);
+            writeResult(writer, violation);
+        }
+        writer << "],";
+        writeTool(writer, Version::identifier());
+        writer << ",";
+        writeArtifacts(writer);
+        if (results->isTruncated())
+        {
+            writer << ",\"invocations\":[{\"executionSuccessful\":false,"
+                << "\"toolExecutionNotifications\":[{\"level\":\"error\",\"message\":{\"text\":"
+                << "\"Stopped analyzing once violations exceeded the thresholds\"}}]}]";
+        }
+        // columns are byte offsets, which no SARIF columnKind describes, so none is claimed
+        writer << "}]}\n";
+        writer.flush();
+        out.flush();
+    }
+
+    void writeComma(ReportWriter &out, bool &first)
+    {
+        if (!first)
+        {
+            out << ",";
+        }
+        first = false;
+    }
+
+    /* checker bugs have no rule, they share the entry of the clang static analyzer */
+    int ruleIndex(const RuleBase *rule)
+    {
+        auto index = _ruleIndices.find(rule);
+        if (index == _ruleIndices.end())
+        {
+            index = _ruleIndices.emplace(rule, _rules.size()).first;
+            _rules.push_back(rule);
+        }
+        return index->second;
+    }
+
+    int artifactIndex(const std::string &path)
+    {
+        auto index = _artifactIndices.find(path);
+        if (index == _artifactIndices.end())
+        {
+            index = _artifactIndices.emplace(path, _artifacts.size()).first;
+            _artifacts.push_back(&index->first);
+        }
+        return index->second;
+    }
+
+    static std::string ruleIdOf(const RuleBase *rule)
+    {
+        return rule ? rule->identifier() : "ClangStaticAnalyzer";
+    }
+
+    static int priorityOf(const RuleBase *rule)
+    {
+        return rule ? rule->priority() : 2;
+    }
+
+    static std::string uriOf(const std::string &path)
+    {
+        static const char hexDigits[] = "0123456789ABCDEF";
+        std::string uri = path.size() > 0 && path[0] == '/' ? "file://" : "";
+        for (unsigned char character : path)
+        {
+            if (isUnreservedInURI(character))
+            {
+                uri += character;
+            }
+            else
+            {
+                uri += '%';
+                uri += hexDigits[character >> 4];
+                uri += hexDigits[character & 0xf];
+            }
+        }
+        return uri;
+    }
+
+    /* the part of a result that only depends on its rule, composed once per rule */
+    const std::string &resultPrefix(const RuleBase *rule)
+    {
+        auto prefix = _resultPrefixes.find(rule);
+        if (prefix == _resultPrefixes.end())
+        {
+            std::string composed = "{\"ruleId\":\"" +
+                ReportWriter::escape(ruleIdOf(rule), ReportWriter::JSON) +
+                "\",\"ruleIndex\":" + std::to_string(ruleIndex(rule)) +
+                ",\"level\":\"" + levelOf(priorityOf(rule)) + "\"";
+            prefix = _resultPrefixes.emplace(rule, composed).first;
+        }
+        return prefix->second;
+    }
+
+    void writeResult(ReportWriter &out, const Violation &violation)
+    {
+        out << resultPrefix(violation.rule);
+        out << ",\"message\":{\"text\":\"";
+        out.escaped(violation.message, ReportWriter::JSON);
+        out << "\"},\"locations\":[{\"physicalLocation\":{";
+        out << "\"artifactLocation\":{\"index\":" << artifactIndex(violation.path) << "}";
+        writeRegion(out, violation);
+        out << "}}]}";
+    }
+
+    void writeRegion(ReportWriter &out, const Violation &violation)
+    {
+        if (violation.startLine <= 0)
+        {
+            return;
+        }
+        out << ",\"region\":{\"startLine\":" << violation.startLine;
+        if (violation.startColumn > 0)
+        {
+            out << ",\"startColumn\":" << violation.startColumn;
+        }
+        if (violation.endLine != 0 && violation.endColumn != 0)
+        {
+            out << ",\"endLine\":" << violation.endLine;
+            out << ",\"endColumn\":" << violation.endColumn;
+        }
+        out << "}";
+    }
+
+    void writeTool(ReportWriter &out, const std::string &version)
+    {
+        out << "\"tool\":{\"driver\":{\"name\":\"OCLint\",\"version\":\"";
+        out.escaped(version, ReportWriter::JSON);
+        out << "\",\"informationUri\":\"http://oclint.org\",\"rules\":[";
+        for (size_t index = 0; index < _rules.size(); index++)
+        {
+            if (index != 0)
+            {
+                out << ",";
+            }
+            writeRule(out, _rules[index]);
+        }
+        out << "]}}";
+    }
+
+    void writeRule(ReportWriter &out, const RuleBase *rule)
+    {
+        std::string name = rule ? rule->name() : "clang static analyzer";
+        std::string category = rule ? rule->category() : "clang static analyzer";
+        int priority = priorityOf(rule);
+        out << "{\"id\":\"";
+        out.escaped(ruleIdOf(rule), ReportWriter::JSON);
+        out << "\",\"name\":\"";
+        out.escaped(name, ReportWriter::JSON);
+        out << "\",\"shortDescription\":{\"text\":\"";
+        out.escaped(name, ReportWriter::JSON);
+        out << "\"},\"defaultConfiguration\":{\"level\":\"" << levelOf(priority) << "\"}";
+        out << ",\"properties\":{\"category\":\"";
+        out.escaped(category, ReportWriter::JSON);
+        out << "\",\"priority\":" << priority << "}}";
+    }
+
+    void writeArtifacts(ReportWriter &out)
+    {
+        out << "\"artifacts\":[";
+        for (size_t index = 0; index < _artifacts.size(); index++)
+        {
+            if (index != 0)
+            {
+                out << ",";
+            }
+            out << "{\"location\":{\"uri\":\"";
+            out.escaped(uriOf(*_artifacts[index]), ReportWriter::JSON);
+            out << "\"}}";
+        }
+        out << "]";
+    }
+};
+
+extern "C" Reporter* create()
+{
+    return new SARIFReporter();
+}
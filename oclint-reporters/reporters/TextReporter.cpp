@@ -1,4 +1,5 @@
 #include "oclint/Results.h"
+#include "oclint/ReportWriter.h"
 #include "oclint/Reporter.h"
 #include "oclint/RuleBase.h"
 #include "oclint/Version.h"
@@ -8,6 +9,15 @@ using namespace oclint;
 
 class TextReporter : public Reporter
 {
+private:
+    RuleFragments _ruleDescriptions;
+
+    static std::string ruleDescription(const RuleBase *rule)
+    {
+        return ": " + rule->name() +
+            " [" + rule->category() + "|P" + std::to_string(rule->priority()) + "]";
+    }
+
 public:
     virtual const std::string name() const override
     {
@@ -16,83 +26,88 @@ public:
 
     virtual void report(Results* results, std::ostream& out) override
     {
+        ReportWriter writer(out);
         if (results->hasErrors())
         {
-            writeCompilerDiagnostics(out, results->allErrors(),
+            writeCompilerDiagnostics(writer, results->allErrors(),
                 "Compiler Errors:\n(please be aware that these errors "
                 "will prevent OCLint from analyzing this source code)");
         }
         if (results->hasWarnings())
         {
-            writeCompilerDiagnostics(out, results->allWarnings(), "Compiler Warnings:");
+            writeCompilerDiagnostics(writer, results->allWarnings(), "Compiler Warnings:");
         }
         if (results->hasCheckerBugs())
         {
-            writeCompilerDiagnostics(out,
+            writeCompilerDiagnostics(writer,
                 results->allCheckerBugs(), "Clang Static Analyzer Results:");
         }
-        out << std::endl << std::endl;
-        writeHeader(out);
-        out << std::endl << std::endl;
-        writeSummary(out, *results);
-        out << std::endl << std::endl;
-        writeViolations(out, results->allViolations());
-        out << std::endl;
-        writeFooter(out, Version::identifier());
-        out << std::endl;
+        writer << "\n\n";
+        writeHeader(writer);
+        writer << "\n\n";
+        writeSummary(writer, *results);
+        writer << "\n\n";
+        writeViolations(writer, results->allViolations());
+        writer << "\n";
+        writeFooter(writer, Version::identifier());
+        writer << "\n";
+        writer.flush();
+        out.flush();
     }
 
-    void writeHeader(std::ostream &out)
+    void writeHeader(ReportWriter &out)
     {
         out << "OCLint Report";
     }
 
-    void writeFooter(std::ostream &out, std::string version)
+    void writeFooter(ReportWriter &out, const std::string &version)
     {
         out << "[OCLint (http://oclint.org) v" << version << "]";
     }
 
-    void writeSummary(std::ostream &out, Results &results)
+    void writeSummary(ReportWriter &out, Results &results)
     {
         out << "Summary: TotalFiles=" << results.numberOfFiles() << " ";
         out << "FilesWithViolations=" << results.numberOfFilesWithViolations() << " ";
         out << "P1=" << results.numberOfViolationsWithPriority(1) << " ";
         out << "P2=" << results.numberOfViolationsWithPriority(2) << " ";
         out << "P3=" << results.numberOfViolationsWithPriority(3) << " ";
+        if (results.isTruncated())
+        {
+            out << "\n\nTruncated: stopped analyzing once violations exceeded the thresholds";
+        }
     }
 
-    void writeViolation(std::ostream &out, const Violation &violation)
+    void writeViolation(ReportWriter &out, const Violation &violation)
     {
         out << violation.path << ":" << violation.startLine << ":" << violation.startColumn;
-        const RuleBase *rule = violation.rule;
-        out << ": " << rule->name();
-        out << " [" << rule->category() << "|P" << rule->priority() << "]";
+        out << _ruleDescriptions.get(violation.rule, ruleDescription);
         out << " " << violation.message;
     }
 
-    void writeViolations(std::ostream &out, std::vector<Violation> violations)
+    void writeViolations(ReportWriter &out, const std::vector<Violation> &violations)
     {
         for (const auto& violation : violations)
         {
             writeViolation(out, violation);
-            out << std::endl;
+            out << "\n";
         }
     }
 
-    void writeCompilerErrorOrWarning(std::ostream &out, const Violation &violation)
+    void writeCompilerErrorOrWarning(ReportWriter &out, const Violation &violation)
     {
         out << violation.path << ":" << violation.startLine << ":" << violation.startColumn;
         out << ": " << violation.message;
     }
 
-    void writeCompilerDiagnostics(std::ostream &out, std::vector<Violation> violations,
-        std::string headerText)
+    void writeCompilerDiagnostics(ReportWriter &out, const std::vector<Violation> &violations,
+        const std::string &headerText)
     {
-        out << std::endl << headerText << std::endl << std::endl;
+        out << "\n" << headerText << "\n\n";
         for (const auto& violation : violations)
         {
             writeCompilerErrorOrWarning(out, violation);
-            out << std::endl;
+            out << "\n";
         }
     }
 };
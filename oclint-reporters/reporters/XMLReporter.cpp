@@ -2,6 +2,7 @@
 #include <ctime>
 
 #include "oclint/Results.h"
+#include "oclint/ReportWriter.h"
 #include "oclint/Reporter.h"
 #include "oclint/RuleBase.h"
 #include "oclint/Version.h"
@@ -11,6 +12,16 @@ using namespace oclint;
 
 class XMLReporter : public Reporter
 {
+private:
+    RuleFragments _ruleAttributes;
+
+    static std::string ruleAttributes(const RuleBase *rule)
+    {
+        return " rule=\"" + ReportWriter::escape(rule->name(), ReportWriter::XML) + "\"" +
+            " category=\"" + ReportWriter::escape(rule->category(), ReportWriter::XML) + "\"" +
+            " priority=\"" + std::to_string(rule->priority()) + "\"";
+    }
+
 public:
     virtual const std::string name() const override
     {
@@ -19,32 +30,35 @@ public:
 
     virtual void report(Results* results, std::ostream& out) override
     {
-        writeHeader(out, Version::identifier());
-        writeDatetime(out);
-        writeSummary(out, *results);
-        out << "<violations>";
+        ReportWriter writer(out);
+        writeHeader(writer, Version::identifier());
+        writeDatetime(writer);
+        writeSummary(writer, *results);
+        writer << "<violations>";
         for (const auto& violation : results->allViolations())
         {
-            writeViolation(out, violation);
+            writeViolation(writer, violation);
         }
-        out << "</violations>";
-        out << "<clangstaticanalyzer>";
+        writer << "</violations>";
+        writer << "<clangstaticanalyzer>";
         for (const auto& violation : results->allCheckerBugs())
         {
-            writeViolation(out, violation);
+            writeViolation(writer, violation);
         }
-        out << "</clangstaticanalyzer>";
-        writeFooter(out);
-        out << std::endl;
+        writer << "</clangstaticanalyzer>";
+        writeFooter(writer);
+        writer << "\n";
+        writer.flush();
+        out.flush();
     }
 
-    void writeHeader(std::ostream &out, std::string version)
+    void writeHeader(ReportWriter &out, const std::string &version)
     {
         out << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>";
         out << "<oclint version=\"" << version << "\" url=\"http://oclint.org\">";
     }
 
-    void writeDatetime(std::ostream &out)
+    void writeDatetime(ReportWriter &out)
     {
         time_t now = time(nullptr);
         struct tm *tmNow = gmtime(&now);
@@ -60,12 +74,12 @@ public:
         out << "<datetime>" << charNow << "</datetime>";
     }
 
-    void writeFooter(std::ostream &out)
+    void writeFooter(ReportWriter &out)
     {
         out << "</oclint>";
     }
 
-    void writeViolation(std::ostream &out, const Violation &violation)
+    void writeViolation(ReportWriter &out, const Violation &violation)
     {
         out << "<violation";
         writeViolationAttribute(out, "path", violation.path);
@@ -79,21 +93,31 @@ public:
         const RuleBase *rule = violation.rule;
         if (rule)
         {
-            writeViolationAttribute(out, "rule", rule->name());
-            writeViolationAttribute(out, "category", rule->category());
-            writeViolationAttribute(out, "priority", rule->priority());
+            out << _ruleAttributes.get(rule, ruleAttributes);
         }
         writeViolationAttribute(out, "message", violation.message);
         out << "></violation>";
     }
 
     template <typename T>
-    void writeViolationAttribute(std::ostream &out, std::string key, T value)
+    void writeViolationAttribute(ReportWriter &out, const char *key, T value)
     {
         out << " " << key << "=\"" << value << "\"";
     }
 
-    void writeSummary(std::ostream &out, Results &results)
+    void writeViolationAttribute(ReportWriter &out, const char *key, const std::string &value)
+    {
+        out << " " << key << "=\"";
+        out.escaped(value, ReportWriter::XML);
+        out << "\"";
+    }
+
+    void writeViolationAttribute(ReportWriter &out, const char *key, const char *value)
+    {
+        writeViolationAttribute(out, key, std::string(value));
+    }
+
+    void writeSummary(ReportWriter &out, Results &results)
     {
         out << "<summary>";
         writeSummaryProperty(out, "number of files", results.numberOfFiles());
@@ -104,11 +128,15 @@ public:
             "number of priority 2 violations", results.numberOfViolationsWithPriority(2));
         writeSummaryProperty(out,
             "number of priority 3 violations", results.numberOfViolationsWithPriority(3));
+        if (results.isTruncated())
+        {
+            writeSummaryProperty(out, "truncated", "true");
+        }
         out << "</summary>";
     }
 
     template <typename T>
-    void writeSummaryProperty(std::ostream &out, std::string key, T value)
+    void writeSummaryProperty(ReportWriter &out, const char *key, T value)
     {
         out << "<property name=\"" << key << "\">" << value << "</property>";
     }
@@ -1,4 +1,5 @@
 #include "oclint/Results.h"
+#include "oclint/ReportWriter.h"
 #include "oclint/Reporter.h"
 #include "oclint/RuleBase.h"
 #include "oclint/ViolationSet.h"
@@ -7,6 +8,15 @@ using namespace oclint;
 
 class XcodeReporter : public Reporter
 {
+private:
+    RuleFragments _ruleDescriptions;
+
+    static std::string ruleDescription(const RuleBase *rule)
+    {
+        return ": warning: " + rule->name() +
+            " [" + rule->category() + "|P" + std::to_string(rule->priority()) + "]";
+    }
+
 public:
     virtual const std::string name() const override
     {
@@ -19,19 +29,20 @@ public:
         // can be retrieved from Xcode directly, so we only need to
         // output violations that is emitted by oclint.
 
+        ReportWriter writer(out);
         for (const auto& violation : results->allViolations())
         {
-            writeViolation(out, violation);
-            out << std::endl;
+            writeViolation(writer, violation);
+            writer << "\n";
         }
+        writer.flush();
+        out.flush();
     }
 
-    void writeViolation(std::ostream &out, const Violation &violation)
+    void writeViolation(ReportWriter &out, const Violation &violation)
     {
         out << violation.path << ":" << violation.startLine << ":" << violation.startColumn;
-        const RuleBase *rule = violation.rule;
-        out << ": warning: " << rule->name();
-        out << " [" << rule->category() << "|P" << rule->priority() << "]";
+        out << _ruleDescriptions.get(violation.rule, ruleDescription);
         out << " " << violation.message;
     }
 };
@@ -0,0 +1,197 @@
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "oclint/ColumnarResults.h"
+#include "oclint/Results.h"
+#include "oclint/RuleBase.h"
+#include "oclint/Violation.h"
+
+#include "TestReportWriter.h"
+
+using namespace ::testing;
+using namespace oclint;
+
+class ColumnarTestRule : public RuleBase
+{
+private:
+    std::string _name;
+    int _priority;
+
+public:
+    ColumnarTestRule(std::string name, int priority) : _name(name), _priority(priority)
+    {
+    }
+
+    virtual void apply() override
+    {
+    }
+
+    virtual const std::string name() const override
+    {
+        return _name;
+    }
+
+    virtual const std::string category() const override
+    {
+        return "test";
+    }
+
+    virtual int priority() const override
+    {
+        return _priority;
+    }
+};
+
+class ColumnarTestResults : public Results
+{
+public:
+    std::vector<Violation> violations;
+    std::vector<Violation> errors;
+    std::vector<Violation> none;
+    bool truncated = false;
+
+    virtual std::vector<Violation> allViolations() const override { return violations; }
+    virtual int numberOfViolations() const override { return violations.size(); }
+    virtual int numberOfViolationsWithPriority(int) const override { return 0; }
+    virtual int numberOfFiles() const override { return 7; }
+    virtual int numberOfFilesWithViolations() const override { return 2; }
+    virtual int numberOfErrors() const override { return errors.size(); }
+    virtual bool hasErrors() const override { return !errors.empty(); }
+    virtual const std::vector<Violation>& allErrors() const override { return errors; }
+    virtual int numberOfWarnings() const override { return 0; }
+    virtual bool hasWarnings() const override { return false; }
+    virtual const std::vector<Violation>& allWarnings() const override { return none; }
+    virtual int numberOfCheckerBugs() const override { return 0; }
+    virtual bool hasCheckerBugs() const override { return false; }
+    virtual const std::vector<Violation>& allCheckerBugs() const override { return none; }
+    virtual bool isTruncated() const override { return truncated; }
+};
+
+class ColumnarResultsTest : public ::testing::Test
+{
+protected:
+    ColumnarTestRule longLine{"long line", 3};
+    ColumnarTestRule emptyIf{"empty if statement", 2};
+    ColumnarTestResults results;
+    std::string data;
+
+    virtual void SetUp() override
+    {
+        results.violations.push_back(Violation(&longLine, "/b.m", 1, 2, 3, 4, "too long"));
+        results.violations.push_back(Violation(&emptyIf, "/a.m", 5, 6, 7, 8, "empty"));
+        results.violations.push_back(Violation(&longLine, "/b.m", 9, 10, 11, 12, "too long"));
+        results.errors.push_back(Violation(nullptr, "/a.m", 13, 14, 0, 0, "error"));
+        TestReportWriter writer;
+        columnar::write(results, writer);
+        data = writer.str();
+    }
+};
+
+TEST_F(ColumnarResultsTest, ReadSummary)
+{
+    ColumnarResultsReader reader;
+    ASSERT_TRUE(reader.parse(data.data(), data.size()));
+    EXPECT_THAT(reader.numberOfRecords(), Eq(4u));
+    EXPECT_THAT(reader.numberOfFiles(), Eq(2u));
+    EXPECT_THAT(reader.numberOfRules(), Eq(2u));
+    EXPECT_THAT(reader.numberOfAnalyzedFiles(), Eq(7u));
+    EXPECT_THAT(reader.numberOfFilesWithViolations(), Eq(2u));
+}
+
+TEST_F(ColumnarResultsTest, GroupRecordsByFile)
+{
+    ColumnarResultsReader reader;
+    ASSERT_TRUE(reader.parse(data.data(), data.size()));
+    EXPECT_THAT(reader.string(reader.file(0).path), StrEq("/a.m"));
+    EXPECT_THAT(reader.file(0).firstRecord, Eq(0u));
+    EXPECT_THAT(reader.file(0).numberOfRecords, Eq(2u));
+    EXPECT_THAT(reader.string(reader.file(1).path), StrEq("/b.m"));
+    EXPECT_THAT(reader.file(1).firstRecord, Eq(2u));
+    EXPECT_THAT(reader.file(1).numberOfRecords, Eq(2u));
+    EXPECT_THAT(reader.column(columnar::FILE_COLUMN)[3], Eq(1u));
+}
+
+TEST_F(ColumnarResultsTest, ReadColumns)
+{
+    ColumnarResultsReader reader;
+    ASSERT_TRUE(reader.parse(data.data(), data.size()));
+    EXPECT_THAT(reader.column(columnar::START_LINE_COLUMN)[0], Eq(5u));
+    EXPECT_THAT(reader.column(columnar::END_COLUMN_COLUMN)[0], Eq(8u));
+    EXPECT_THAT(reader.string(reader.column(columnar::MESSAGE_COLUMN)[0]), StrEq("empty"));
+    EXPECT_THAT(reader.priorities()[0], Eq(2));
+    EXPECT_THAT(reader.kinds()[0], Eq(columnar::VIOLATION));
+
+    EXPECT_THAT(reader.column(columnar::RULE_COLUMN)[1], Eq(columnar::noRule));
+    EXPECT_THAT(reader.priorities()[1], Eq(0));
+    EXPECT_THAT(reader.kinds()[1], Eq(columnar::COMPILER_ERROR));
+
+    const columnar::Rule &rule = reader.rule(reader.column(columnar::RULE_COLUMN)[2]);
+    EXPECT_THAT(reader.string(rule.name), StrEq("long line"));
+    EXPECT_THAT(reader.string(rule.category), StrEq("test"));
+    EXPECT_THAT(rule.priority, Eq(3u));
+}
+
+TEST_F(ColumnarResultsTest, ShareStrings)
+{
+    ColumnarResultsReader reader;
+    ASSERT_TRUE(reader.parse(data.data(), data.size()));
+    const uint32_t *messages = reader.column(columnar::MESSAGE_COLUMN);
+    EXPECT_THAT(messages[2], Eq(messages[3]));
+    EXPECT_THAT(reader.stringLength(messages[2]), Eq(8u));
+}
+
+TEST_F(ColumnarResultsTest, ReadTruncation)
+{
+    ColumnarResultsReader reader;
+    ASSERT_TRUE(reader.parse(data.data(), data.size()));
+    EXPECT_FALSE(reader.isTruncated());
+
+    results.truncated = true;
+    TestReportWriter writer;
+    columnar::write(results, writer);
+    std::string truncatedData = writer.str();
+    ASSERT_TRUE(reader.parse(truncatedData.data(), truncatedData.size()));
+    EXPECT_TRUE(reader.isTruncated());
+}
+
+TEST_F(ColumnarResultsTest, RejectCorruptData)
+{
+    ColumnarResultsReader reader;
+    std::string badMagic = data;
+    badMagic[0] = 'X';
+    EXPECT_FALSE(reader.parse(badMagic.data(), badMagic.size()));
+    std::string truncated = data.substr(0, data.size() - 1);
+    EXPECT_FALSE(reader.parse(truncated.data(), truncated.size()));
+    std::string unterminated = data;
+    unterminated[unterminated.size() - 1] = 'X';
+    EXPECT_FALSE(reader.parse(unterminated.data(), unterminated.size()));
+    EXPECT_FALSE(reader.parse(data.data(), 10));
+}
+
+TEST_F(ColumnarResultsTest, OpenFile)
+{
+    char path[] = "/tmp/ColumnarResultsTest.XXXXXX";
+    int descriptor = mkstemp(path);
+    ASSERT_THAT(descriptor, Ne(-1));
+    close(descriptor);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << data;
+    }
+    ColumnarResultsReader reader;
+    EXPECT_TRUE(reader.open(path));
+    EXPECT_THAT(reader.numberOfRecords(), Eq(4u));
+    remove(path);
+    EXPECT_FALSE(reader.open(path));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
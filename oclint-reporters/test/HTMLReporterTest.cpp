@@ -1,9 +1,12 @@
+#include <cstdlib>
+#include <fstream>
 #include <sstream>
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
 #include "ReportTestResults.h"
+#include "TestReportWriter.h"
 #include "HTMLReporter.cpp"
 
 using namespace ::testing;
@@ -31,7 +34,7 @@ TEST_F(HTMLReporterTest, PropertyTest)
 
 TEST_F(HTMLReporterTest, WriteHead)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeHead(oss);
     EXPECT_THAT(oss.str(), StartsWith("<head>"));
     EXPECT_THAT(oss.str(), HasSubstr("<title>OCLint Report</title>"));
@@ -41,7 +44,7 @@ TEST_F(HTMLReporterTest, WriteHead)
 TEST_F(HTMLReporterTest, WriteSummaryTable)
 {
     Results *restults = getTestResults();
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeSummaryTable(oss, *restults);
     EXPECT_THAT(oss.str(), HasSubstr("<th>Total Files</th><th>Files with Violations</th>"
         "<th>Priority 1</th><th>Priority 2</th><th>Priority 3</th>"
@@ -55,7 +58,7 @@ TEST_F(HTMLReporterTest, WriteViolation)
 {
     RuleBase *rule = new MockRuleBase();
     Violation violation(rule, "test path", 1, 2, 3, 4, "test message");
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeViolation(oss, violation);
     EXPECT_THAT(oss.str(), HasSubstr("<td>test path</td>"));
     EXPECT_THAT(oss.str(), HasSubstr("<td>1:2</td>"));
@@ -64,7 +67,7 @@ TEST_F(HTMLReporterTest, WriteViolation)
 
 TEST_F(HTMLReporterTest, WriteFooter)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeFooter(oss, "-test");
     EXPECT_THAT(oss.str(), HasSubstr("Generated with <a href='http://oclint.org'>OCLint v-test"));
 }
@@ -72,7 +75,7 @@ TEST_F(HTMLReporterTest, WriteFooter)
 TEST_F(HTMLReporterTest, WriteCompilerErrorOrWarning)
 {
     Violation violation(0, "test path", 1, 2, 3, 4, "test message");
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeCompilerErrorOrWarning(oss, violation, "testlevel");
     EXPECT_THAT(oss.str(), HasSubstr("<td>test path</td>"));
     EXPECT_THAT(oss.str(), HasSubstr("<td>1:2</td>"));
@@ -88,7 +91,7 @@ TEST_F(HTMLReporterTest, WriteCompilerDiagnostics)
     std::vector<Violation> violations;
     violations.push_back(violation1);
     violations.push_back(violation2);
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeCompilerDiagnostics(oss, violations, "testlevel");
     EXPECT_THAT(oss.str(), HasSubstr("<td>test1 path</td><td>1:2</td><td>compiler testlevel</td>"
         "<td></td><td class='cmplr-testlevel'>testlevel</td><td>test1 message</td>"));
@@ -103,7 +106,7 @@ TEST_F(HTMLReporterTest, WriteCheckerBugs)
     std::vector<Violation> violations;
     violations.push_back(violation1);
     violations.push_back(violation2);
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeCheckerBugs(oss, violations);
     EXPECT_THAT(oss.str(), HasSubstr("<td>test1 path</td><td>1:2</td><td>clang static analyzer</td>"
         "<td></td><td class='checker-bug'>checker bug</td><td>test1 message</td>"));
@@ -111,6 +114,68 @@ TEST_F(HTMLReporterTest, WriteCheckerBugs)
         "<td></td><td class='checker-bug'>checker bug</td><td>test2 message</td>"));
 }
 
+TEST_F(HTMLReporterTest, PageNames)
+{
+    EXPECT_THAT(HTMLReporter::pageName(0, 0), StrEq("file1.html"));
+    EXPECT_THAT(HTMLReporter::pageName(4, 2), StrEq("file5-3.html"));
+}
+
+TEST_F(HTMLReporterTest, PaginateFiles)
+{
+    std::vector<HTMLReporter::FileRows> files(2);
+    files[0].rows.resize(5);
+    files[1].rows.resize(2);
+    std::vector<HTMLReporter::Page> pages = HTMLReporter::paginate(files, 2);
+    ASSERT_THAT(pages.size(), Eq(4u));
+    EXPECT_THAT(pages[0].fileIndex, Eq(0u));
+    EXPECT_THAT(pages[0].numberOfParts, Eq(3u));
+    EXPECT_THAT(pages[2].part, Eq(2u));
+    EXPECT_THAT(pages[2].firstRow, Eq(4u));
+    EXPECT_THAT(pages[2].lastRow, Eq(5u));
+    EXPECT_THAT(pages[3].fileIndex, Eq(1u));
+    EXPECT_THAT(pages[3].numberOfParts, Eq(1u));
+    EXPECT_THAT(pages[3].lastRow, Eq(2u));
+}
+
+TEST_F(HTMLReporterTest, WritePageNavigation)
+{
+    HTMLReporter::Page page{4, 1, 3, 2000, 4000};
+    TestReportWriter oss;
+    reporter.writePageNavigation(oss, page);
+    EXPECT_THAT(oss.str(), StrEq("<p><a href='index.html'>Summary</a> | Page 2 of 3"
+        " | <a href='file5.html'>Previous</a> | <a href='file5-3.html'>Next</a></p>"));
+}
+
+TEST_F(HTMLReporterTest, WriteFilesTable)
+{
+    std::vector<HTMLReporter::FileRows> files(1);
+    files[0].path = "a<b>.m";
+    files[0].priorities[1] = 3;
+    files[0].kinds[HTMLReporter::CHECKER_BUG] = 1;
+    TestReportWriter oss;
+    reporter.writeFilesTable(oss, files);
+    EXPECT_THAT(oss.str(), HasSubstr("<tr><td><a href='file1.html'>a&lt;b&gt;.m</a></td>"
+        "<td class='priority1'>0</td><td class='priority2'>3</td><td class='priority3'>0</td>"
+        "<td class='cmplr-error'>0</td><td class='cmplr-warning'>0</td>"
+        "<td class='checker-bug'>1</td></tr>"));
+}
+
+TEST_F(HTMLReporterTest, ReportToDirectory)
+{
+    char directory[] = "/tmp/HTMLReporterTest.XXXXXX";
+    ASSERT_THAT(mkdtemp(directory), NotNull());
+    Results *results = getTestResults();
+    EXPECT_TRUE(reporter.reportToDirectory(results, directory));
+    std::ifstream index((std::string(directory) + "/index.html").c_str());
+    std::stringstream content;
+    content << index.rdbuf();
+    EXPECT_THAT(content.str(), HasSubstr("<h2>Files</h2>"));
+    EXPECT_THAT(content.str(), HasSubstr("<h2>Rules</h2>"));
+    remove((std::string(directory) + "/index.html").c_str());
+    remove(directory);
+    delete results;
+}
+
 int main(int argc, char **argv)
 {
     ::testing::InitGoogleMock(&argc, argv);
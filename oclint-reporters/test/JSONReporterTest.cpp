@@ -4,6 +4,7 @@
 #include <gmock/gmock.h>
 
 #include "ReportTestResults.h"
+#include "TestReportWriter.h"
 #include "JSONReporter.cpp"
 
 using namespace ::testing;
@@ -18,6 +19,19 @@ public:
     MOCK_CONST_METHOD0(category, const std::string());
 };
 
+class TruncatedTestResults : public ReportTestResults
+{
+public:
+    TruncatedTestResults() : ReportTestResults(*ResultCollector::getInstance())
+    {
+    }
+
+    virtual bool isTruncated() const override
+    {
+        return true;
+    }
+};
+
 class JSONReporterTest : public ::testing::Test
 {
 protected:
@@ -31,56 +45,56 @@ TEST_F(JSONReporterTest, PropertyTest)
 
 TEST_F(JSONReporterTest, WriteHeader)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeHeader(oss, "test");
     EXPECT_THAT(oss.str(), HasSubstr("\"version\":\"test\",\"url\":\"http://oclint.org\","));
 }
 
 TEST_F(JSONReporterTest, WriteKey)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeKey(oss, "key");
     EXPECT_THAT(oss.str(), StrEq("\"key\":"));
 }
 
 TEST_F(JSONReporterTest, WriteComma)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeComma(oss, false);
     EXPECT_THAT(oss.str(), StrEq(","));
 }
 
 TEST_F(JSONReporterTest, WriteCommaFalse)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeComma(oss, true);
     EXPECT_THAT(oss.str(), StrEq(""));
 }
 
 TEST_F(JSONReporterTest, writeKeyIntValue)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeKeyValue(oss, "key", 1);
     EXPECT_THAT(oss.str(), StrEq("\"key\":1,"));
 }
 
 TEST_F(JSONReporterTest, writeTailKeyIntValue)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeKeyValue(oss, "key", 1, true);
     EXPECT_THAT(oss.str(), StrEq("\"key\":1"));
 }
 
 TEST_F(JSONReporterTest, writeKeyStringValue)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeKeyValue(oss, "key", "value");
     EXPECT_THAT(oss.str(), StrEq("\"key\":\"value\","));
 }
 
 TEST_F(JSONReporterTest, writeTailKeyStringValue)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeKeyValue(oss, "key", "value", true);
     EXPECT_THAT(oss.str(), StrEq("\"key\":\"value\""));
 }
@@ -88,7 +102,7 @@ TEST_F(JSONReporterTest, writeTailKeyStringValue)
 TEST_F(JSONReporterTest, WriteSummary)
 {
     Results *restults = getTestResults();
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeSummary(oss, *restults);
     EXPECT_THAT(oss.str(), StartsWith("\"summary\":"));
     EXPECT_THAT(oss.str(), HasSubstr("\"numberOfFiles\":0"));
@@ -99,11 +113,23 @@ TEST_F(JSONReporterTest, WriteSummary)
     EXPECT_THAT(oss.str(), HasSubstr("{\"priority\":3,\"number\":0}"));
 }
 
+TEST_F(JSONReporterTest, WriteTruncatedSummary)
+{
+    TruncatedTestResults results;
+    TestReportWriter oss;
+    reporter.writeSummary(oss, results);
+    EXPECT_THAT(oss.str(), HasSubstr("\"truncated\":true,"));
+
+    TestReportWriter complete;
+    reporter.writeSummary(complete, *getTestResults());
+    EXPECT_THAT(complete.str(), Not(HasSubstr("truncated")));
+}
+
 TEST_F(JSONReporterTest, WriteViolation)
 {
     RuleBase *rule = new MockRuleBase();
     Violation violation(rule, "test path", 1, 2, 3, 4, "test message");
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeViolation(oss, violation);
     EXPECT_THAT(oss.str(), HasSubstr("\"path\":\"test path\""));
     EXPECT_THAT(oss.str(), HasSubstr("\"startLine\":1"));
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include "TestReportWriter.h"
 #include "PMDReporter.cpp"
 
 using namespace ::testing;
@@ -30,7 +31,7 @@ TEST_F(PMDReporterTest, PropertyTest)
 
 TEST_F(PMDReporterTest, WriteHeader)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeHeader(oss, "test");
     EXPECT_THAT(oss.str(), HasSubstr("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"));
     EXPECT_THAT(oss.str(), HasSubstr("<pmd version=\"oclint-test\">"));
@@ -38,7 +39,7 @@ TEST_F(PMDReporterTest, WriteHeader)
 
 TEST_F(PMDReporterTest, WriteFooter)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeFooter(oss);
     EXPECT_THAT(oss.str(), StrEq("</pmd>"));
 }
@@ -47,7 +48,7 @@ TEST_F(PMDReporterTest, WriteViolation)
 {
     RuleBase *rule = new MockRuleBase();
     Violation violation(rule, "test path", 1, 2, 3, 4, "test message");
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeViolation(oss, violation);
     EXPECT_THAT(oss.str(), HasSubstr("<file name=\"test path\">"));
     EXPECT_THAT(oss.str(), HasSubstr("<violation"));
@@ -63,7 +64,7 @@ TEST_F(PMDReporterTest, WriteViolation)
 TEST_F(PMDReporterTest, WriteCheckerBug)
 {
     Violation violation(nullptr, "test path", 1, 2, 3, 4, "test <message>");
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeCheckerBug(oss, violation);
     EXPECT_THAT(oss.str(), HasSubstr("<file name=\"test path\">"));
     EXPECT_THAT(oss.str(), HasSubstr("<violation"));
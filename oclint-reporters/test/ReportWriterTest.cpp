@@ -0,0 +1,129 @@
+#include <climits>
+#include <sstream>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "TestReportWriter.h"
+
+using namespace ::testing;
+using namespace oclint;
+
+TEST(ReportWriterTest, WriteStringsAndCharacters)
+{
+    TestReportWriter writer;
+    writer << std::string("foo") << "bar" << '!';
+    EXPECT_THAT(writer.str(), StrEq("foobar!"));
+}
+
+TEST(ReportWriterTest, WriteIntegers)
+{
+    TestReportWriter writer;
+    writer << 0 << " " << 42 << " " << -7 << " " << 1234567890L << " " << 18446744073709551615ULL;
+    EXPECT_THAT(writer.str(), StrEq("0 42 -7 1234567890 18446744073709551615"));
+}
+
+TEST(ReportWriterTest, WriteSmallestIntegers)
+{
+    TestReportWriter writer;
+    writer << INT_MIN << " " << LLONG_MIN;
+    EXPECT_THAT(writer.str(), StrEq("-2147483648 -9223372036854775808"));
+}
+
+TEST(ReportWriterTest, WriteDoublesLikeStreams)
+{
+    std::ostringstream expected;
+    expected << 0.5 << " " << 12.0 << " " << 1.0 / 3;
+    TestReportWriter writer;
+    writer << 0.5 << " " << 12.0 << " " << 1.0 / 3;
+    EXPECT_THAT(writer.str(), StrEq(expected.str()));
+}
+
+TEST(ReportWriterTest, KeepOutputUntilFlushed)
+{
+    std::ostringstream stream;
+    {
+        ReportWriter writer(stream);
+        writer << "buffered";
+        EXPECT_THAT(stream.str(), StrEq(""));
+        writer.flush();
+        EXPECT_THAT(stream.str(), StrEq("buffered"));
+        writer << " until destroyed";
+    }
+    EXPECT_THAT(stream.str(), StrEq("buffered until destroyed"));
+}
+
+TEST(ReportWriterTest, WriteMoreThanCapacity)
+{
+    std::ostringstream stream;
+    {
+        ReportWriter writer(stream, 4);
+        writer << "ab" << "cdefghij" << "kl" << "mno";
+    }
+    EXPECT_THAT(stream.str(), StrEq("abcdefghijklmno"));
+}
+
+TEST(ReportWriterTest, EscapeXML)
+{
+    EXPECT_THAT(ReportWriter::escape("a < b && c > \"d\" 'e'", ReportWriter::XML),
+        StrEq("a &lt; b &amp;&amp; c &gt; &quot;d&quot; &#39;e&#39;"));
+}
+
+TEST(ReportWriterTest, EscapeJSON)
+{
+    EXPECT_THAT(ReportWriter::escape("say \"hi\"\\\n\t\x01", ReportWriter::JSON),
+        StrEq("say \\\"hi\\\"\\\\\\n\\t\\u0001"));
+}
+
+TEST(ReportWriterTest, EscapeLeavesPlainTextAlone)
+{
+    std::string text = "/path/to/a/file/with/a/rather/long/name.m";
+    EXPECT_THAT(ReportWriter::escape(text, ReportWriter::XML), StrEq(text));
+    EXPECT_THAT(ReportWriter::escape(text, ReportWriter::JSON), StrEq(text));
+    EXPECT_THAT(ReportWriter::escape("", ReportWriter::JSON), StrEq(""));
+}
+
+TEST(ReportWriterTest, EscapeAtEveryPositionOfAWord)
+{
+    for (size_t position = 0; position < 20; position++)
+    {
+        std::string text(20, 'x');
+        text[position] = '<';
+        std::string expected(text);
+        expected.replace(position, 1, "&lt;");
+        EXPECT_THAT(ReportWriter::escape(text, ReportWriter::XML), StrEq(expected));
+    }
+}
+
+TEST(ReportWriterTest, KeepUTF8Bytes)
+{
+    std::string text = "r\xC3\xA9sum\xC3\xA9 \xE2\x80\x94 caf\xC3\xA9";
+    EXPECT_THAT(ReportWriter::escape(text, ReportWriter::XML), StrEq(text));
+    EXPECT_THAT(ReportWriter::escape(text, ReportWriter::JSON), StrEq(text));
+}
+
+TEST(ReportWriterTest, WriteEscaped)
+{
+    TestReportWriter writer;
+    writer << "<m>";
+    writer.escaped("1 < 2", ReportWriter::XML);
+    writer << "</m>";
+    EXPECT_THAT(writer.str(), StrEq("<m>1 &lt; 2</m>"));
+}
+
+TEST(ReportWriterTest, ComposeRuleFragmentsOnce)
+{
+    RuleFragments fragments;
+    int composed = 0;
+    auto compose = [&composed](const RuleBase *) { composed++; return std::string("fragment"); };
+    const RuleBase *rule = reinterpret_cast<const RuleBase *>(&composed);
+    EXPECT_THAT(fragments.get(rule, compose), StrEq("fragment"));
+    EXPECT_THAT(fragments.get(rule, compose), StrEq("fragment"));
+    EXPECT_THAT(composed, Eq(1));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+#include <sstream>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "ReportTestResults.h"
+#include "TestReportWriter.h"
+#include "SARIFReporter.cpp"
+
+using namespace ::testing;
+using namespace oclint;
+
+class MockRuleBase : public RuleBase
+{
+public:
+    MOCK_METHOD0(apply, void());
+    MOCK_CONST_METHOD0(name, const std::string());
+    MOCK_CONST_METHOD0(priority, int());
+    MOCK_CONST_METHOD0(category, const std::string());
+};
+
+class SARIFReporterTest : public ::testing::Test
+{
+protected:
+    SARIFReporter reporter;
+    MockRuleBase firstRule;
+    MockRuleBase secondRule;
+
+    virtual void SetUp() override
+    {
+        ON_CALL(firstRule, name()).WillByDefault(Return("long line"));
+        ON_CALL(firstRule, category()).WillByDefault(Return("size"));
+        ON_CALL(firstRule, priority()).WillByDefault(Return(3));
+        ON_CALL(secondRule, name()).WillByDefault(Return("empty if statement"));
+        ON_CALL(secondRule, category()).WillByDefault(Return("empty"));
+        ON_CALL(secondRule, priority()).WillByDefault(Return(2));
+    }
+};
+
+TEST_F(SARIFReporterTest, PropertyTest)
+{
+    EXPECT_THAT(reporter.name(), StrEq("sarif"));
+}
+
+TEST_F(SARIFReporterTest, WriteResult)
+{
+    Violation violation(&firstRule, "/test/path.m", 1, 2, 3, 4, "test \"message\"");
+    TestReportWriter oss;
+    reporter.writeResult(oss, violation);
+    EXPECT_THAT(oss.str(), StrEq("{\"ruleId\":\"LongLine\",\"ruleIndex\":0,\"level\":\"note\","
+        "\"message\":{\"text\":\"test \\\"message\\\"\"},\"locations\":[{\"physicalLocation\":{"
+        "\"artifactLocation\":{\"index\":0},"
+        "\"region\":{\"startLine\":1,\"startColumn\":2,\"endLine\":3,\"endColumn\":4}}}]}"));
+}
+
+TEST_F(SARIFReporterTest, WriteResultWithoutEnd)
+{
+    Violation violation(&firstRule, "/test/path.m", 1, 2, 0, 0, "test message");
+    TestReportWriter oss;
+    reporter.writeResult(oss, violation);
+    EXPECT_THAT(oss.str(), HasSubstr("\"region\":{\"startLine\":1,\"startColumn\":2}"));
+}
+
+TEST_F(SARIFReporterTest, ReuseRuleAndArtifactIndices)
+{
+    EXPECT_THAT(reporter.ruleIndex(&firstRule), Eq(0));
+    EXPECT_THAT(reporter.ruleIndex(&secondRule), Eq(1));
+    EXPECT_THAT(reporter.ruleIndex(&firstRule), Eq(0));
+    EXPECT_THAT(reporter.ruleIndex(nullptr), Eq(2));
+    EXPECT_THAT(reporter.artifactIndex("/a.m"), Eq(0));
+    EXPECT_THAT(reporter.artifactIndex("/b.m"), Eq(1));
+    EXPECT_THAT(reporter.artifactIndex("/a.m"), Eq(0));
+}
+
+TEST_F(SARIFReporterTest, WriteRuleTable)
+{
+    reporter.ruleIndex(&secondRule);
+    reporter.ruleIndex(nullptr);
+    TestReportWriter oss;
+    reporter.writeTool(oss, "test");
+    EXPECT_THAT(oss.str(), StrEq("\"tool\":{\"driver\":{\"name\":\"OCLint\",\"version\":\"test\","
+        "\"informationUri\":\"http://oclint.org\",\"rules\":["
+        "{\"id\":\"EmptyIfStatement\",\"name\":\"empty if statement\","
+        "\"shortDescription\":{\"text\":\"empty if statement\"},"
+        "\"defaultConfiguration\":{\"level\":\"warning\"},"
+        "\"properties\":{\"category\":\"empty\",\"priority\":2}},"
+        "{\"id\":\"ClangStaticAnalyzer\",\"name\":\"clang static analyzer\","
+        "\"shortDescription\":{\"text\":\"clang static analyzer\"},"
+        "\"defaultConfiguration\":{\"level\":\"warning\"},"
+        "\"properties\":{\"category\":\"clang static analyzer\",\"priority\":2}}]}}"));
+}
+
+TEST_F(SARIFReporterTest, WriteArtifactTable)
+{
+    reporter.artifactIndex("/test/a file.m");
+    reporter.artifactIndex("relative/b.m");
+    TestReportWriter oss;
+    reporter.writeArtifacts(oss);
+    EXPECT_THAT(oss.str(), StrEq("\"artifacts\":[{\"location\":{\"uri\":\"file:///test/a%20file.m\"}},"
+        "{\"location\":{\"uri\":\"relative/b.m\"}}]"));
+}
+
+TEST_F(SARIFReporterTest, EncodeURIs)
+{
+    EXPECT_THAT(SARIFReporter::uriOf("/a/b-c_d.e~f"), StrEq("file:///a/b-c_d.e~f"));
+    EXPECT_THAT(SARIFReporter::uriOf("/a#b?c%d"), StrEq("file:///a%23b%3Fc%25d"));
+    EXPECT_THAT(SARIFReporter::uriOf("/caf\xC3\xA9"), StrEq("file:///caf%C3%A9"));
+}
+
+TEST_F(SARIFReporterTest, WriteEmptyReport)
+{
+    Results *results = getTestResults();
+    std::ostringstream oss;
+    reporter.report(results, oss);
+    EXPECT_THAT(oss.str(), StartsWith("{\"$schema\":\"https://json.schemastore.org/sarif-2.1.0.json\","
+        "\"version\":\"2.1.0\",\"runs\":[{\"results\":[],\"tool\":"));
+    EXPECT_THAT(oss.str(), HasSubstr("\"rules\":[]}},\"artifacts\":[],"));
+    delete results;
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,28 @@
+#include <sstream>
+
+#include "oclint/ReportWriter.h"
+
+namespace oclint
+{
+
+struct TestReportStream
+{
+    std::ostringstream stream;
+};
+
+/* collects the output of a reporter in memory, str() returns everything written so far */
+class TestReportWriter : private TestReportStream, public ReportWriter
+{
+public:
+    TestReportWriter() : ReportWriter(stream)
+    {
+    }
+
+    std::string str()
+    {
+        flush();
+        return stream.str();
+    }
+};
+
+}
@@ -4,6 +4,7 @@
 #include <gmock/gmock.h>
 
 #include "ReportTestResults.h"
+#include "TestReportWriter.h"
 #include "TextReporter.cpp"
 
 using namespace ::testing;
@@ -31,14 +32,14 @@ TEST_F(TextReporterTest, PropertyTest)
 
 TEST_F(TextReporterTest, WriteHeader)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeHeader(oss);
     EXPECT_THAT(oss.str(), StrEq("OCLint Report"));
 }
 
 TEST_F(TextReporterTest, WriteFooter)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeFooter(oss, "-test");
     EXPECT_THAT(oss.str(), StrEq("[OCLint (http://oclint.org) v-test]"));
 }
@@ -46,7 +47,7 @@ TEST_F(TextReporterTest, WriteFooter)
 TEST_F(TextReporterTest, WriteSummary)
 {
     Results *restults = getTestResults();
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeSummary(oss, *restults);
     EXPECT_THAT(oss.str(), StartsWith("Summary:"));
     EXPECT_THAT(oss.str(), HasSubstr("TotalFiles=0"));
@@ -64,7 +65,7 @@ TEST_F(TextReporterTest, WriteViolations)
     std::vector<Violation> violations;
     violations.push_back(violation1);
     violations.push_back(violation2);
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeViolations(oss, violations);
     EXPECT_THAT(oss.str(), HasSubstr("test1 path"));
     EXPECT_THAT(oss.str(), HasSubstr("1:2"));
@@ -78,7 +79,7 @@ TEST_F(TextReporterTest, WriteViolation)
 {
     RuleBase *rule = new MockRuleBase();
     Violation violation(rule, "test path", 1, 2, 3, 4, "test message");
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeViolation(oss, violation);
     EXPECT_THAT(oss.str(), HasSubstr("test path"));
     EXPECT_THAT(oss.str(), HasSubstr("1:2"));
@@ -88,7 +89,7 @@ TEST_F(TextReporterTest, WriteViolation)
 TEST_F(TextReporterTest, WriteCompilerErrorOrWarning)
 {
     Violation violation(0, "test path", 1, 2, 3, 4, "test message");
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeCompilerErrorOrWarning(oss, violation);
     EXPECT_THAT(oss.str(), HasSubstr("test path"));
     EXPECT_THAT(oss.str(), HasSubstr("1:2"));
@@ -102,7 +103,7 @@ TEST_F(TextReporterTest, WriteCompilerDiagnostics)
     std::vector<Violation> violations;
     violations.push_back(violation1);
     violations.push_back(violation2);
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeCompilerDiagnostics(oss, violations, "test header text");
     EXPECT_THAT(oss.str(), HasSubstr("test header text"));
     EXPECT_THAT(oss.str(), HasSubstr("test1 path"));
@@ -4,6 +4,7 @@
 #include <gmock/gmock.h>
 
 #include "ReportTestResults.h"
+#include "TestReportWriter.h"
 #include "XMLReporter.cpp"
 
 using namespace ::testing;
@@ -31,14 +32,14 @@ TEST_F(XMLReporterTest, PropertyTest)
 
 TEST_F(XMLReporterTest, WriteHeader)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeHeader(oss, "test");
     EXPECT_THAT(oss.str(), StrEq("<?xml version=\"1.0\" encoding=\"UTF-8\" ?><oclint version=\"test\" url=\"http://oclint.org\">"));
 }
 
 TEST_F(XMLReporterTest, WriteFooter)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeFooter(oss);
     EXPECT_THAT(oss.str(), StrEq("</oclint>"));
 }
@@ -47,7 +48,7 @@ TEST_F(XMLReporterTest, WriteViolation)
 {
     RuleBase *rule = new MockRuleBase();
     Violation violation(rule, "test path", 1, 2, 3, 4, "test message");
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeViolation(oss, violation);
     EXPECT_THAT(oss.str(), HasSubstr("path=\"test path\""));
     EXPECT_THAT(oss.str(), HasSubstr("startline=\"1\""));
@@ -59,21 +60,21 @@ TEST_F(XMLReporterTest, WriteViolation)
 
 TEST_F(XMLReporterTest, WriteViolationIntAttribute)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeViolationAttribute(oss, "key", 1);
     EXPECT_THAT(oss.str(), StrEq(" key=\"1\""));
 }
 
 TEST_F(XMLReporterTest, WriteViolationDoubleAttribute)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeViolationAttribute(oss, "key", 1.23);
     EXPECT_THAT(oss.str(), StrEq(" key=\"1.23\""));
 }
 
 TEST_F(XMLReporterTest, WriteViolationStringAttribute)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeViolationAttribute(oss, "key", "value");
     EXPECT_THAT(oss.str(), StrEq(" key=\"value\""));
 }
@@ -81,7 +82,7 @@ TEST_F(XMLReporterTest, WriteViolationStringAttribute)
 TEST_F(XMLReporterTest, WriteSummary)
 {
     Results *restults = getTestResults();
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeSummary(oss, *restults);
     EXPECT_THAT(oss.str(), StartsWith("<summary>"));
     EXPECT_THAT(oss.str(), HasSubstr("<property name=\"number of files\">0</property>"));
@@ -93,21 +94,21 @@ TEST_F(XMLReporterTest, WriteSummary)
 
 TEST_F(XMLReporterTest, WriteSummaryIntProperty)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeSummaryProperty(oss, "key", 1);
     EXPECT_THAT(oss.str(), StrEq("<property name=\"key\">1</property>"));
 }
 
 TEST_F(XMLReporterTest, WriteSummaryDoubleProperty)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeSummaryProperty(oss, "key", 1.23);
     EXPECT_THAT(oss.str(), StrEq("<property name=\"key\">1.23</property>"));
 }
 
 TEST_F(XMLReporterTest, WriteSummaryStringProperty)
 {
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeSummaryProperty(oss, "key", "value");
     EXPECT_THAT(oss.str(), StrEq("<property name=\"key\">value</property>"));
 }
@@ -4,6 +4,7 @@
 #include <gmock/gmock.h>
 
 #include "ReportTestResults.h"
+#include "TestReportWriter.h"
 #include "XcodeReporter.cpp"
 
 using namespace ::testing;
@@ -33,7 +34,7 @@ TEST_F(XcodeReporterTest, WriteViolation)
 {
     RuleBase *rule = new MockRuleBase();
     Violation violation(rule, "test path", 1, 2, 3, 4, "test message");
-    std::ostringstream oss;
+    TestReportWriter oss;
     reporter.writeViolation(oss, violation);
     EXPECT_THAT(oss.str(), HasSubstr(": warning: "));
     EXPECT_THAT(oss.str(), HasSubstr("test path"));
@@ -24,6 +24,12 @@ protected:
     void addViolation(const clang::Decl *decl, RuleBase *rule, const std::string& message = "");
     void addViolation(const clang::Stmt *stmt, RuleBase *rule, const std::string& message = "");
 
+    /*
+     * Top-level declarations of the main file are traversed. In a diff-scoped run, only
+     * those that also intersect a changed hunk are.
+     */
+    bool shouldTraverse(const clang::Decl *decl);
+
 private:
     bool supportsC() const;
     bool supportsCXX() const;
@@ -35,6 +41,8 @@ protected:
 
 public:
     virtual ~AbstractASTRuleBase();
+
+    virtual bool isApplicable(const clang::LangOptions &langOptions) const override;
 };
 
 } // end namespace oclint
@@ -21,14 +21,11 @@ protected:
         }
 
         setUp();
-        clang::SourceManager *sourceManager = &_carrier->getSourceManager();
         clang::DeclContext *decl = _carrier->getTranslationUnitDecl();
         for (clang::DeclContext::decl_iterator it = decl->decls_begin(), declEnd = decl->decls_end();
-            it != declEnd; ++it)
+            it != declEnd && !_carrier->isCancelled(); ++it)
         {
-            clang::SourceLocation startLocation = (*it)->getLocStart();
-            if (startLocation.isValid() &&
-                sourceManager->getMainFileID() == sourceManager->getFileID(startLocation))
+            if (shouldTraverse(*it))
             {
                 (void) /* explicitly ignore the return of this function */
                     clang::RecursiveASTVisitor<T>::TraverseDecl(*it);
@@ -37,6 +34,18 @@ protected:
         tearDown();
     }
 
+    /* a single top-level declaration can hold many bodies, so the deadline is checked
+     * again before each function and method */
+    bool TraverseDecl(clang::Decl *decl)
+    {
+        if (decl && (clang::isa<clang::FunctionDecl>(decl) ||
+            clang::isa<clang::ObjCMethodDecl>(decl)) && _carrier->isCancelled())
+        {
+            return false;
+        }
+        return clang::RecursiveASTVisitor<T>::TraverseDecl(decl);
+    }
+
 public:
     virtual ~AbstractASTVisitorRule() {}
 
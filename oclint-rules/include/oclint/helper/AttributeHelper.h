@@ -4,17 +4,24 @@
 #include <string>
 
 namespace clang { class Decl; }
-namespace oclint { class RuleBase; }
+namespace oclint { class RuleBase; class RuleCarrier; }
+
+/*
+ * The annotations of a declaration are parsed once per translation unit and kept in
+ * a table owned by the carrier, so repeated lookups neither reparse nor allocate.
+ */
 
 bool declHasOCLintAttribute(
     const clang::Decl *decl,
     const std::string& attributeName,
+    oclint::RuleCarrier& carrier,
     std::string* comment = nullptr);
 
 bool declHasActionAttribute(
     const clang::Decl *decl,
     const std::string& action,
     const oclint::RuleBase& rule,
+    oclint::RuleCarrier& carrier,
     std::string* comment = nullptr);
 
 #endif
@@ -2,13 +2,49 @@
 #define OCLINT_HELPER_ENFORCEHELPER_H
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
-namespace clang { class Decl; }
-namespace oclint { class RuleBase; }
+#include <clang/Basic/IdentifierTable.h>
+
+namespace clang { class Decl; class ObjCInterfaceDecl; class ObjCMethodDecl; }
+namespace oclint { class RuleBase; class RuleCarrier; }
 
 bool declHasEnforceAttribute(
     const clang::Decl *decl,
     const oclint::RuleBase& rule,
+    oclint::RuleCarrier& carrier,
     std::string* comment = nullptr);
 
+/*
+ * The methods carrying the enforce attribute of a rule, as seen by one class. Declared
+ * methods are those of the class interface and its categories, in declaration order.
+ * Inherited methods are the declared methods of all superclasses and the methods of
+ * the protocols the class or its categories adopt, looked up by selector.
+ */
+class EnforcedMethods
+{
+private:
+    std::vector<const clang::ObjCMethodDecl *> _declared;
+    std::unordered_map<void *, const clang::ObjCMethodDecl *> _inheritedInstanceMethods;
+    std::unordered_map<void *, const clang::ObjCMethodDecl *> _inheritedClassMethods;
+
+public:
+    const std::vector<const clang::ObjCMethodDecl *> &declared() const;
+    const clang::ObjCMethodDecl *inherited(clang::Selector selector, bool isInstance) const;
+
+    void addDeclared(const clang::ObjCMethodDecl *method);
+    void addInherited(const clang::ObjCMethodDecl *method);
+    void inheritFrom(const EnforcedMethods &superClass);
+};
+
+/*
+ * Computed once per class and rule in a translation unit, by extending the result of
+ * the superclass, so checking all the classes of a hierarchy is linear in its size.
+ */
+const EnforcedMethods &classEnforcedMethods(
+    const clang::ObjCInterfaceDecl *decl,
+    const oclint::RuleBase& rule,
+    oclint::RuleCarrier& carrier);
+
 #endif
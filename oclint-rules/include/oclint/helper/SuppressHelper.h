@@ -4,10 +4,11 @@
 #include <clang/AST/AST.h>
 
 #include "oclint/RuleBase.h"
+#include "oclint/RuleCarrier.h"
 
-bool shouldSuppress(const clang::Decl *decl, clang::ASTContext &context, oclint::RuleBase *rule);
-bool shouldSuppress(const clang::Stmt *stmt, clang::ASTContext &context, oclint::RuleBase *rule);
-bool shouldSuppress(int beginLine, clang::ASTContext& context,
+bool shouldSuppress(const clang::Decl *decl, oclint::RuleCarrier &carrier, oclint::RuleBase *rule);
+bool shouldSuppress(const clang::Stmt *stmt, oclint::RuleCarrier &carrier, oclint::RuleBase *rule);
+bool shouldSuppress(int beginLine, oclint::RuleCarrier &carrier,
                     oclint::RuleBase* rule = nullptr);
 
 #endif
@@ -0,0 +1,45 @@
+#ifndef OCLINT_UTIL_FUNCTIONMETRICSSTORE_H
+#define OCLINT_UTIL_FUNCTIONMETRICSSTORE_H
+
+#include <unordered_map>
+
+#include <clang/AST/AST.h>
+
+#include "oclint/RuleCarrier.h"
+#include "oclint/metric/CombinedMetric.h"
+#include "oclint/metric/StmtDepthMetric.h"
+
+/**
+ * Metrics of the functions and methods of a translation unit. All the metrics of a
+ * declaration are computed together by a single pass over its body the first time a
+ * rule asks for one of them, and are then shared by all the rules applied to the
+ * same translation unit.
+ */
+class FunctionMetricsStore : public oclint::TranslationUnitCache
+{
+private:
+    std::unordered_map<const clang::Decl *, oclint::FunctionMetrics> _metrics;
+    oclint::CompoundStmtDepthMap _compoundDepths;
+
+public:
+    explicit FunctionMetricsStore(oclint::RuleCarrier &carrier);
+
+    const oclint::FunctionMetrics &metrics(clang::Decl *decl);
+
+    int cyclomaticComplexity(clang::Decl *decl);
+    /*
+     * npath complexity, statement depth and line count are measured on the body; npath
+     * complexity saturates at the largest 64-bit value
+     */
+    int64_t nPathComplexity(clang::Decl *decl);
+    int ncss(clang::Decl *decl);
+    int stmtDepth(clang::Decl *decl);
+    int lineCount(clang::Decl *decl);
+
+    /* depth of any block, sharing the measurements made for the enclosing function */
+    int blockDepth(clang::CompoundStmt *stmt);
+};
+
+FunctionMetricsStore *getFunctionMetricsStore(oclint::RuleCarrier &carrier);
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef OCLINT_UTIL_OBJCHIERARCHYORACLE_H
+#define OCLINT_UTIL_OBJCHIERARCHYORACLE_H
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <clang/AST/AST.h>
+
+#include "oclint/RuleCarrier.h"
+
+/**
+ * Objective-C class hierarchy of a translation unit. The ancestors of a class and the
+ * selectors it declares are collected the first time a rule asks about the class, by
+ * extending those of its superclass, so every later question is a hash lookup. The
+ * declared selectors include the methods and property accessors of the interface, of
+ * its categories and extensions, of all their protocols, and of all superclasses.
+ */
+class ObjCHierarchyOracle : public oclint::TranslationUnitCache
+{
+private:
+    struct Ancestors
+    {
+        std::unordered_set<const clang::ObjCInterfaceDecl *> decls;
+        std::unordered_set<const clang::IdentifierInfo *> names;
+    };
+
+    struct SelectorSet
+    {
+        std::unordered_set<void *> instanceSelectors;
+        std::unordered_set<void *> classSelectors;
+
+        void add(clang::Selector selector, bool isInstance);
+        void add(const SelectorSet &other);
+        bool contains(clang::Selector selector, bool isInstance) const;
+    };
+
+    clang::IdentifierTable &_identifiers;
+    std::unordered_map<const clang::ObjCInterfaceDecl *, Ancestors> _ancestors;
+    std::unordered_map<const clang::ObjCInterfaceDecl *, SelectorSet> _classSelectors;
+    std::unordered_map<const clang::ObjCProtocolDecl *, SelectorSet> _protocolSelectors;
+
+    const Ancestors &ancestors(const clang::ObjCInterfaceDecl *decl);
+    const SelectorSet &classSelectors(const clang::ObjCInterfaceDecl *decl);
+    const SelectorSet &protocolSelectors(const clang::ObjCProtocolDecl *decl);
+    void addContainerSelectors(const clang::ObjCContainerDecl *container, SelectorSet &selectors);
+
+public:
+    explicit ObjCHierarchyOracle(oclint::RuleCarrier &carrier);
+
+    /* whether decl is the ancestor class itself or one of its direct or indirect subclasses */
+    bool isClassOrSubclass(const clang::ObjCInterfaceDecl *decl,
+        const clang::ObjCInterfaceDecl *ancestor);
+    bool isClassOrSubclass(const clang::ObjCInterfaceDecl *decl, const std::string &className);
+
+    bool classDeclaresMethod(const clang::ObjCInterfaceDecl *decl,
+        clang::Selector selector, bool isInstance);
+    bool classDeclaresMethod(const clang::ObjCInterfaceDecl *decl,
+        const clang::ObjCMethodDecl *method);
+    bool protocolDeclaresMethod(const clang::ObjCProtocolDecl *decl,
+        clang::Selector selector, bool isInstance);
+};
+
+ObjCHierarchyOracle *getObjCHierarchyOracle(oclint::RuleCarrier &carrier);
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef OCLINT_UTIL_OBJCSELECTORUSAGEINDEX_H
+#define OCLINT_UTIL_OBJCSELECTORUSAGEINDEX_H
+
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Objective-C methods defined and selectors referenced across translation units. Only
+ * interned names and locations are kept, so a translation unit can be summarized into
+ * its own index right after it is parsed and its AST released. Indexes of different
+ * translation units can be merged in any order. Methods are identified by class name,
+ * selector and kind. A reference made by a method to itself does not count as a use.
+ */
+class ObjCSelectorUsageIndex
+{
+public:
+    struct Method
+    {
+        std::string className;
+        std::string selector;
+        bool isInstance;
+    };
+
+    struct Location
+    {
+        std::string path;
+        int startLine;
+        int startColumn;
+        int endLine;
+        int endColumn;
+    };
+
+private:
+    struct MethodKey
+    {
+        unsigned className;
+        unsigned selector;
+        bool isInstance;
+
+        bool operator==(const MethodKey &other) const;
+    };
+
+    struct MethodKeyHash
+    {
+        size_t operator()(const MethodKey &key) const;
+    };
+
+    /* the first referrer, and whether another one exists */
+    struct Referrers
+    {
+        MethodKey first;
+        bool hasFirst;
+        bool hasOthers;
+
+        Referrers();
+        void add(const MethodKey &referrer);
+        void add(const Referrers &other);
+        bool includesOtherThan(const MethodKey &method) const;
+    };
+
+    struct LocationKey
+    {
+        unsigned path;
+        int startLine;
+        int startColumn;
+        int endLine;
+        int endColumn;
+    };
+
+    /* receiver class name, or noClass when the receiver is unknown, to its referrers */
+    typedef std::unordered_map<unsigned, Referrers> ReceiverReferrers;
+
+    static const unsigned noClass = 0;
+
+    std::vector<std::string> _names;
+    std::unordered_map<std::string, unsigned> _nameIds;
+    std::unordered_map<unsigned, unsigned> _superClasses;
+    std::unordered_map<MethodKey, LocationKey, MethodKeyHash> _candidates;
+    std::unordered_map<MethodKey, ReceiverReferrers, MethodKeyHash> _messages;
+    std::unordered_map<unsigned, Referrers> _selectorExpressions;
+
+    unsigned intern(const std::string &name);
+    MethodKey intern(const Method &method);
+    MethodKey translate(const MethodKey &key, const ObjCSelectorUsageIndex &other);
+    bool isClassOrSubclass(unsigned className, unsigned ancestor) const;
+    bool isReferenced(const MethodKey &method) const;
+
+    void write(std::ostream &out, const MethodKey &key) const;
+    void write(std::ostream &out, const Referrers &referrers) const;
+    bool read(std::istream &in, unsigned &name) const;
+    bool read(std::istream &in, MethodKey &key) const;
+    bool read(std::istream &in, Referrers &referrers) const;
+
+public:
+    ObjCSelectorUsageIndex();
+
+    void addSuperClass(const std::string &className, const std::string &superClassName);
+    /* a method that no superclass or adopted protocol declares, so it must be used somewhere */
+    void addCandidate(const Method &method, const Location &location);
+    /* an empty receiver class name stands for an unknown receiver */
+    void addMessage(const std::string &receiverClassName, const std::string &selector,
+        bool isInstance, const Method &referrer);
+    void addSelectorExpression(const std::string &selector, const Method &referrer);
+
+    void merge(const ObjCSelectorUsageIndex &other);
+    void clear();
+
+    /*
+     * A compact text form, so a summary can be kept apart from the process that made it.
+     * deserialize() returns false and leaves the index empty when the text is malformed.
+     */
+    std::string serialize() const;
+    bool deserialize(const std::string &serialized);
+
+    /* candidates that no translation unit references, ordered by location */
+    void forEachUnusedMethod(
+        const std::function<void (const Method &, const Location &)> &callback) const;
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef OCLINT_UTIL_SOURCELINEINDEX_H
+#define OCLINT_UTIL_SOURCELINEINDEX_H
+
+#include <vector>
+
+#include <llvm/ADT/StringRef.h>
+
+#include "oclint/RuleCarrier.h"
+
+/**
+ * Line table of the main file, built by a single scan of its buffer the first time
+ * a rule asks for it in a translation unit. The same scan records the offsets of the
+ * //!OCLINT suppression markers, so no comment list or regular expression is needed.
+ * It follows comments and string, character and raw string literals across lines,
+ * so a marker only counts where it starts a line comment.
+ */
+class SourceLineIndex : public oclint::TranslationUnitCache
+{
+private:
+    struct ScanState;
+
+    llvm::StringRef _buffer;
+    std::vector<unsigned> _lineOffsets;
+    std::vector<unsigned> _markerOffsets;
+
+    void scanLine(unsigned begin, unsigned end, ScanState &state);
+
+public:
+    explicit SourceLineIndex(oclint::RuleCarrier &carrier);
+
+    int numberOfLines() const;
+    /* lineNumber is one-based, the returned line excludes the line break */
+    llvm::StringRef line(int lineNumber) const;
+    /* offsets of the //!OCLINT markers in the main file buffer, in ascending order */
+    const std::vector<unsigned> &suppressMarkerOffsets() const;
+};
+
+SourceLineIndex *getSourceLineIndex(oclint::RuleCarrier &carrier);
+
+#endif
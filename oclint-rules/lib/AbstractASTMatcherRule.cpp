@@ -22,13 +22,13 @@ void AbstractASTMatcherRule::setUp()
 bool AbstractASTMatcherRule::VisitDecl(clang::Decl *decl)
 {
     _finder->match(*decl, *_carrier->getASTContext());
-    return true;
+    return !_carrier->isCancelled();
 }
 
 bool AbstractASTMatcherRule::VisitStmt(clang::Stmt *stmt)
 {
     _finder->match(*stmt, *_carrier->getASTContext());
-    return true;
+    return !_carrier->isCancelled();
 }
 
 /*virtual*/
@@ -15,7 +15,7 @@ void AbstractASTRuleBase::addViolation(clang::SourceLocation startLocation,
     clang::SourceLocation startFileLoc = sourceManager->getFileLoc(startLocation);
     clang::SourceLocation endFileLoc = sourceManager->getFileLoc(endLocation);
     int beginLine = sourceManager->getPresumedLineNumber(startFileLoc);
-    if (!shouldSuppress(beginLine, *_carrier->getASTContext()))
+    if (!shouldSuppress(beginLine, *_carrier))
     {
         llvm::StringRef filename = sourceManager->getFilename(startFileLoc);
         _carrier->addViolation(filename.str(),
@@ -31,7 +31,7 @@ void AbstractASTRuleBase::addViolation(clang::SourceLocation startLocation,
 void AbstractASTRuleBase::addViolation(const clang::Decl *decl,
     RuleBase *rule, const std::string& message)
 {
-    if (decl && !shouldSuppress(decl, *_carrier->getASTContext(), rule))
+    if (decl && !shouldSuppress(decl, *_carrier, rule))
     {
         addViolation(decl->getLocStart(), decl->getLocEnd(), rule, message);
     }
@@ -40,12 +40,33 @@ void AbstractASTRuleBase::addViolation(const clang::Decl *decl,
 void AbstractASTRuleBase::addViolation(const clang::Stmt *stmt,
     RuleBase *rule, const std::string& message)
 {
-    if (stmt && !shouldSuppress(stmt, *_carrier->getASTContext(), rule))
+    if (stmt && !shouldSuppress(stmt, *_carrier, rule))
     {
         addViolation(stmt->getLocStart(), stmt->getLocEnd(), rule, message);
     }
 }
 
+bool AbstractASTRuleBase::shouldTraverse(const clang::Decl *decl)
+{
+    clang::SourceManager *sourceManager = &_carrier->getSourceManager();
+    clang::SourceLocation startLocation = decl->getLocStart();
+    if (startLocation.isInvalid() ||
+        sourceManager->getMainFileID() != sourceManager->getFileID(startLocation))
+    {
+        return false;
+    }
+    if (!_carrier->hasChangedLines())
+    {
+        return true;
+    }
+    clang::SourceLocation startFileLoc = sourceManager->getFileLoc(startLocation);
+    clang::SourceLocation endFileLoc = sourceManager->getFileLoc(decl->getLocEnd());
+    // hunks are numbered by physical lines, so #line directives are not honored here
+    return _carrier->isInChangedLines(sourceManager->getFilename(startFileLoc).str(),
+        sourceManager->getSpellingLineNumber(startFileLoc),
+        sourceManager->getSpellingLineNumber(endFileLoc));
+}
+
 unsigned int AbstractASTRuleBase::supportedLanguages() const
 {
     return LANG_C | LANG_CXX | LANG_OBJC;
@@ -68,7 +89,11 @@ bool AbstractASTRuleBase::supportsObjC() const
 
 bool AbstractASTRuleBase::isLanguageSupported() const
 {
-    const auto &langOpts = _carrier->getASTContext()->getLangOpts();
+    return isApplicable(_carrier->getASTContext()->getLangOpts());
+}
+
+bool AbstractASTRuleBase::isApplicable(const clang::LangOptions &langOpts) const
+{
     if (langOpts.ObjC1)
     {
         return supportsObjC();
@@ -1,6 +1,7 @@
 #include "oclint/AbstractSourceCodeReaderRule.h"
 #include <clang/AST/AST.h>
 #include "oclint/helper/SuppressHelper.h"
+#include "oclint/util/SourceLineIndex.h"
 
 namespace oclint
 {
@@ -11,26 +12,26 @@ AbstractSourceCodeReaderRule::~AbstractSourceCodeReaderRule() {}
 /*virtual*/
 void AbstractSourceCodeReaderRule::apply()
 {
-    clang::SourceManager *sourceManager = &_carrier->getSourceManager();
-
-    clang::FileID mainFileID = sourceManager->getMainFileID();
-    llvm::StringRef mainFileStringRef = sourceManager->getBufferData(mainFileID);
-
-    llvm::StringRef remaining = mainFileStringRef;
-    int currentLineNumber = 1;
-    while (remaining.size() > 0)
+    std::string mainFilePath = _carrier->getMainFilePath();
+    if (!_carrier->isFileChanged(mainFilePath))
+    {
+        return;
+    }
+    SourceLineIndex *lineIndex = getSourceLineIndex(*_carrier);
+    for (int lineNumber = 1;
+        lineNumber <= lineIndex->numberOfLines() && !_carrier->isCancelled(); lineNumber++)
     {
-        std::pair<llvm::StringRef, llvm::StringRef> splitPair = remaining.split('\n');
-        llvm::StringRef currentLine = splitPair.first;
-        eachLine(currentLineNumber++, currentLine.str());
-        remaining = splitPair.second;
+        if (_carrier->isInChangedLines(mainFilePath, lineNumber, lineNumber))
+        {
+            eachLine(lineNumber, lineIndex->line(lineNumber).str());
+        }
     }
 }
 
 void AbstractSourceCodeReaderRule::addViolation(int startLine, int startColumn,
     int endLine, int endColumn, RuleBase *rule, const std::string& message)
 {
-    if (!shouldSuppress(startLine, *_carrier->getASTContext(), rule))
+    if (!shouldSuppress(startLine, *_carrier, rule))
     {
         clang::SourceManager *sourceManager = &_carrier->getSourceManager();
 
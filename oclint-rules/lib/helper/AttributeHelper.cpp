@@ -1,152 +1,215 @@
 #include "oclint/helper/AttributeHelper.h"
 
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <clang/AST/AST.h>
 #include <clang/AST/Attr.h>
 
 #include "oclint/RuleBase.h"
-
-bool attributeHasAnnotation(
-    const std::string& annotation,
-    const std::string& attributeName,
-    std::string* comment) {
-    // Unqualified actions must compare directly e.g. we don't want to return a match for 
-    // for 'oclint:suppress' when the annotation is 'oclint::suppress[foo]'
-    if(attributeName.find('[') == std::string::npos) {
-        return attributeName == annotation;
+#include "oclint/RuleCarrier.h"
+
+namespace {
+
+// An annotation of the form oclint:action[rule name][comment], where the rule name
+// and the comment are optional. All parts refer to the attribute storage of the AST.
+struct ParsedAnnotation {
+    llvm::StringRef action;
+    llvm::StringRef ruleName;
+    llvm::StringRef comment;
+    bool hasRuleName;
+    bool hasComment;
+};
+
+typedef std::vector<ParsedAnnotation> AnnotationVector;
+
+// Splits an attribute name like "enforce" or "enforce[rule name]" into its parts
+void splitAttributeName(llvm::StringRef attributeName,
+    llvm::StringRef& action, llvm::StringRef& ruleName, bool& hasRuleName) {
+    const auto ruleStart = attributeName.find('[');
+    const auto ruleEnd = attributeName.find(']', ruleStart);
+    hasRuleName = ruleStart != llvm::StringRef::npos && ruleEnd != llvm::StringRef::npos;
+    action = attributeName.substr(0, ruleStart);
+    if(hasRuleName) {
+        ruleName = attributeName.slice(ruleStart + 1, ruleEnd);
     }
-    
-    // Otherwise, check if the attributeName is a prefix of the annotation
-    // We need to check prefix and not equality in case there's a comment
-    if(annotation.length() < attributeName.length() ||
-        !std::equal(attributeName.begin(), attributeName.end(), annotation.begin())) {
+}
+
+bool parseAnnotation(llvm::StringRef annotation, ParsedAnnotation& parsed) {
+    if(!annotation.startswith("oclint:")) {
         return false;
     }
-    // The attributes match.
-    // Try to pick out a comment if we need to
-    if(comment != nullptr) {
-        const auto commentStart = annotation.find('[', attributeName.length());
-    
-        if(commentStart != std::string::npos && annotation.back() == ']') {
-            *comment =
-               annotation.substr(commentStart + 1, annotation.length() - commentStart - 2);
-        }
+    const llvm::StringRef attributeName = annotation.drop_front(sizeof("oclint:") - 1);
+    splitAttributeName(attributeName, parsed.action, parsed.ruleName, parsed.hasRuleName);
+    parsed.hasComment = false;
+    if(!parsed.hasRuleName) {
+        // An unterminated rule name can never match, unqualified actions have no comment
+        return attributeName.find('[') == llvm::StringRef::npos;
+    }
+
+    const llvm::StringRef rest =
+        attributeName.substr(parsed.action.size() + parsed.ruleName.size() + 2);
+    const auto commentStart = rest.find('[');
+    if(commentStart != llvm::StringRef::npos && annotation.back() == ']') {
+        parsed.comment = rest.slice(commentStart + 1, rest.size() - 1);
+        parsed.hasComment = true;
     }
     return true;
 }
 
-bool declHasAttribute(
-    const clang::Decl *decl,
-    const std::string& attributeName,
-    std::string* comment) {
-    if (!decl)
-    {
-        return false;
+class DeclAnnotationTable : public oclint::TranslationUnitCache {
+private:
+    std::unordered_map<const clang::Decl*, AnnotationVector> _ownAnnotations;
+    std::unordered_map<const clang::Decl*, AnnotationVector> _inheritedAnnotations;
+    std::unordered_map<const oclint::RuleBase*, std::string> _attributeNames;
+
+    void appendOwnAnnotations(const clang::Decl* decl, AnnotationVector& annotations) {
+        const auto& own = ownAnnotations(decl);
+        annotations.insert(annotations.end(), own.begin(), own.end());
     }
 
-    for (auto attr = decl->specific_attr_begin<clang::AnnotateAttr>(),
-        attrEnd = decl->specific_attr_end<clang::AnnotateAttr>();
-        attr != attrEnd;
-        ++attr)
-    {
-        const clang::AnnotateAttr *annotate = clang::dyn_cast<clang::AnnotateAttr>(*attr);
-        if (!annotate) {
-            continue;
+    void appendMethodAnnotations(const clang::ObjCMethodDecl* method,
+        AnnotationVector& annotations) {
+        if(method == nullptr) {
+            return;
         }
-        
-        const std::string annotation = annotate->getAnnotation();
-        if(attributeHasAnnotation(annotation, attributeName, comment)) {
-            return true;
+        appendOwnAnnotations(method, annotations);
+        if(method->isPropertyAccessor()) {
+            appendOwnAnnotations(method->findPropertyDecl(), annotations);
         }
     }
 
-    return false;
-}
+    // Collects, in lookup order, the annotations of the method, of its property, and of
+    // its declarations in the protocol or in the categories of its class
+    void collectInheritedAnnotations(const clang::ObjCMethodDecl* decl,
+        AnnotationVector& annotations) {
+        appendMethodAnnotations(decl, annotations);
+
+        // A method of a protocol doesn't have a class interface
+        const auto protocol = clang::dyn_cast<clang::ObjCProtocolDecl>(decl->getDeclContext());
+        if(protocol) {
+            appendOwnAnnotations(
+                protocol->lookupMethod(decl->getSelector(), decl->isInstanceMethod()),
+                annotations);
+            return;
+        }
 
-bool declHasOCLintAttribute(
-    const clang::Decl *decl,
-    const std::string& attributeName,
-    std::string* comment) {
-    return declHasAttribute(decl, "oclint:" + attributeName, comment);
-}
+        // If the method is already from a category, we don't need to traverse any other
+        // categories, otherwise use its redeclarations in the categories
+        const auto interface = decl->getClassInterface();
+        if(clang::dyn_cast<clang::ObjCCategoryDecl>(decl->getDeclContext()) || !interface) {
+            return;
+        }
+        for(auto it = interface->visible_categories_begin(),
+                 ite = interface->visible_categories_end();
+                 it != ite;
+                 ++it) {
+            appendMethodAnnotations(
+                (*it)->getMethod(decl->getSelector(), decl->isInstanceMethod()), annotations);
+        }
+    }
 
-bool baseDeclHasActionAttributeImpl (
-    const clang::Decl *decl,
-    const std::string& action,
-    const oclint::RuleBase& rule,
-    std::string* comment) {
-    return declHasOCLintAttribute(decl, action + "[" + rule.attributeName() + "]", comment);
-}
+public:
+    explicit DeclAnnotationTable(oclint::RuleCarrier&) {}
 
-bool objCMethodDeclHasAttributeFromCategory(
-    const clang::ObjCMethodDecl *decl,
-    const std::string& action,
-    const oclint::RuleBase& rule,
-    std::string* comment) {
-    // If the method is already from a category, we don't need to traverse any other categories
-    if(clang::dyn_cast<clang::ObjCCategoryDecl>(decl->getDeclContext())) {
-        return false;
+    const AnnotationVector& ownAnnotations(const clang::Decl* decl) {
+        auto it = _ownAnnotations.find(decl);
+        if(it != _ownAnnotations.end()) {
+            return it->second;
+        }
+
+        AnnotationVector annotations;
+        if(decl) {
+            for(const auto annotate : decl->specific_attrs<clang::AnnotateAttr>()) {
+                ParsedAnnotation parsed;
+                if(parseAnnotation(annotate->getAnnotation(), parsed)) {
+                    annotations.push_back(parsed);
+                }
+            }
+        }
+        return _ownAnnotations.emplace(decl, std::move(annotations)).first->second;
     }
 
-    // But if we're not, check if it has a redeclaration in a category and use that
-    const auto interface = decl->getClassInterface();
-    if(!interface) {
-        return false;
+    const AnnotationVector& inheritedAnnotations(const clang::Decl* decl) {
+        const auto method = clang::dyn_cast_or_null<clang::ObjCMethodDecl>(decl);
+        if(!method) {
+            return ownAnnotations(decl);
+        }
+
+        auto it = _inheritedAnnotations.find(method);
+        if(it != _inheritedAnnotations.end()) {
+            return it->second;
+        }
+
+        AnnotationVector annotations;
+        collectInheritedAnnotations(method, annotations);
+        return _inheritedAnnotations.emplace(method, std::move(annotations)).first->second;
     }
 
-    for(auto it = interface->visible_categories_begin(),
-             ite = interface->visible_categories_end();
-             it != ite;
-             ++it) {
-        clang::ObjCMethodDecl* categoryMethodDecl =
-            (*it)->getMethod(decl->getSelector(), decl->isInstanceMethod());
-        if(declHasActionAttribute(categoryMethodDecl, action, rule, comment)) {
-            return true;
+    llvm::StringRef attributeName(const oclint::RuleBase& rule) {
+        auto it = _attributeNames.find(&rule);
+        if(it == _attributeNames.end()) {
+            it = _attributeNames.emplace(&rule, rule.attributeName()).first;
         }
+        return it->second;
     }
-    return false;
+};
+
+DeclAnnotationTable* getAnnotationTable(oclint::RuleCarrier& carrier) {
+    return carrier.getCache<DeclAnnotationTable>("AttributeHelper");
 }
 
-bool objCMethodDeclHasActionAttributeImpl(
-    const clang::ObjCMethodDecl *decl,
-    const std::string& action,
-    const oclint::RuleBase& rule,
+bool annotationsContain(
+    const AnnotationVector& annotations,
+    llvm::StringRef action,
+    llvm::StringRef ruleName,
+    bool hasRuleName,
     std::string* comment) {
-    if(decl == nullptr) {
-        return false;
-    }
-
-    // Check the method directly
-    if(baseDeclHasActionAttributeImpl(decl, action, rule, comment)) {
+    for(const auto& annotation : annotations) {
+        if(annotation.action != action || annotation.hasRuleName != hasRuleName ||
+            (hasRuleName && annotation.ruleName != ruleName)) {
+            continue;
+        }
+        if(comment != nullptr && annotation.hasComment) {
+            *comment = annotation.comment.str();
+        }
         return true;
     }
+    return false;
+}
 
-    // That failed, check if it has a property declaration and use that
-    if(decl->isPropertyAccessor() &&
-       baseDeclHasActionAttributeImpl(decl->findPropertyDecl(), action, rule, comment)) {
-        return true;
-    }
-  
-    // Check if the method comes from a protocol, because then it doesn't have a class
-    // interface
-    const auto protocol = clang::dyn_cast<clang::ObjCProtocolDecl>(decl->getDeclContext());
-    if(protocol) {
-       const auto method = protocol->lookupMethod(decl->getSelector(), decl->isInstanceMethod());
-       return baseDeclHasActionAttributeImpl(method, action, rule, comment);
+} // end namespace
+
+bool declHasOCLintAttribute(
+    const clang::Decl *decl,
+    const std::string& attributeName,
+    oclint::RuleCarrier& carrier,
+    std::string* comment) {
+    if (!decl)
+    {
+        return false;
     }
- 
-    return objCMethodDeclHasAttributeFromCategory(decl, action, rule, comment);
 
+    llvm::StringRef action, ruleName;
+    bool hasRuleName;
+    splitAttributeName(attributeName, action, ruleName, hasRuleName);
+    return annotationsContain(getAnnotationTable(carrier)->ownAnnotations(decl),
+        action, ruleName, hasRuleName, comment);
 }
 
 bool declHasActionAttribute(
     const clang::Decl *decl,
     const std::string& action,
     const oclint::RuleBase& rule,
+    oclint::RuleCarrier& carrier,
     std::string* comment) {
-    const clang::ObjCMethodDecl* method = clang::dyn_cast_or_null<clang::ObjCMethodDecl>(decl);
-    if(method) {
-        return objCMethodDeclHasActionAttributeImpl(method, action, rule, comment);
+    if (!decl)
+    {
+        return false;
     }
-    return baseDeclHasActionAttributeImpl(decl, action, rule, comment);
-}
 
+    DeclAnnotationTable* table = getAnnotationTable(carrier);
+    return annotationsContain(table->inheritedAnnotations(decl),
+        action, table->attributeName(rule), true, comment);
+}
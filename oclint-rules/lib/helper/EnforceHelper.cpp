@@ -1,11 +1,152 @@
 #include "oclint/helper/EnforceHelper.h"
 
+#include <utility>
+
+#include <clang/AST/AST.h>
+
+#include "oclint/RuleCarrier.h"
 #include "oclint/helper/AttributeHelper.h"
 
 bool declHasEnforceAttribute(
     const clang::Decl *decl,
     const oclint::RuleBase& rule,
+    oclint::RuleCarrier& carrier,
     std::string* comment) {
-    return declHasActionAttribute(decl, "enforce", rule, comment);
+    return declHasActionAttribute(decl, "enforce", rule, carrier, comment);
+}
+
+const std::vector<const clang::ObjCMethodDecl *> &EnforcedMethods::declared() const {
+    return _declared;
 }
 
+const clang::ObjCMethodDecl *EnforcedMethods::inherited(
+    clang::Selector selector, bool isInstance) const {
+    const auto& methods = isInstance ? _inheritedInstanceMethods : _inheritedClassMethods;
+    const auto found = methods.find(selector.getAsOpaquePtr());
+    return found == methods.end() ? nullptr : found->second;
+}
+
+void EnforcedMethods::addDeclared(const clang::ObjCMethodDecl *method) {
+    for(const auto declared : _declared) {
+        if(declared->getSelector() == method->getSelector() &&
+            declared->isInstanceMethod() == method->isInstanceMethod()) {
+            return;
+        }
+    }
+    _declared.push_back(method);
+}
+
+void EnforcedMethods::addInherited(const clang::ObjCMethodDecl *method) {
+    auto& methods = method->isInstanceMethod() ? _inheritedInstanceMethods : _inheritedClassMethods;
+    methods.emplace(method->getSelector().getAsOpaquePtr(), method);
+}
+
+void EnforcedMethods::inheritFrom(const EnforcedMethods &superClass) {
+    _inheritedInstanceMethods = superClass._inheritedInstanceMethods;
+    _inheritedClassMethods = superClass._inheritedClassMethods;
+    for(const auto method : superClass._declared) {
+        auto& methods = method->isInstanceMethod() ?
+            _inheritedInstanceMethods : _inheritedClassMethods;
+        // the nearest declaration wins
+        methods[method->getSelector().getAsOpaquePtr()] = method;
+    }
+}
+
+namespace {
+
+typedef std::vector<const clang::ObjCMethodDecl *> MethodVector;
+
+class EnforcedMethodTable : public oclint::TranslationUnitCache {
+private:
+    oclint::RuleCarrier& _carrier;
+    std::unordered_map<const oclint::RuleBase*,
+        std::unordered_map<const clang::ObjCInterfaceDecl*, EnforcedMethods>> _classes;
+    std::unordered_map<const oclint::RuleBase*,
+        std::unordered_map<const clang::ObjCProtocolDecl*, MethodVector>> _protocols;
+
+    template <typename Container>
+    void collectEnforced(const Container* container, const oclint::RuleBase& rule,
+        MethodVector& methods) {
+        for(auto it = container->meth_begin(); it != container->meth_end(); ++it) {
+            if(declHasEnforceAttribute(*it, rule, _carrier)) {
+                methods.push_back(*it);
+            }
+        }
+    }
+
+    template <typename Iterator>
+    void inheritFromProtocols(Iterator begin, Iterator end, const oclint::RuleBase& rule,
+        EnforcedMethods& methods) {
+        for(auto it = begin; it != end; ++it) {
+            for(const auto method : protocolEnforcedMethods(*it, rule)) {
+                methods.addInherited(method);
+            }
+        }
+    }
+
+    const MethodVector& protocolEnforcedMethods(const clang::ObjCProtocolDecl* decl,
+        const oclint::RuleBase& rule) {
+        decl = decl->getCanonicalDecl();
+        auto& protocols = _protocols[&rule];
+        auto known = protocols.find(decl);
+        if(known != protocols.end()) {
+            return known->second;
+        }
+
+        MethodVector methods;
+        const auto definition = decl->getDefinition();
+        if(definition) {
+            collectEnforced(definition, rule, methods);
+            for(auto it = definition->protocol_begin(); it != definition->protocol_end(); ++it) {
+                const auto& inherited = protocolEnforcedMethods(*it, rule);
+                methods.insert(methods.end(), inherited.begin(), inherited.end());
+            }
+        }
+        return protocols.emplace(decl, std::move(methods)).first->second;
+    }
+
+public:
+    explicit EnforcedMethodTable(oclint::RuleCarrier& carrier) : _carrier(carrier) {}
+
+    const EnforcedMethods& classEnforcedMethods(const clang::ObjCInterfaceDecl* decl,
+        const oclint::RuleBase& rule) {
+        decl = decl->getCanonicalDecl();
+        auto& classes = _classes[&rule];
+        auto known = classes.find(decl);
+        if(known != classes.end()) {
+            return known->second;
+        }
+
+        EnforcedMethods methods;
+        const auto superClass = decl->getSuperClass();
+        if(superClass) {
+            methods.inheritFrom(classEnforcedMethods(superClass, rule));
+        }
+        const auto definition = decl->getDefinition();
+        if(definition) {
+            MethodVector declared;
+            collectEnforced(definition, rule, declared);
+            inheritFromProtocols(definition->all_referenced_protocol_begin(),
+                definition->all_referenced_protocol_end(), rule, methods);
+            for(auto it = definition->visible_categories_begin();
+                it != definition->visible_categories_end(); ++it) {
+                collectEnforced(*it, rule, declared);
+                inheritFromProtocols((*it)->protocol_begin(), (*it)->protocol_end(),
+                    rule, methods);
+            }
+            for(const auto method : declared) {
+                methods.addDeclared(method);
+            }
+        }
+        return classes.emplace(decl, std::move(methods)).first->second;
+    }
+};
+
+} // end namespace
+
+const EnforcedMethods &classEnforcedMethods(
+    const clang::ObjCInterfaceDecl *decl,
+    const oclint::RuleBase& rule,
+    oclint::RuleCarrier& carrier) {
+    return carrier.getCache<EnforcedMethodTable>("EnforceHelper")->classEnforcedMethods(decl, rule);
+}
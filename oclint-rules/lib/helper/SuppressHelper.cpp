@@ -1,29 +1,30 @@
 #include "oclint/helper/SuppressHelper.h"
 
-#include <regex>
-#include <set>
+#include <algorithm>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <clang/AST/RecursiveASTVisitor.h>
 
 #include "oclint/RuleCarrier.h"
 
 #include "oclint/helper/AttributeHelper.h"
+#include "oclint/util/SourceLineIndex.h"
 
-bool markedAsSuppress(const clang::Decl *decl, oclint::RuleBase *rule)
+bool markedAsSuppress(const clang::Decl *decl, oclint::RuleCarrier &carrier, oclint::RuleBase *rule)
 {
     if(rule) {
-        return declHasOCLintAttribute(decl, "suppress")
-            || declHasActionAttribute(decl, "suppress", *rule);
+        return declHasOCLintAttribute(decl, "suppress", carrier)
+            || declHasActionAttribute(decl, "suppress", *rule, carrier);
     }
     return false;
 }
 
 template <typename T>
-bool markedParentsAsSuppress(const T &node, clang::ASTContext &context, oclint::RuleBase *rule)
+bool markedParentsAsSuppress(const T &node, oclint::RuleCarrier &carrier, oclint::RuleBase *rule)
 {
-    const auto &parents = context.getParents(node);
+    const auto &parents = carrier.getASTContext()->getParents(node);
     if (parents.empty())
     {
         return false;
@@ -33,48 +34,50 @@ bool markedParentsAsSuppress(const T &node, clang::ASTContext &context, oclint::
     const clang::Decl *aDecl = dynTypedNode->get<clang::Decl>();
     if (aDecl)
     {
-        if (markedAsSuppress(aDecl, rule))
+        if (markedAsSuppress(aDecl, carrier, rule))
         {
             return true;
         }
-        return markedParentsAsSuppress(*aDecl, context, rule);
+        return markedParentsAsSuppress(*aDecl, carrier, rule);
     }
     const clang::Stmt *aStmt = dynTypedNode->get<clang::Stmt>();
     if (aStmt)
     {
-        return markedParentsAsSuppress(*aStmt, context, rule);
+        return markedParentsAsSuppress(*aStmt, carrier, rule);
     }
 
     return false;
 }
 
-bool shouldSuppress(const clang::Decl *decl, clang::ASTContext &context, oclint::RuleBase *rule)
+bool shouldSuppress(const clang::Decl *decl, oclint::RuleCarrier &carrier, oclint::RuleBase *rule)
 {
-    return markedAsSuppress(decl, rule) || markedParentsAsSuppress(*decl, context, rule);
+    return markedAsSuppress(decl, carrier, rule) || markedParentsAsSuppress(*decl, carrier, rule);
 }
 
-bool shouldSuppress(const clang::Stmt *stmt, clang::ASTContext &context, oclint::RuleBase *rule)
+bool shouldSuppress(const clang::Stmt *stmt, oclint::RuleCarrier &carrier, oclint::RuleBase *rule)
 {
-    return markedParentsAsSuppress(*stmt, context, rule);
+    return markedParentsAsSuppress(*stmt, carrier, rule);
 }
 
-typedef std::set<std::pair<int, int>> RangeSet;
+typedef std::vector<std::pair<int, int>> RangeVector;
 
 class DeclAnnotationRangeCollector : public clang::RecursiveASTVisitor<DeclAnnotationRangeCollector>
 {
 private:
+    oclint::RuleCarrier *_carrier;
     oclint::RuleBase *_rule;
     clang::SourceManager *_sourceManager;
-    RangeSet _range;
+    RangeVector _ranges;
 
 public:
-    RangeSet collect(clang::ASTContext &astContext, oclint::RuleBase *rule)
+    RangeVector collect(oclint::RuleCarrier &carrier, oclint::RuleBase *rule)
     {
+        _carrier = &carrier;
         _rule = rule;
-        _sourceManager = &astContext.getSourceManager();
-        _range.clear();
+        _sourceManager = &carrier.getSourceManager();
+        _ranges.clear();
 
-        clang::DeclContext *decl = astContext.getTranslationUnitDecl();
+        clang::DeclContext *decl = carrier.getTranslationUnitDecl();
         for (clang::DeclContext::decl_iterator declIt = decl->decls_begin(),
             declEnd = decl->decls_end(); declIt != declEnd; ++declIt)
         {
@@ -87,105 +90,126 @@ public:
             }
         }
 
-        return _range;
+        return mergeRanges();
     }
 
     bool VisitDecl(clang::Decl *decl)
     {
-        if (markedAsSuppress(decl, _rule))
+        if (markedAsSuppress(decl, *_carrier, _rule))
         {
             clang::SourceLocation startLocation = decl->getLocStart();
             clang::SourceLocation endLocation = decl->getLocEnd();
-            unsigned startLineNumber = _sourceManager->getPresumedLineNumber(startLocation);
-            unsigned endLineNumber = _sourceManager->getPresumedLineNumber(endLocation);
-            _range.insert(std::make_pair(startLineNumber, endLineNumber));
+            int startLineNumber = _sourceManager->getPresumedLineNumber(startLocation);
+            int endLineNumber = _sourceManager->getPresumedLineNumber(endLocation);
+            _ranges.push_back(std::make_pair(startLineNumber, endLineNumber));
         }
 
         return true;
     }
-};
-
-std::string getMainFilePath(clang::ASTContext &context)
-{
-    oclint::RuleCarrier ruleCarrier(&context, nullptr);
-    return ruleCarrier.getMainFilePath();
-}
-
-typedef std::unordered_map<std::string, std::set<int>> LineMap;
-static LineMap singleLineMapping;
 
-bool lineBasedShouldSuppress(int beginLine, clang::ASTContext &context)
-{
-    std::string filePath = getMainFilePath(context);
-    auto commentLinesIt = singleLineMapping.find(filePath);
-    std::set<int> commentLines;
-    if (commentLinesIt == singleLineMapping.end())
+private:
+    /* sorted, disjoint ranges allow a binary search for every lookup */
+    RangeVector mergeRanges()
     {
-        clang::RawCommentList commentList = context.getRawCommentList();
-        clang::ArrayRef<clang::RawComment *> commentArray = commentList.getComments();
-
-        for (auto comment : commentArray)
+        std::sort(_ranges.begin(), _ranges.end());
+        RangeVector merged;
+        for (const auto &range : _ranges)
         {
-// g++ 4.8 on Ubuntu 14.04 LTS doesn't support regex yet,
-// so we will ship this once Ubuntu 16.04 releases
-#if defined(__APPLE__) || defined(__MACH__)
-            std::string commentString = comment->getRawText(context.getSourceManager()).str();
-            std::regex oclintRegex =
-                std::regex("//! *OCLINT", std::regex::basic | std::regex::icase);
-            if (std::regex_search(commentString, oclintRegex))
-#else
-            if (std::string::npos !=
-                comment->getRawText(context.getSourceManager()).find("//!OCLINT"))
-#endif
+            if (!merged.empty() && range.first <= merged.back().second + 1)
+            {
+                merged.back().second = std::max(merged.back().second, range.second);
+            }
+            else
             {
-                clang::SourceLocation startLocation = comment->getLocStart();
-                int startLocationLine =
-                    context.getSourceManager().getPresumedLineNumber(startLocation);
-                commentLines.insert(startLocationLine);
+                merged.push_back(range);
             }
         }
-        singleLineMapping[filePath] = commentLines;
-    }
-    else
-    {
-        commentLines = commentLinesIt->second;
+        return merged;
     }
+};
 
-    return commentLines.find(beginLine) != commentLines.end();
-}
+/**
+ * Suppression information of one translation unit. The //!OCLINT comment lines come
+ * from the shared line index of the main file and serve all rules, while the annotated
+ * ranges are collected once for each rule, the first time a violation of that rule
+ * needs to be checked.
+ */
+class SuppressionCache : public oclint::TranslationUnitCache
+{
+private:
+    oclint::RuleCarrier &_carrier;
+    SourceLineIndex &_lineIndex;
+    bool _hasCommentLines;
+    std::vector<int> _commentLines;
+    std::unordered_map<const oclint::RuleBase *, RangeVector> _rangesByRule;
 
-typedef std::unordered_map<std::string, RangeSet> RangeMap;
-static RangeMap rangeMapping;
+public:
+    explicit SuppressionCache(oclint::RuleCarrier &carrier)
+        : _carrier(carrier), _lineIndex(*getSourceLineIndex(carrier)),
+        _hasCommentLines(false)
+    {
+    }
 
-bool rangeBasedShouldSuppress(int beginLine, clang::ASTContext &context, oclint::RuleBase *rule)
-{
-    std::string filePath = getMainFilePath(context);
-    auto commentRangesIt = rangeMapping.find(filePath);
-    RangeSet commentRanges;
-    if (commentRangesIt == rangeMapping.end())
+    const std::vector<int> &commentLines()
     {
-        DeclAnnotationRangeCollector annotationCollector;
-        commentRanges = annotationCollector.collect(context, rule);
-        rangeMapping[filePath] = commentRanges;
+        if (!_hasCommentLines)
+        {
+            collectCommentLines();
+            _hasCommentLines = true;
+        }
+        return _commentLines;
     }
-    else
+
+    const RangeVector &annotatedRanges(oclint::RuleBase *rule)
     {
-        commentRanges = commentRangesIt->second;
+        auto rangesIt = _rangesByRule.find(rule);
+        if (rangesIt == _rangesByRule.end())
+        {
+            DeclAnnotationRangeCollector annotationCollector;
+            rangesIt = _rangesByRule.emplace(rule, annotationCollector.collect(_carrier, rule)).first;
+        }
+        return rangesIt->second;
     }
 
-    for (const auto& range : commentRanges)
+private:
+    void collectCommentLines()
     {
-        if (beginLine >= range.first && beginLine <= range.second)
+        clang::SourceManager &sourceManager = _carrier.getSourceManager();
+        clang::SourceLocation startOfMainFile =
+            sourceManager.getLocForStartOfFile(sourceManager.getMainFileID());
+        for (unsigned offset : _lineIndex.suppressMarkerOffsets())
         {
-            return true;
+            _commentLines.push_back(
+                sourceManager.getPresumedLineNumber(startOfMainFile.getLocWithOffset(offset)));
         }
+        /* #line directives can make presumed line numbers go backwards */
+        std::sort(_commentLines.begin(), _commentLines.end());
+        _commentLines.erase(
+            std::unique(_commentLines.begin(), _commentLines.end()), _commentLines.end());
     }
+};
 
-    return false;
+SuppressionCache *getSuppressionCache(oclint::RuleCarrier &carrier)
+{
+    return carrier.getCache<SuppressionCache>("SuppressHelper");
+}
+
+bool lineBasedShouldSuppress(int beginLine, oclint::RuleCarrier &carrier)
+{
+    const std::vector<int> &commentLines = getSuppressionCache(carrier)->commentLines();
+    return std::binary_search(commentLines.begin(), commentLines.end(), beginLine);
+}
+
+bool rangeBasedShouldSuppress(int beginLine, oclint::RuleCarrier &carrier, oclint::RuleBase *rule)
+{
+    const RangeVector &ranges = getSuppressionCache(carrier)->annotatedRanges(rule);
+    auto rangeIt = std::upper_bound(ranges.begin(), ranges.end(), beginLine,
+        [](int line, const std::pair<int, int> &range) { return line < range.first; });
+    return rangeIt != ranges.begin() && beginLine <= (rangeIt - 1)->second;
 }
 
-bool shouldSuppress(int beginLine, clang::ASTContext &context, oclint::RuleBase *rule)
+bool shouldSuppress(int beginLine, oclint::RuleCarrier &carrier, oclint::RuleBase *rule)
 {
-    return lineBasedShouldSuppress(beginLine, context) ||
-        (rule && rangeBasedShouldSuppress(beginLine, context, rule));
+    return lineBasedShouldSuppress(beginLine, carrier) ||
+        (rule && rangeBasedShouldSuppress(beginLine, carrier, rule));
 }
@@ -0,0 +1,52 @@
+#include "oclint/util/FunctionMetricsStore.h"
+
+FunctionMetricsStore::FunctionMetricsStore(oclint::RuleCarrier &)
+{
+}
+
+const oclint::FunctionMetrics &FunctionMetricsStore::metrics(clang::Decl *decl)
+{
+    std::unordered_map<const clang::Decl *, oclint::FunctionMetrics>::iterator measured =
+        _metrics.find(decl);
+    if (measured == _metrics.end())
+    {
+        oclint::CombinedMetric combinedMetric(&_compoundDepths);
+        measured = _metrics.insert(std::make_pair(decl, combinedMetric.calculate(decl))).first;
+    }
+    return measured->second;
+}
+
+int FunctionMetricsStore::cyclomaticComplexity(clang::Decl *decl)
+{
+    return metrics(decl).cyclomaticComplexity;
+}
+
+int64_t FunctionMetricsStore::nPathComplexity(clang::Decl *decl)
+{
+    return metrics(decl).nPathComplexity;
+}
+
+int FunctionMetricsStore::ncss(clang::Decl *decl)
+{
+    return metrics(decl).ncss;
+}
+
+int FunctionMetricsStore::stmtDepth(clang::Decl *decl)
+{
+    return metrics(decl).stmtDepth;
+}
+
+int FunctionMetricsStore::lineCount(clang::Decl *decl)
+{
+    return metrics(decl).lineCount;
+}
+
+int FunctionMetricsStore::blockDepth(clang::CompoundStmt *stmt)
+{
+    return oclint::StmtDepthMetric(&_compoundDepths).depth(stmt);
+}
+
+FunctionMetricsStore *getFunctionMetricsStore(oclint::RuleCarrier &carrier)
+{
+    return carrier.getCache<FunctionMetricsStore>("FunctionMetricsStore");
+}
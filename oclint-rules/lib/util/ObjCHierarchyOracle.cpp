@@ -0,0 +1,179 @@
+#include "oclint/util/ObjCHierarchyOracle.h"
+
+void ObjCHierarchyOracle::SelectorSet::add(clang::Selector selector, bool isInstance)
+{
+    (isInstance ? instanceSelectors : classSelectors).insert(selector.getAsOpaquePtr());
+}
+
+void ObjCHierarchyOracle::SelectorSet::add(const SelectorSet &other)
+{
+    instanceSelectors.insert(other.instanceSelectors.begin(), other.instanceSelectors.end());
+    classSelectors.insert(other.classSelectors.begin(), other.classSelectors.end());
+}
+
+bool ObjCHierarchyOracle::SelectorSet::contains(clang::Selector selector, bool isInstance) const
+{
+    const std::unordered_set<void *> &selectors = isInstance ? instanceSelectors : classSelectors;
+    return selectors.find(selector.getAsOpaquePtr()) != selectors.end();
+}
+
+ObjCHierarchyOracle::ObjCHierarchyOracle(oclint::RuleCarrier &carrier)
+    : _identifiers(carrier.getASTContext()->Idents)
+{
+}
+
+const ObjCHierarchyOracle::Ancestors &ObjCHierarchyOracle::ancestors(
+    const clang::ObjCInterfaceDecl *decl)
+{
+    decl = decl->getCanonicalDecl();
+    auto known = _ancestors.find(decl);
+    if (known != _ancestors.end())
+    {
+        return known->second;
+    }
+
+    Ancestors result;
+    const clang::ObjCInterfaceDecl *superClass = decl->getSuperClass();
+    if (superClass)
+    {
+        result = ancestors(superClass);
+    }
+    result.decls.insert(decl);
+    result.names.insert(decl->getIdentifier());
+    return _ancestors.emplace(decl, std::move(result)).first->second;
+}
+
+void ObjCHierarchyOracle::addContainerSelectors(const clang::ObjCContainerDecl *container,
+    SelectorSet &selectors)
+{
+    for (auto method = container->meth_begin(); method != container->meth_end(); ++method)
+    {
+        selectors.add((*method)->getSelector(), (*method)->isInstanceMethod());
+    }
+    for (auto property = container->prop_begin(); property != container->prop_end(); ++property)
+    {
+        const clang::ObjCMethodDecl *getter = (*property)->getGetterMethodDecl();
+        if (getter)
+        {
+            selectors.add(getter->getSelector(), getter->isInstanceMethod());
+        }
+        const clang::ObjCMethodDecl *setter = (*property)->getSetterMethodDecl();
+        if (setter)
+        {
+            selectors.add(setter->getSelector(), setter->isInstanceMethod());
+        }
+    }
+}
+
+const ObjCHierarchyOracle::SelectorSet &ObjCHierarchyOracle::protocolSelectors(
+    const clang::ObjCProtocolDecl *decl)
+{
+    decl = decl->getCanonicalDecl();
+    auto known = _protocolSelectors.find(decl);
+    if (known != _protocolSelectors.end())
+    {
+        return known->second;
+    }
+
+    SelectorSet result;
+    const clang::ObjCProtocolDecl *definition = decl->getDefinition();
+    if (definition)
+    {
+        addContainerSelectors(definition, result);
+        for (auto protocol = definition->protocol_begin();
+            protocol != definition->protocol_end(); ++protocol)
+        {
+            result.add(protocolSelectors(*protocol));
+        }
+    }
+    return _protocolSelectors.emplace(decl, std::move(result)).first->second;
+}
+
+const ObjCHierarchyOracle::SelectorSet &ObjCHierarchyOracle::classSelectors(
+    const clang::ObjCInterfaceDecl *decl)
+{
+    decl = decl->getCanonicalDecl();
+    auto known = _classSelectors.find(decl);
+    if (known != _classSelectors.end())
+    {
+        return known->second;
+    }
+
+    SelectorSet result;
+    const clang::ObjCInterfaceDecl *superClass = decl->getSuperClass();
+    if (superClass)
+    {
+        result = classSelectors(superClass);
+    }
+    const clang::ObjCInterfaceDecl *definition = decl->getDefinition();
+    if (definition)
+    {
+        addContainerSelectors(definition, result);
+        for (auto protocol = definition->all_referenced_protocol_begin();
+            protocol != definition->all_referenced_protocol_end(); ++protocol)
+        {
+            result.add(protocolSelectors(*protocol));
+        }
+        for (auto category = definition->visible_categories_begin();
+            category != definition->visible_categories_end(); ++category)
+        {
+            addContainerSelectors(*category, result);
+            for (auto protocol = (*category)->protocol_begin();
+                protocol != (*category)->protocol_end(); ++protocol)
+            {
+                result.add(protocolSelectors(*protocol));
+            }
+        }
+    }
+    return _classSelectors.emplace(decl, std::move(result)).first->second;
+}
+
+bool ObjCHierarchyOracle::isClassOrSubclass(const clang::ObjCInterfaceDecl *decl,
+    const clang::ObjCInterfaceDecl *ancestor)
+{
+    if (!decl || !ancestor)
+    {
+        return false;
+    }
+    const Ancestors &known = ancestors(decl);
+    return known.decls.find(ancestor->getCanonicalDecl()) != known.decls.end();
+}
+
+bool ObjCHierarchyOracle::isClassOrSubclass(const clang::ObjCInterfaceDecl *decl,
+    const std::string &className)
+{
+    if (!decl)
+    {
+        return false;
+    }
+    auto identifier = _identifiers.find(className);
+    if (identifier == _identifiers.end())
+    {
+        return false;
+    }
+    const Ancestors &known = ancestors(decl);
+    return known.names.find(identifier->getValue()) != known.names.end();
+}
+
+bool ObjCHierarchyOracle::classDeclaresMethod(const clang::ObjCInterfaceDecl *decl,
+    clang::Selector selector, bool isInstance)
+{
+    return decl && classSelectors(decl).contains(selector, isInstance);
+}
+
+bool ObjCHierarchyOracle::classDeclaresMethod(const clang::ObjCInterfaceDecl *decl,
+    const clang::ObjCMethodDecl *method)
+{
+    return method && classDeclaresMethod(decl, method->getSelector(), method->isInstanceMethod());
+}
+
+bool ObjCHierarchyOracle::protocolDeclaresMethod(const clang::ObjCProtocolDecl *decl,
+    clang::Selector selector, bool isInstance)
+{
+    return decl && protocolSelectors(decl).contains(selector, isInstance);
+}
+
+ObjCHierarchyOracle *getObjCHierarchyOracle(oclint::RuleCarrier &carrier)
+{
+    return carrier.getCache<ObjCHierarchyOracle>("ObjCHierarchyOracle");
+}
@@ -0,0 +1,410 @@
+#include "oclint/util/ObjCSelectorUsageIndex.h"
+
+#include <algorithm>
+#include <sstream>
+#include <tuple>
+
+static const char *const serializationHeader = "objc-selector-usage-1";
+
+bool ObjCSelectorUsageIndex::MethodKey::operator==(const MethodKey &other) const
+{
+    return className == other.className && selector == other.selector &&
+        isInstance == other.isInstance;
+}
+
+size_t ObjCSelectorUsageIndex::MethodKeyHash::operator()(const MethodKey &key) const
+{
+    return std::hash<unsigned long long>()(
+        (static_cast<unsigned long long>(key.className) << 32 | key.selector) * 2 +
+        key.isInstance);
+}
+
+ObjCSelectorUsageIndex::Referrers::Referrers() : first(), hasFirst(false), hasOthers(false)
+{
+}
+
+void ObjCSelectorUsageIndex::Referrers::add(const MethodKey &referrer)
+{
+    if (!hasFirst)
+    {
+        first = referrer;
+        hasFirst = true;
+    }
+    else if (!(first == referrer))
+    {
+        hasOthers = true;
+    }
+}
+
+void ObjCSelectorUsageIndex::Referrers::add(const Referrers &other)
+{
+    if (other.hasFirst)
+    {
+        add(other.first);
+    }
+    hasOthers = hasOthers || other.hasOthers;
+}
+
+bool ObjCSelectorUsageIndex::Referrers::includesOtherThan(const MethodKey &method) const
+{
+    return hasOthers || (hasFirst && !(first == method));
+}
+
+ObjCSelectorUsageIndex::ObjCSelectorUsageIndex()
+{
+    clear();
+}
+
+unsigned ObjCSelectorUsageIndex::intern(const std::string &name)
+{
+    auto known = _nameIds.find(name);
+    if (known != _nameIds.end())
+    {
+        return known->second;
+    }
+    unsigned id = _names.size();
+    _names.push_back(name);
+    _nameIds.emplace(name, id);
+    return id;
+}
+
+ObjCSelectorUsageIndex::MethodKey ObjCSelectorUsageIndex::intern(const Method &method)
+{
+    MethodKey key;
+    key.className = intern(method.className);
+    key.selector = intern(method.selector);
+    key.isInstance = method.isInstance;
+    return key;
+}
+
+ObjCSelectorUsageIndex::MethodKey ObjCSelectorUsageIndex::translate(
+    const MethodKey &key, const ObjCSelectorUsageIndex &other)
+{
+    MethodKey translated;
+    translated.className = intern(other._names[key.className]);
+    translated.selector = intern(other._names[key.selector]);
+    translated.isInstance = key.isInstance;
+    return translated;
+}
+
+void ObjCSelectorUsageIndex::addSuperClass(
+    const std::string &className, const std::string &superClassName)
+{
+    _superClasses[intern(className)] = intern(superClassName);
+}
+
+void ObjCSelectorUsageIndex::addCandidate(const Method &method, const Location &location)
+{
+    LocationKey locationKey;
+    locationKey.path = intern(location.path);
+    locationKey.startLine = location.startLine;
+    locationKey.startColumn = location.startColumn;
+    locationKey.endLine = location.endLine;
+    locationKey.endColumn = location.endColumn;
+    _candidates.emplace(intern(method), locationKey);
+}
+
+void ObjCSelectorUsageIndex::addMessage(const std::string &receiverClassName,
+    const std::string &selector, bool isInstance, const Method &referrer)
+{
+    MethodKey message;
+    message.className = noClass;
+    message.selector = intern(selector);
+    message.isInstance = isInstance;
+    _messages[message][intern(receiverClassName)].add(intern(referrer));
+}
+
+void ObjCSelectorUsageIndex::addSelectorExpression(
+    const std::string &selector, const Method &referrer)
+{
+    _selectorExpressions[intern(selector)].add(intern(referrer));
+}
+
+void ObjCSelectorUsageIndex::merge(const ObjCSelectorUsageIndex &other)
+{
+    for (const auto &superClass : other._superClasses)
+    {
+        _superClasses[intern(other._names[superClass.first])] =
+            intern(other._names[superClass.second]);
+    }
+    for (const auto &candidate : other._candidates)
+    {
+        LocationKey location = candidate.second;
+        location.path = intern(other._names[location.path]);
+        _candidates.emplace(translate(candidate.first, other), location);
+    }
+    for (const auto &message : other._messages)
+    {
+        ReceiverReferrers &receivers = _messages[translate(message.first, other)];
+        for (const auto &receiver : message.second)
+        {
+            Referrers translated;
+            if (receiver.second.hasFirst)
+            {
+                translated.add(translate(receiver.second.first, other));
+            }
+            translated.hasOthers = receiver.second.hasOthers;
+            receivers[intern(other._names[receiver.first])].add(translated);
+        }
+    }
+    for (const auto &expression : other._selectorExpressions)
+    {
+        Referrers translated;
+        if (expression.second.hasFirst)
+        {
+            translated.add(translate(expression.second.first, other));
+        }
+        translated.hasOthers = expression.second.hasOthers;
+        _selectorExpressions[intern(other._names[expression.first])].add(translated);
+    }
+}
+
+void ObjCSelectorUsageIndex::clear()
+{
+    _names.clear();
+    _nameIds.clear();
+    _superClasses.clear();
+    _candidates.clear();
+    _messages.clear();
+    _selectorExpressions.clear();
+    intern(""); // noClass
+}
+
+bool ObjCSelectorUsageIndex::isClassOrSubclass(unsigned className, unsigned ancestor) const
+{
+    // names are not unique across a whole program, so guard against cycles
+    for (size_t step = 0; step <= _superClasses.size(); step++)
+    {
+        if (className == ancestor)
+        {
+            return true;
+        }
+        auto superClass = _superClasses.find(className);
+        if (superClass == _superClasses.end())
+        {
+            return false;
+        }
+        className = superClass->second;
+    }
+    return false;
+}
+
+bool ObjCSelectorUsageIndex::isReferenced(const MethodKey &method) const
+{
+    auto expression = _selectorExpressions.find(method.selector);
+    if (expression != _selectorExpressions.end() && expression->second.includesOtherThan(method))
+    {
+        return true;
+    }
+
+    MethodKey message;
+    message.className = noClass;
+    message.selector = method.selector;
+    message.isInstance = method.isInstance;
+    auto receivers = _messages.find(message);
+    if (receivers == _messages.end())
+    {
+        return false;
+    }
+    for (const auto &receiver : receivers->second)
+    {
+        if ((receiver.first == noClass || isClassOrSubclass(receiver.first, method.className)) &&
+            receiver.second.includesOtherThan(method))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ObjCSelectorUsageIndex::forEachUnusedMethod(
+    const std::function<void (const Method &, const Location &)> &callback) const
+{
+    std::vector<std::pair<const MethodKey *, const LocationKey *>> unused;
+    for (const auto &candidate : _candidates)
+    {
+        if (!isReferenced(candidate.first))
+        {
+            unused.push_back(std::make_pair(&candidate.first, &candidate.second));
+        }
+    }
+    std::sort(unused.begin(), unused.end(),
+        [this](const std::pair<const MethodKey *, const LocationKey *> &lhs,
+            const std::pair<const MethodKey *, const LocationKey *> &rhs) {
+            return std::tie(_names[lhs.second->path], lhs.second->startLine,
+                lhs.second->startColumn, lhs.first->selector) <
+                std::tie(_names[rhs.second->path], rhs.second->startLine,
+                rhs.second->startColumn, rhs.first->selector);
+        });
+
+    for (const auto &method : unused)
+    {
+        Method unusedMethod;
+        unusedMethod.className = _names[method.first->className];
+        unusedMethod.selector = _names[method.first->selector];
+        unusedMethod.isInstance = method.first->isInstance;
+        Location location;
+        location.path = _names[method.second->path];
+        location.startLine = method.second->startLine;
+        location.startColumn = method.second->startColumn;
+        location.endLine = method.second->endLine;
+        location.endColumn = method.second->endColumn;
+        callback(unusedMethod, location);
+    }
+}
+
+void ObjCSelectorUsageIndex::write(std::ostream &out, const MethodKey &key) const
+{
+    out << ' ' << key.className << ' ' << key.selector << ' ' << key.isInstance;
+}
+
+void ObjCSelectorUsageIndex::write(std::ostream &out, const Referrers &referrers) const
+{
+    out << ' ' << referrers.hasFirst;
+    write(out, referrers.first);
+    out << ' ' << referrers.hasOthers;
+}
+
+bool ObjCSelectorUsageIndex::read(std::istream &in, unsigned &name) const
+{
+    return (in >> name) && name < _names.size();
+}
+
+bool ObjCSelectorUsageIndex::read(std::istream &in, MethodKey &key) const
+{
+    return read(in, key.className) && read(in, key.selector) && (in >> key.isInstance);
+}
+
+bool ObjCSelectorUsageIndex::read(std::istream &in, Referrers &referrers) const
+{
+    return (in >> referrers.hasFirst) && read(in, referrers.first) && (in >> referrers.hasOthers);
+}
+
+std::string ObjCSelectorUsageIndex::serialize() const
+{
+    std::ostringstream out;
+    out << serializationHeader << '\n' << _names.size() << '\n';
+    for (const auto &name : _names)
+    {
+        out << name.size() << ' ' << name << '\n';
+    }
+
+    out << _superClasses.size();
+    for (const auto &superClass : _superClasses)
+    {
+        out << ' ' << superClass.first << ' ' << superClass.second;
+    }
+    out << '\n' << _candidates.size();
+    for (const auto &candidate : _candidates)
+    {
+        write(out, candidate.first);
+        out << ' ' << candidate.second.path << ' ' << candidate.second.startLine
+            << ' ' << candidate.second.startColumn << ' ' << candidate.second.endLine
+            << ' ' << candidate.second.endColumn;
+    }
+    out << '\n' << _messages.size();
+    for (const auto &message : _messages)
+    {
+        write(out, message.first);
+        out << ' ' << message.second.size();
+        for (const auto &receiver : message.second)
+        {
+            out << ' ' << receiver.first;
+            write(out, receiver.second);
+        }
+    }
+    out << '\n' << _selectorExpressions.size();
+    for (const auto &expression : _selectorExpressions)
+    {
+        out << ' ' << expression.first;
+        write(out, expression.second);
+    }
+    out << '\n';
+    return out.str();
+}
+
+bool ObjCSelectorUsageIndex::deserialize(const std::string &serialized)
+{
+    // names are read back with the ids they were written with, the empty name included
+    clear();
+    _names.clear();
+    _nameIds.clear();
+
+    std::istringstream in(serialized);
+    std::string header;
+    size_t count;
+    if (!(in >> header) || header != serializationHeader || !(in >> count))
+    {
+        clear();
+        return false;
+    }
+    for (size_t index = 0; index < count; index++)
+    {
+        size_t length;
+        if (!(in >> length) || in.get() != ' ')
+        {
+            clear();
+            return false;
+        }
+        std::string name(length, '\0');
+        if (!in.read(&name[0], length))
+        {
+            clear();
+            return false;
+        }
+        _nameIds.emplace(name, _names.size());
+        _names.push_back(name);
+    }
+    if (_names.empty() || !_names[noClass].empty())
+    {
+        clear();
+        return false;
+    }
+
+    bool valid = bool(in >> count);
+    for (size_t index = 0; valid && index < count; index++)
+    {
+        unsigned className;
+        unsigned superClassName;
+        valid = read(in, className) && read(in, superClassName);
+        _superClasses[className] = superClassName;
+    }
+    valid = valid && (in >> count);
+    for (size_t index = 0; valid && index < count; index++)
+    {
+        MethodKey method;
+        LocationKey location;
+        valid = read(in, method) && read(in, location.path) &&
+            (in >> location.startLine >> location.startColumn
+                >> location.endLine >> location.endColumn);
+        _candidates.emplace(method, location);
+    }
+    valid = valid && (in >> count);
+    for (size_t index = 0; valid && index < count; index++)
+    {
+        MethodKey message;
+        size_t receiverCount;
+        valid = read(in, message) && (in >> receiverCount);
+        for (size_t receiverIndex = 0; valid && receiverIndex < receiverCount; receiverIndex++)
+        {
+            unsigned receiver;
+            Referrers referrers;
+            valid = read(in, receiver) && read(in, referrers);
+            _messages[message][receiver] = referrers;
+        }
+    }
+    valid = valid && (in >> count);
+    for (size_t index = 0; valid && index < count; index++)
+    {
+        unsigned selector;
+        Referrers referrers;
+        valid = read(in, selector) && read(in, referrers);
+        _selectorExpressions[selector] = referrers;
+    }
+
+    if (!valid)
+    {
+        clear();
+    }
+    return valid;
+}
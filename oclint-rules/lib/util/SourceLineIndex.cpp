@@ -0,0 +1,219 @@
+#include "oclint/util/SourceLineIndex.h"
+
+#include <cctype>
+#include <cstring>
+#include <string>
+
+#include <clang/AST/AST.h>
+
+static const char suppressMarker[] = "OCLINT";
+static const unsigned suppressMarkerLength = sizeof(suppressMarker) - 1;
+
+/* a marker is //! followed by optional spaces and OCLINT in any case */
+static bool isSuppressMarker(const char *begin, const char *end)
+{
+    if (end - begin < 3 || begin[1] != '/' || begin[2] != '!')
+    {
+        return false;
+    }
+    const char *current = begin + 3;
+    while (current < end && *current == ' ')
+    {
+        current++;
+    }
+    return unsigned(end - current) >= suppressMarkerLength &&
+        llvm::StringRef(current, suppressMarkerLength).equals_lower(suppressMarker);
+}
+
+/* lexical context that carries over from one line to the next */
+struct SourceLineIndex::ScanState
+{
+    enum Context
+    {
+        CODE,
+        LINE_COMMENT,
+        BLOCK_COMMENT,
+        STRING_LITERAL,
+        CHARACTER_LITERAL,
+        RAW_STRING_LITERAL
+    };
+
+    Context context = CODE;
+    /* )delimiter" that closes the open raw string literal */
+    std::string rawStringEnd;
+};
+
+static bool isIdentifierCharacter(char character)
+{
+    return isalnum(static_cast<unsigned char>(character)) || character == '_';
+}
+
+/* R" that starts a token, optionally after a u8, u, U or L encoding prefix */
+static bool isRawStringStart(const char *lineBegin, const char *current, const char *lineEnd)
+{
+    if (*current != 'R' || current + 1 >= lineEnd || current[1] != '"')
+    {
+        return false;
+    }
+    const char *tokenBegin = current;
+    if (tokenBegin - lineBegin >= 2 && tokenBegin[-2] == 'u' && tokenBegin[-1] == '8')
+    {
+        tokenBegin -= 2;
+    }
+    else if (tokenBegin > lineBegin &&
+        (tokenBegin[-1] == 'u' || tokenBegin[-1] == 'U' || tokenBegin[-1] == 'L'))
+    {
+        tokenBegin--;
+    }
+    return tokenBegin == lineBegin || !isIdentifierCharacter(tokenBegin[-1]);
+}
+
+/* a backslash right before the line break splices the next line onto this one */
+static bool isSplicedLine(const char *lineBegin, const char *lineEnd)
+{
+    if (lineEnd > lineBegin && lineEnd[-1] == '\r')
+    {
+        lineEnd--;
+    }
+    return lineEnd > lineBegin && lineEnd[-1] == '\\';
+}
+
+SourceLineIndex::SourceLineIndex(oclint::RuleCarrier &carrier)
+{
+    clang::SourceManager &sourceManager = carrier.getSourceManager();
+    _buffer = sourceManager.getBufferData(sourceManager.getMainFileID());
+
+    const char *data = _buffer.data();
+    unsigned size = _buffer.size();
+    unsigned lineBegin = 0;
+    ScanState state;
+    while (lineBegin < size)
+    {
+        _lineOffsets.push_back(lineBegin);
+        const void *lineBreak = std::memchr(data + lineBegin, '\n', size - lineBegin);
+        unsigned lineEnd = lineBreak ? static_cast<const char *>(lineBreak) - data : size;
+        scanLine(lineBegin, lineEnd, state);
+        lineBegin = lineEnd + 1;
+    }
+    /* one past the line break of the last line, so line(n) ends at _lineOffsets[n] - 1 */
+    _lineOffsets.push_back(lineBegin);
+}
+
+void SourceLineIndex::scanLine(unsigned begin, unsigned end, ScanState &state)
+{
+    const char *data = _buffer.data();
+    const char *lineBegin = data + begin;
+    const char *lineEnd = data + end;
+    llvm::StringRef line(lineBegin, end - begin);
+    const char *current = lineBegin;
+    while (current < lineEnd && state.context != ScanState::LINE_COMMENT)
+    {
+        switch (state.context)
+        {
+        case ScanState::BLOCK_COMMENT:
+        case ScanState::RAW_STRING_LITERAL:
+        {
+            llvm::StringRef closing = state.context == ScanState::BLOCK_COMMENT ?
+                llvm::StringRef("*/") : llvm::StringRef(state.rawStringEnd);
+            size_t found = line.find(closing, current - lineBegin);
+            if (found == llvm::StringRef::npos)
+            {
+                current = lineEnd;
+            }
+            else
+            {
+                current = lineBegin + found + closing.size();
+                state.context = ScanState::CODE;
+            }
+            break;
+        }
+        case ScanState::STRING_LITERAL:
+        case ScanState::CHARACTER_LITERAL:
+            if (*current == '\\')
+            {
+                current += 2;
+                break;
+            }
+            if (*current == (state.context == ScanState::STRING_LITERAL ? '"' : '\''))
+            {
+                state.context = ScanState::CODE;
+            }
+            current++;
+            break;
+        default:
+            if (*current == '/' && current + 1 < lineEnd && current[1] == '/')
+            {
+                if (isSuppressMarker(current, lineEnd))
+                {
+                    _markerOffsets.push_back(current - data);
+                }
+                state.context = ScanState::LINE_COMMENT;
+            }
+            else if (*current == '/' && current + 1 < lineEnd && current[1] == '*')
+            {
+                state.context = ScanState::BLOCK_COMMENT;
+                current += 2;
+            }
+            else if (*current == '"')
+            {
+                state.context = ScanState::STRING_LITERAL;
+                current++;
+            }
+            // a quote after a digit is a digit separator, e.g. 1'000
+            else if (*current == '\'' && !(current > lineBegin && isdigit(current[-1])))
+            {
+                state.context = ScanState::CHARACTER_LITERAL;
+                current++;
+            }
+            else if (isRawStringStart(lineBegin, current, lineEnd))
+            {
+                const char *delimiter = current + 2;
+                const void *parenthesis = std::memchr(delimiter, '(', lineEnd - delimiter);
+                if (parenthesis)
+                {
+                    state.rawStringEnd = ")" +
+                        std::string(delimiter, static_cast<const char *>(parenthesis)) + "\"";
+                    state.context = ScanState::RAW_STRING_LITERAL;
+                    current = static_cast<const char *>(parenthesis) + 1;
+                }
+                else
+                {
+                    state.context = ScanState::STRING_LITERAL;
+                    current = delimiter;
+                }
+            }
+            else
+            {
+                current++;
+            }
+            break;
+        }
+    }
+
+    // comments and literals other than raw strings end with the line unless it is spliced
+    if (state.context != ScanState::BLOCK_COMMENT &&
+        state.context != ScanState::RAW_STRING_LITERAL && !isSplicedLine(lineBegin, lineEnd))
+    {
+        state.context = ScanState::CODE;
+    }
+}
+
+int SourceLineIndex::numberOfLines() const
+{
+    return _lineOffsets.size() - 1;
+}
+
+llvm::StringRef SourceLineIndex::line(int lineNumber) const
+{
+    return _buffer.slice(_lineOffsets[lineNumber - 1], _lineOffsets[lineNumber] - 1);
+}
+
+const std::vector<unsigned> &SourceLineIndex::suppressMarkerOffsets() const
+{
+    return _markerOffsets;
+}
+
+SourceLineIndex *getSourceLineIndex(oclint::RuleCarrier &carrier)
+{
+    return carrier.getCache<SourceLineIndex>("SourceLineIndex");
+}
@@ -30,6 +30,11 @@ public:
         return "basic";
     }
 
+    virtual const vector<string> lexicalPrerequisites() const override
+    {
+        return {"goto"};
+    }
+
 #ifdef DOCGEN
     virtual const std::string since() const override
     {
@@ -42,6 +42,11 @@ public:
         return "basic";
     }
 
+    virtual const vector<string> lexicalPrerequisites() const override
+    {
+        return {"finally"};
+    }
+
 #ifdef DOCGEN
     virtual const std::string since() const override
     {
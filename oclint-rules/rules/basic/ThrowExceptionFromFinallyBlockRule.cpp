@@ -78,6 +78,11 @@ public:
         return "basic";
     }
 
+    virtual const vector<string> lexicalPrerequisites() const override
+    {
+        return {"finally"};
+    }
+
     virtual unsigned int supportedLanguages() const override
     {
         return LANG_OBJC;
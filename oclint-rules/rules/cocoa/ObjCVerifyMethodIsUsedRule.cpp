@@ -1,247 +1,244 @@
+#include <unordered_map>
+#include <unordered_set>
+
 #include <clang/AST/Attr.h>
-#include <iostream>
+
 #include "oclint/AbstractASTVisitorRule.h"
 #include "oclint/RuleSet.h"
 #include "oclint/helper/EnforceHelper.h"
-#include "oclint/util/ASTUtil.h"
+#include "oclint/helper/SuppressHelper.h"
+#include "oclint/util/ObjCHierarchyOracle.h"
+#include "oclint/util/ObjCSelectorUsageIndex.h"
 
 using namespace std;
 using namespace clang;
 using namespace oclint;
 
+namespace {
 
-class ObjCVerifyMethodIsUsedRule : public AbstractASTVisitorRule<ObjCVerifyMethodIsUsedRule>
-{
-private:
-    bool methodSelectorsAreEqual(ObjCMethodDecl* method1, ObjCMethodDecl* method2) {
-        return method1->getSelector() == method2->getSelector();
-    }
-    
-    bool methodsAreEqual(ObjCMethodDecl* method1, ObjCMethodDecl* method2) {
-        return method1->isClassMethod() == method2->isClassMethod() && methodSelectorsAreEqual(method1, method2);
-    }
-    
-    bool propertyIncludesMethod(ObjCPropertyDecl* property, ObjCMethodDecl* method) {
-        if (method->isInstanceMethod()) {
-            auto getter = property->getGetterMethodDecl();
-            auto setter = property->getSetterMethodDecl();
-            if ((getter && methodSelectorsAreEqual(getter, method)) || (setter && methodSelectorsAreEqual(setter, method))) {
-                return true;
+    /*
+     * Records which methods of one implementation reference a selector. A reference
+     * from the method itself does not count, so remembering the first referrer and
+     * whether any other one exists is enough to answer the question for every method.
+     */
+    class SelectorReferrers
+    {
+        private:
+            const ObjCMethodDecl* _referrer = nullptr;
+            bool _hasOtherReferrers = false;
+
+        public:
+            void add(const ObjCMethodDecl* referrer) {
+                if (!_referrer) {
+                    _referrer = referrer;
+                } else if (_referrer != referrer) {
+                    _hasOtherReferrers = true;
+                }
             }
-        }
-        return false;
-    }
 
-    /**
-     Returns true if a declared method or property matches the provided method.
+            bool isReferencedOutside(const ObjCMethodDecl* method) const {
+                return _hasOtherReferrers || (_referrer && _referrer != method);
+            }
+    };
+
+    typedef unordered_map<void*, SelectorReferrers> SelectorReferrersMap;
+
+    /*
+     * Selector references made by the method bodies of one @implementation, split by
+     * instance and class selectors. A reference is definite when the receiver is the
+     * implemented class or one of its subclasses, and possible when the receiver is
+     * unknown or the selector only appears in a @selector expression. Messages to any
+     * other class are not references.
      */
-    bool containerDeclaresMethod(ObjCContainerDecl* interface, ObjCMethodDecl* method) {
+    struct SelectorReferenceIndex
+    {
+        SelectorReferrersMap definiteInstance;
+        SelectorReferrersMap definiteClass;
+        SelectorReferrersMap possibleInstance;
+        SelectorReferrersMap possibleClass;
 
-        for (auto methodIterator = interface->meth_begin(); methodIterator != interface->meth_end(); methodIterator++) {
-            if (methodsAreEqual(*methodIterator, method)) {
-                return true;
-            }
+        static bool isReferencedOutside(const SelectorReferrersMap& references,
+            const ObjCMethodDecl* method) {
+            const auto found = references.find(method->getSelector().getAsOpaquePtr());
+            return found != references.end() && found->second.isReferencedOutside(method);
         }
-        
-        for (auto property = interface->prop_begin(); property != interface->prop_end(); property++) {
-            if (propertyIncludesMethod(*property, method)) {
-                return true;
-            }
+
+        bool isUsed(const ObjCMethodDecl* method) const {
+            return isReferencedOutside(method->isInstanceMethod() ? definiteInstance : definiteClass,
+                method);
         }
-        
-        return false;
-    }
-    
-    bool protocolDeclaresMethod(ObjCProtocolDecl* interface, ObjCMethodDecl* method) {
-        
-        if (containerDeclaresMethod(interface, method)) {
-            return true;
+
+        bool isPossiblyUsed(const ObjCMethodDecl* method) const {
+            return isReferencedOutside(method->isInstanceMethod() ? possibleInstance : possibleClass,
+                method);
         }
-        
-        for (auto protocol = interface->protocol_begin(); protocol != interface->protocol_end(); protocol++) {
-            if (protocolDeclaresMethod(*protocol, method)) {
+    };
+
+    class CollectSelectorReferences : public RecursiveASTVisitor<CollectSelectorReferences>
+    {
+        private:
+            const ObjCInterfaceDecl* _class;
+            SelectorReferenceIndex& _index;
+            const ObjCMethodDecl* _method;
+            ObjCHierarchyOracle& _hierarchy;
+
+            void addReference(Selector selector, bool isInstance, const ObjCInterfaceDecl* receiver) {
+                if (!receiver) {
+                    SelectorReferrersMap& references =
+                        isInstance ? _index.possibleInstance : _index.possibleClass;
+                    references[selector.getAsOpaquePtr()].add(_method);
+                } else if (_hierarchy.isClassOrSubclass(receiver, _class)) {
+                    SelectorReferrersMap& references =
+                        isInstance ? _index.definiteInstance : _index.definiteClass;
+                    references[selector.getAsOpaquePtr()].add(_method);
+                }
+                // a message to an unrelated class does not reach the implemented one
+            }
+
+        public:
+            CollectSelectorReferences(const ObjCInterfaceDecl& implementedClass,
+                SelectorReferenceIndex& index, ObjCHierarchyOracle& hierarchy) :
+                _class(&implementedClass), _index(index), _method(nullptr), _hierarchy(hierarchy) {};
+
+            void collect(ObjCMethodDecl* method) {
+                _method = method;
+                TraverseStmt(method->getBody());
+            }
+
+            bool VisitObjCMessageExpr(ObjCMessageExpr* expr) {
+                // sending to super does not count as an internal reference
+                if (expr->getReceiverKind() == ObjCMessageExpr::SuperInstance ||
+                    expr->getReceiverKind() == ObjCMessageExpr::SuperClass) {
+                    return true;
+                }
+                addReference(expr->getSelector(), expr->isInstanceMessage(), expr->getReceiverInterface());
                 return true;
             }
-        }
-        
-        return false;
-    }
 
-    bool interfaceDeclaresMethod(ObjCInterfaceDecl* interface, ObjCMethodDecl* method) {
-        
-        if (containerDeclaresMethod(interface, method)) {
-            return true;
-        }
-        
-        for (auto protocol = interface->all_referenced_protocol_begin(); protocol != interface->all_referenced_protocol_end(); protocol++) {
-            if (protocolDeclaresMethod(*protocol, method)) {
+            bool VisitObjCPropertyRefExpr(ObjCPropertyRefExpr* expr) {
+                if (expr->isSuperReceiver()) {
+                    return true;
+                }
+                const ObjCInterfaceDecl* receiver = nullptr;
+                if (expr->isClassReceiver()) {
+                    receiver = expr->getClassReceiver();
+                } else if (expr->isObjectReceiver()) {
+                    const auto pointerType = expr->getBase()->getType()->getAs<ObjCObjectPointerType>();
+                    receiver = pointerType ? pointerType->getInterfaceDecl() : nullptr;
+                }
+                const bool isInstance = !expr->isClassReceiver();
+                if (expr->isMessagingGetter()) {
+                    addReference(expr->getGetterSelector(), isInstance, receiver);
+                }
+                if (expr->isMessagingSetter()) {
+                    addReference(expr->getSetterSelector(), isInstance, receiver);
+                }
                 return true;
             }
-        }
-        
-        return false;
-    }
-    
-    bool categoryDeclaresMethod(ObjCCategoryDecl* interface, ObjCMethodDecl* method) {
-        
-        if (containerDeclaresMethod(interface, method)) {
-            return true;
-        }
-        
-        for (auto protocol = interface->protocol_begin(); protocol != interface->protocol_end(); protocol++) {
-            if (protocolDeclaresMethod(*protocol, method)) {
+
+            bool VisitObjCSelectorExpr(ObjCSelectorExpr* expr) {
+                _index.possibleInstance[expr->getSelector().getAsOpaquePtr()].add(_method);
+                _index.possibleClass[expr->getSelector().getAsOpaquePtr()].add(_method);
                 return true;
             }
-        }
-        
-        return false;
-    }
-    
-    bool interfaceIsKindOfInterface(ObjCInterfaceDecl* interface, ObjCInterfaceDecl* targetInterface) {
-        cerr << "left side " << interface->getName().str() << " right side " << targetInterface->getName().str() << endl;
+    };
+}
 
-        if (!targetInterface) { // no target; hopeless
-            return false;
-        }
+class ObjCVerifyMethodIsUsedRule : public AbstractASTVisitorRule<ObjCVerifyMethodIsUsedRule>
+{
+private:
+    /*
+     * With global analysis, every translation unit is summarized into a usage index
+     * instead, and the methods no summary references are reported once all are analyzed.
+     */
+    bool _globalAnalysis = false;
+    ObjCSelectorUsageIndex _translationUnitSummary;
+    unordered_set<const ObjCInterfaceDecl*> _summarizedClasses;
+    ObjCSelectorUsageIndex::Method _referrer;
 
+    static ObjCSelectorUsageIndex::Method methodOf(const ObjCInterfaceDecl* interface,
+        Selector selector, bool isInstance) {
+        ObjCSelectorUsageIndex::Method method;
+        method.className = interface ? interface->getNameAsString() : "";
+        method.selector = selector.getAsString();
+        method.isInstance = isInstance;
+        return method;
+    }
+
+    string summarizeClass(const ObjCInterfaceDecl* interface) {
         if (!interface) {
-            return true; // no interface can be.  should raise exception.
+            return "";
+        }
+        for (auto current = interface; current && _summarizedClasses.insert(
+            current->getCanonicalDecl()).second; current = current->getSuperClass()) {
+            if (current->getSuperClass()) {
+                _translationUnitSummary.addSuperClass(current->getNameAsString(),
+                    current->getSuperClass()->getNameAsString());
+            }
         }
+        return interface->getNameAsString();
+    }
 
-//        return true; // TODO: totally fucking broken please fix
+    void summarizeMessage(const ObjCInterfaceDecl* receiver, Selector selector, bool isInstance) {
+        _translationUnitSummary.addMessage(summarizeClass(receiver),
+            selector.getAsString(), isInstance, _referrer);
+    }
 
-        while (interface) {
-            
-            if (interface->getName().str() == targetInterface->getName().str()) {
+    bool isDeclaredBySuperClassOrProtocol(ObjCHierarchyOracle& hierarchy,
+        const ObjCInterfaceDecl* interface, const ObjCMethodDecl* method) {
+        if (hierarchy.classDeclaresMethod(interface->getSuperClass(), method)) {
+            return true;
+        }
+        const auto definition = interface->getDefinition();
+        if (!definition) {
+            return false;
+        }
+        for (auto protocol = definition->all_referenced_protocol_begin();
+            protocol != definition->all_referenced_protocol_end(); protocol++) {
+            if (hierarchy.protocolDeclaresMethod(*protocol,
+                method->getSelector(), method->isInstanceMethod())) {
                 return true;
             }
-            if (interface->getName().str() == string("NSObject") || interface->getName().str() == string("NSProxy")) {
-                break;
-            }
-            interface = interface->getSuperClass();
-        }        
-        
-        return false;
-    }
-    
-    bool interfaceHierarchyDeclaresMethod(ObjCInterfaceDecl* interface, ObjCMethodDecl* method) {
-        
-        for (; interface; interface = interface->getSuperClass()) {
-            ObjCInterfaceDecl* definition = interface->getDefinition();
-            if (definition) {
-                if (interfaceDeclaresMethod(definition, method)) {
+        }
+        for (auto category = definition->visible_categories_begin();
+            category != definition->visible_categories_end(); category++) {
+            for (auto protocol = (*category)->protocol_begin();
+                protocol != (*category)->protocol_end(); protocol++) {
+                if (hierarchy.protocolDeclaresMethod(*protocol,
+                    method->getSelector(), method->isInstanceMethod())) {
                     return true;
                 }
-                
-                for (auto category = interface->visible_categories_begin(); category != interface->visible_categories_end(); category++) {
-                    if (categoryDeclaresMethod(*category, method)) {
-                        return true;
-                    }
-                }
             }
         }
-        
         return false;
     }
-    
-    bool selectorExpressionMatchesMethod(ObjCSelectorExpr* statement, ObjCMethodDecl* method) {
-        return statement->getSelector() == method->getSelector();
-    }
-    
-    bool implementationCallsMethod(ObjCImplDecl* implementation, ObjCMethodDecl* method, bool* possibillyUsed) {
-        
-        for (auto internalIterator = implementation->meth_begin(); internalIterator != implementation->meth_end(); internalIterator++) {
-            ObjCMethodDecl* testMethod = *internalIterator;
-            
-            
-            if (methodsAreEqual(testMethod, method)) { // ignore the same method
+
+    void summarizeCandidates(ObjCImplDecl* implementation, const ObjCInterfaceDecl* implementedClass) {
+        ObjCHierarchyOracle& hierarchy = *getObjCHierarchyOracle(*_carrier);
+        SourceManager& sourceManager = _carrier->getSourceManager();
+        const string className = summarizeClass(implementedClass);
+        for (auto method = implementation->meth_begin(); method != implementation->meth_end(); method++) {
+            if ((*method)->isImplicit() || (*method)->hasAttr<IBActionAttr>() ||
+                isDeclaredBySuperClassOrProtocol(hierarchy, implementedClass, *method) ||
+                shouldSuppress(*method, *_carrier, this)) {
                 continue;
             }
-            
-            vector<Stmt*>* statements = collectMethodStatements(testMethod->getBody());
-
-            bool ret = false;
-            
-            for (Stmt* statement : *statements) {
-                clang::AbstractConditionalOperator::StmtClass cls = statement->getStmtClass();
-
-                if (cls == clang::AbstractConditionalOperator::ObjCSelectorExprClass) {
-                    if (possibillyUsed && !*possibillyUsed) { // does the caller care, and have we not set it to true yet.
-                        *possibillyUsed = selectorExpressionMatchesMethod((ObjCSelectorExpr*)statement, method);
-                    }
-                    
-                } else if (method->isInstanceMethod() && cls == clang::AbstractConditionalOperator::ObjCPropertyRefExprClass) {
-                    ObjCPropertyRefExpr* property = (ObjCPropertyRefExpr*)statement;
-                    if ((property->isMessagingGetter() && property->getGetterSelector() == method->getSelector()) ||
-                        (property->isMessagingSetter() && property->getSetterSelector() == method->getSelector())) {
-                        if (!property->isSuperReceiver()) {
-                            ObjCInterfaceDecl* receiver = property->getClassReceiver();
-                            if (receiver && !receiver->isThisDeclarationADefinition()) {
-                                receiver = receiver->getDefinition();
-                            }
-                            if (receiver) {
-                                if (true) {
-                                    if (interfaceIsKindOfInterface(receiver, implementation->getClassInterface())) {
-                                        ret = true;
-                                        break;
-                                    }
-                                } else {
-                                    if (possibillyUsed) {
-                                        *possibillyUsed = true;
-                                    }
-                                }
-                            } else {
-                                if (possibillyUsed) {
-                                    *possibillyUsed = true;
-                                }
-                            }
-                        }
-                    }
-                } else if (cls == clang::AbstractConditionalOperator::ObjCMessageExprClass) {
-                    ObjCMessageExpr* messageSend = (ObjCMessageExpr*)statement;
-                    if (messageSend->getReceiverKind() != clang::ObjCMessageExpr::SuperInstance && messageSend->getReceiverKind() != clang::ObjCMessageExpr::SuperClass) { // sending to super does not count as an internal reference
-                        if (method->isInstanceMethod() == messageSend->isInstanceMessage() && methodsAreEqual(method, messageSend->getMethodDecl())) {
-                            ObjCInterfaceDecl* receiver = messageSend->getReceiverInterface();
-                            if (receiver && !receiver->isThisDeclarationADefinition()) {
-                                receiver = receiver->getDefinition(); // unwrap to the true definition (if available)
-                            }
-                            if (receiver) {
-                                if (interfaceIsKindOfInterface(receiver, implementation->getClassInterface())) {
-                                    delete statements;
-                                    return true;
-                                }
-                            } else { // selector matches but we don't know the receiver interface
-                                if (possibillyUsed && !*possibillyUsed) {
-                                    *possibillyUsed = true;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            delete statements;
-            if (ret) {
-                return ret;
+            SourceLocation start = sourceManager.getFileLoc((*method)->getLocStart());
+            SourceLocation end = sourceManager.getFileLoc((*method)->getLocEnd());
+            ObjCSelectorUsageIndex::Location location;
+            location.path = sourceManager.getFilename(start).str();
+            location.startLine = sourceManager.getPresumedLineNumber(start);
+            location.startColumn = sourceManager.getPresumedColumnNumber(start);
+            location.endLine = sourceManager.getPresumedLineNumber(end);
+            location.endColumn = sourceManager.getPresumedColumnNumber(end);
+            if (shouldSuppress(location.startLine, *_carrier, this)) {
+                continue;
             }
-        }
-        return false;
-    }
-    
-    void helperCollectMethodStatements(Stmt* statement, vector<Stmt*>* statements) {
-        if (!statement) return;
-        statements->push_back(statement);
-        auto iterator = statement->child_begin();
-        for (; iterator != statement->child_end(); iterator++) {
-            helperCollectMethodStatements(*iterator, statements);
+            _translationUnitSummary.addCandidate(methodOf(implementedClass,
+                (*method)->getSelector(), (*method)->isInstanceMethod()), location);
         }
     }
-    
-    vector<Stmt*>* collectMethodStatements(Stmt* statement) {
-        vector<Stmt*>* statements = new vector<Stmt*>();
-        helperCollectMethodStatements(statement, statements);
-        return statements;
-    }
-    
+
 public:
     virtual const string name() const override
     {
@@ -263,22 +260,125 @@ public:
         return LANG_OBJC;
     }
 
+    virtual void beginGlobalAnalysis() override
+    {
+        _globalAnalysis = true;
+    }
+
+    virtual string summarizeTranslationUnit() override
+    {
+        if (!_globalAnalysis) {
+            return "";
+        }
+        string summary = _translationUnitSummary.serialize();
+        _translationUnitSummary.clear();
+        return summary;
+    }
+
+    virtual void endGlobalAnalysis(const vector<string>& summaries,
+        ViolationSet *violationSet) override
+    {
+        ObjCSelectorUsageIndex usageIndex;
+        for (const auto& summary : summaries) {
+            ObjCSelectorUsageIndex translationUnit;
+            if (translationUnit.deserialize(summary)) {
+                usageIndex.merge(translationUnit);
+            }
+        }
+        usageIndex.forEachUnusedMethod([this, violationSet](
+            const ObjCSelectorUsageIndex::Method& method,
+            const ObjCSelectorUsageIndex::Location& location) {
+            violationSet->addViolation(Violation(this, location.path,
+                location.startLine, location.startColumn, location.endLine, location.endColumn,
+                "The method " + method.selector +
+                " was defined but not referenced in any translation unit"));
+        });
+        _globalAnalysis = false;
+    }
+
+    virtual void setUp() override
+    {
+        _translationUnitSummary.clear();
+        _summarizedClasses.clear();
+        _referrer = methodOf(nullptr, Selector(), true);
+    }
+
+    bool TraverseObjCMethodDecl(ObjCMethodDecl* method) {
+        if (!_globalAnalysis) {
+            return AbstractASTVisitorRule<ObjCVerifyMethodIsUsedRule>::TraverseObjCMethodDecl(method);
+        }
+        const auto outerReferrer = _referrer;
+        _referrer = methodOf(method->getClassInterface(),
+            method->getSelector(), method->isInstanceMethod());
+        bool result = AbstractASTVisitorRule<ObjCVerifyMethodIsUsedRule>::TraverseObjCMethodDecl(method);
+        _referrer = outerReferrer;
+        return result;
+    }
+
+    bool VisitObjCMessageExpr(ObjCMessageExpr* expr) {
+        if (_globalAnalysis &&
+            expr->getReceiverKind() != ObjCMessageExpr::SuperInstance &&
+            expr->getReceiverKind() != ObjCMessageExpr::SuperClass) {
+            summarizeMessage(expr->getReceiverInterface(), expr->getSelector(),
+                expr->isInstanceMessage());
+        }
+        return true;
+    }
+
+    bool VisitObjCPropertyRefExpr(ObjCPropertyRefExpr* expr) {
+        if (!_globalAnalysis || expr->isSuperReceiver()) {
+            return true;
+        }
+        const ObjCInterfaceDecl* receiver = nullptr;
+        if (expr->isClassReceiver()) {
+            receiver = expr->getClassReceiver();
+        } else if (expr->isObjectReceiver()) {
+            const auto pointerType = expr->getBase()->getType()->getAs<ObjCObjectPointerType>();
+            receiver = pointerType ? pointerType->getInterfaceDecl() : nullptr;
+        }
+        if (expr->isMessagingGetter()) {
+            summarizeMessage(receiver, expr->getGetterSelector(), !expr->isClassReceiver());
+        }
+        if (expr->isMessagingSetter()) {
+            summarizeMessage(receiver, expr->getSetterSelector(), !expr->isClassReceiver());
+        }
+        return true;
+    }
+
+    bool VisitObjCSelectorExpr(ObjCSelectorExpr* expr) {
+        if (_globalAnalysis) {
+            _translationUnitSummary.addSelectorExpression(
+                expr->getSelector().getAsString(), _referrer);
+        }
+        return true;
+    }
+
     bool VisitObjCImplDecl(ObjCImplDecl *implementation) {
+        const auto implementedClass = implementation->getClassInterface();
+        if (!implementedClass) {
+            return true;
+        }
+        if (_globalAnalysis) {
+            summarizeCandidates(implementation, implementedClass);
+            return true;
+        }
+
+        ObjCHierarchyOracle& hierarchy = *getObjCHierarchyOracle(*_carrier);
+        SelectorReferenceIndex index;
+        CollectSelectorReferences collector(*implementedClass, index, hierarchy);
         for (auto method = implementation->meth_begin(); method != implementation->meth_end(); method++) {
-            bool declaredPublically = interfaceHierarchyDeclaresMethod(implementation->getClassInterface(), *method);
-            bool possibillyUsed = false;
-            bool usedInternally = implementationCallsMethod(implementation, *method, &possibillyUsed);
-            if (!declaredPublically && !usedInternally) {
-                cerr << "violation on " << (*method)->getNameAsString() << endl;
-                if (possibillyUsed) {
-                    cerr << "possibily used by @selector(...)" << endl;
-                } else {
-                    addViolation(*method, this, string("The method ") + method->getNameAsString() + " was defined but not exported or referenced here");   
-                }
+            collector.collect(*method);
+        }
+
+        for (auto method = implementation->meth_begin(); method != implementation->meth_end(); method++) {
+            if (index.isUsed(*method) || index.isPossiblyUsed(*method) ||
+                hierarchy.classDeclaresMethod(implementedClass, *method)) {
+                continue;
             }
+            addViolation(*method, this, string("The method ") + method->getNameAsString() + " was defined but not exported or referenced here");
         }
         return true;
-    }    
+    }
 
 };
 
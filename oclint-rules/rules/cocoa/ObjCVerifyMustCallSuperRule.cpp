@@ -12,24 +12,23 @@ using namespace oclint;
 class ContainsCallToSuperMethod : public RecursiveASTVisitor<ContainsCallToSuperMethod>
 {
 private:
-    string _selector;
+    Selector _selector;
 
-    // Location to save found ivar accesses
     bool _foundSuperCall;
 public:
-    explicit ContainsCallToSuperMethod(string selectorString)
-        : _selector(std::move(selectorString))
+    explicit ContainsCallToSuperMethod(Selector selector)
+        : _selector(selector)
     {
         _foundSuperCall = false;
     }
 
     bool VisitObjCMessageExpr(ObjCMessageExpr* expr)
     {
-        if(expr->getSelector().getAsString() == _selector
+        if(expr->getSelector() == _selector
         && expr->getReceiverKind() == ObjCMessageExpr::SuperInstance) {
             _foundSuperCall = true;
         }
-        return true;
+        return !_foundSuperCall;
     }
 
     bool foundSuperCall() const {
@@ -42,18 +41,9 @@ class ObjCVerifyMustCallSuperRule : public AbstractASTVisitorRule<ObjCVerifyMust
 {
 private:
     bool declRequiresSuperCall(ObjCMethodDecl* decl) {
-        if(decl->isOverriding()) {
-            SmallVector<const ObjCMethodDecl*, 4> overridden;
-            decl->getOverriddenMethods(overridden);
-            for (auto& elem : overridden)
-            {
-                if (declHasEnforceAttribute(elem, *this))
-                {
-                    return true;
-                }
-            }
-        }
-        return false;
+        const auto interface = decl->getClassInterface();
+        return interface && classEnforcedMethods(interface, *this, *_carrier)
+            .inherited(decl->getSelector(), decl->isInstanceMethod());
     }
 
 public:
@@ -77,6 +67,11 @@ public:
         return "cocoa";
     }
 
+    virtual const vector<string> lexicalPrerequisites() const override
+    {
+        return {"oclint:enforce"};
+    }
+
     virtual unsigned int supportedLanguages() const override
     {
         return LANG_OBJC;
@@ -125,16 +120,14 @@ public:
 #endif
 
     bool VisitObjCMethodDecl(ObjCMethodDecl* decl) {
-        // Save the method name
-        string selectorName = decl->getSelector().getAsString();
-
         // Figure out if anything in the super chain is marked
         if(declRequiresSuperCall(decl)) {
             // If so, start a separate checker to look for method sends just in the method body
-            ContainsCallToSuperMethod checker(selectorName);
+            ContainsCallToSuperMethod checker(decl->getSelector());
             checker.TraverseDecl(decl);
             if(!checker.foundSuperCall()) {
-                string message = "overridden method " + selectorName + " must call super";
+                string message = "overridden method " + decl->getSelector().getAsString() +
+                    " must call super";
                 addViolation(decl, this, message);
             }
         }
@@ -15,7 +15,7 @@ public:
     bool VisitCallExpr(const CallExpr* call) {
         const auto function = call->getDirectCallee();
         string comment;
-        if(declHasEnforceAttribute(function, *this, &comment)) {
+        if(declHasEnforceAttribute(function, *this, *_carrier, &comment)) {
             string description = "calling prohibited function " + function->getNameAsString();
             if(!comment.empty()) {
                 description = description + " instead use " + comment;
@@ -28,7 +28,7 @@ public:
     bool VisitObjCMessageExpr(const ObjCMessageExpr* expr) {
         const auto method = expr->getMethodDecl();
         string comment;
-        if(declHasEnforceAttribute(method, *this, &comment)) {
+        if(declHasEnforceAttribute(method, *this, *_carrier, &comment)) {
             string description = "calling prohibited method " + expr->getSelector().getAsString();
             if(!comment.empty()) {
                 description = description + " instead use " + comment;
@@ -58,6 +58,11 @@ public:
         return "cocoa";
     }
 
+    virtual const vector<string> lexicalPrerequisites() const override
+    {
+        return {"oclint:enforce"};
+    }
+
 #ifdef DOCGEN
     virtual const std::string since() const override
     {
@@ -3,7 +3,7 @@
 #include "oclint/AbstractASTVisitorRule.h"
 #include "oclint/RuleSet.h"
 #include "oclint/helper/EnforceHelper.h"
-#include "oclint/util/ASTUtil.h"
+#include "oclint/util/ObjCHierarchyOracle.h"
 
 using namespace std;
 using namespace clang;
@@ -16,15 +16,17 @@ namespace {
         private:
             ObjCInterfaceDecl& _container;
             AbstractASTRuleBase& _rule;
+            RuleCarrier& _carrier;
             vector<ObjCMessageExpr*> _violations;
 
         public:
-            CheckMethodsInsideClass(ObjCInterfaceDecl& container, AbstractASTRuleBase& rule) :
-                _container(container), _rule(rule) {};
+            CheckMethodsInsideClass(ObjCInterfaceDecl& container, AbstractASTRuleBase& rule,
+                RuleCarrier& carrier) :
+                _container(container), _rule(rule), _carrier(carrier) {};
 
         bool VisitObjCMessageExpr(ObjCMessageExpr* expr) {
             const auto method = expr->getMethodDecl();
-            if(!declHasEnforceAttribute(method, _rule)) {
+            if(!declHasEnforceAttribute(method, _rule, _carrier)) {
                 return true;
             }
 
@@ -33,7 +35,7 @@ namespace {
                 return true;
             }
 
-            if(!isObjCInterfaceClassOrSubclass(&_container, interface->getNameAsString())) {
+            if(!getObjCHierarchyOracle(_carrier)->isClassOrSubclass(&_container, interface)) {
                 _violations.push_back(expr);
             }
 
@@ -54,7 +56,7 @@ public:
         const auto interface = decl->getClassInterface();
 
         if(interface) {
-            auto checker = CheckMethodsInsideClass(*interface, *this);
+            auto checker = CheckMethodsInsideClass(*interface, *this, *_carrier);
             checker.TraverseDecl(decl);
             const auto violations = checker.getViolations();
             for(auto expr : violations) {
@@ -89,6 +91,11 @@ public:
         return "cocoa";
     }
 
+    virtual const vector<string> lexicalPrerequisites() const override
+    {
+        return {"oclint:enforce"};
+    }
+
     virtual unsigned int supportedLanguages() const override
     {
         return LANG_OBJC;
@@ -1,3 +1,5 @@
+#include <unordered_set>
+
 #include <clang/AST/Attr.h>
 
 #include "oclint/AbstractASTVisitorRule.h"
@@ -34,6 +36,11 @@ public:
         return "cocoa";
     }
 
+    virtual const vector<string> lexicalPrerequisites() const override
+    {
+        return {"oclint:enforce"};
+    }
+
     virtual unsigned int supportedLanguages() const override
     {
         return LANG_OBJC;
@@ -90,16 +97,23 @@ public:
             return true;
         }
         // Look through the parent for marked methods
-        for(auto it = parent->meth_begin(), end = parent->meth_end(); it != end; ++it) {
-            const auto method = *it;
-            if(declHasEnforceAttribute(method, *this)) {
-                const auto selector = method->getSelector();
-                if(!implementation->getMethod(selector, method->isInstanceMethod())) {
-                    const string className = parent->getNameAsString();
-                    const string methodName = selector.getAsString();
-                    addViolation(implementation, this,
-                        "subclasses of " + className + " must implement " + methodName);
-                }
+        const auto& enforced = classEnforcedMethods(parent, *this, *_carrier).declared();
+        if(enforced.empty()) {
+            return true;
+        }
+        unordered_set<void*> instanceMethods, classMethods;
+        for(auto it = implementation->meth_begin(), end = implementation->meth_end(); it != end; ++it) {
+            ((*it)->isInstanceMethod() ? instanceMethods : classMethods)
+                .insert((*it)->getSelector().getAsOpaquePtr());
+        }
+        for(const auto method : enforced) {
+            const auto& implemented = method->isInstanceMethod() ? instanceMethods : classMethods;
+            const auto selector = method->getSelector();
+            if(!implemented.count(selector.getAsOpaquePtr())) {
+                const string className = parent->getNameAsString();
+                const string methodName = selector.getAsString();
+                addViolation(implementation, this,
+                    "subclasses of " + className + " must implement " + methodName);
             }
         }
         return true;
@@ -25,6 +25,11 @@ public:
         return "empty";
     }
 
+    virtual const vector<string> lexicalPrerequisites() const override
+    {
+        return {"finally"};
+    }
+
 #ifdef DOCGEN
     virtual const std::string since() const override
     {
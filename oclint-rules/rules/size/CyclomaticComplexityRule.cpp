@@ -1,7 +1,7 @@
 #include "oclint/AbstractASTVisitorRule.h"
 #include "oclint/RuleConfiguration.h"
 #include "oclint/RuleSet.h"
-#include "oclint/metric/CyclomaticComplexityMetric.h"
+#include "oclint/util/FunctionMetricsStore.h"
 #include "oclint/util/StdUtil.h"
 
 using namespace std;
@@ -19,7 +19,7 @@ class CyclomaticComplexityRule : public AbstractASTVisitorRule<CyclomaticComplex
 private:
     void applyDecl(Decl *decl)
     {
-        int ccn = getCyclomaticComplexity(decl);
+        int ccn = getFunctionMetricsStore(*_carrier)->cyclomaticComplexity(decl);
 
         // In McBABE, 1976, A Complexity Measure, he suggested a reasonable number of 10
         int threshold = RuleConfiguration::intForKey("CYCLOMATIC_COMPLEXITY", 10);
@@ -2,6 +2,7 @@
 #include "oclint/RuleConfiguration.h"
 #include "oclint/RuleSet.h"
 #include "oclint/util/ASTUtil.h"
+#include "oclint/util/FunctionMetricsStore.h"
 #include "oclint/util/StdUtil.h"
 
 using namespace std;
@@ -16,8 +17,7 @@ private:
         if (decl->hasBody() &&
             !isCppMethodDeclLocatedInCppRecordDecl(dyn_cast<CXXMethodDecl>(decl)))
         {
-            CompoundStmt *compoundStmt = dyn_cast<CompoundStmt>(decl->getBody());
-            int length = getLineCount(compoundStmt->getSourceRange(), _carrier->getSourceManager());
+            int length = getFunctionMetricsStore(*_carrier)->lineCount(decl);
             int threshold = RuleConfiguration::intForKey("LONG_METHOD", 50);
             if (length > threshold)
             {
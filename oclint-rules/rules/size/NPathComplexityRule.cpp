@@ -1,7 +1,9 @@
+#include <limits>
+
 #include "oclint/AbstractASTVisitorRule.h"
 #include "oclint/RuleConfiguration.h"
 #include "oclint/RuleSet.h"
-#include "oclint/metric/NPathComplexityMetric.h"
+#include "oclint/util/FunctionMetricsStore.h"
 #include "oclint/util/StdUtil.h"
 
 using namespace std;
@@ -21,16 +23,16 @@ private:
     {
         if (decl->hasBody())
         {
-            CompoundStmt *bodyStmt = dyn_cast<CompoundStmt>(decl->getBody());
-            if (bodyStmt)
+            if (isa<CompoundStmt>(decl->getBody()))
             {
-                int npath = getNPathComplexity(bodyStmt);
-
                 int threshold = RuleConfiguration::intForKey("NPATH_COMPLEXITY", 200);
+                int64_t npath = getFunctionMetricsStore(*_carrier)->nPathComplexity(decl);
                 if (npath > threshold)
                 {
+                    bool isSaturated = npath == numeric_limits<int64_t>::max();
                     string description = "NPath Complexity Number " +
-                        toString<int>(npath) + " exceeds limit of " + toString<int>(threshold);
+                        string(isSaturated ? "of at least " : "") + toString<int64_t>(npath) +
+                        " exceeds limit of " + toString<int>(threshold);
                     addViolation(decl, this, description);
                 }
             }
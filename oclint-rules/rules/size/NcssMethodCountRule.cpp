@@ -1,7 +1,7 @@
 #include "oclint/AbstractASTVisitorRule.h"
 #include "oclint/RuleConfiguration.h"
 #include "oclint/RuleSet.h"
-#include "oclint/metric/NcssMetric.h"
+#include "oclint/util/FunctionMetricsStore.h"
 #include "oclint/util/StdUtil.h"
 
 using namespace std;
@@ -13,7 +13,7 @@ class NcssMethodCountRule : public AbstractASTVisitorRule<NcssMethodCountRule>
 private:
     void applyDecl(Decl *decl)
     {
-        int ncss = getNcssCount(decl);
+        int ncss = getFunctionMetricsStore(*_carrier)->ncss(decl);
         int threshold = RuleConfiguration::intForKey("NCSS_METHOD", 30);
         if (ncss > threshold)
         {
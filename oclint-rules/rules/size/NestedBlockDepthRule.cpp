@@ -1,7 +1,7 @@
 #include "oclint/AbstractASTVisitorRule.h"
 #include "oclint/RuleConfiguration.h"
 #include "oclint/RuleSet.h"
-#include "oclint/metric/StmtDepthMetric.h"
+#include "oclint/util/FunctionMetricsStore.h"
 #include "oclint/util/StdUtil.h"
 
 using namespace std;
@@ -68,7 +68,7 @@ public:
 
     bool VisitCompoundStmt(CompoundStmt *compoundStmt)
     {
-        int depth = getStmtDepth(compoundStmt);
+        int depth = getFunctionMetricsStore(*_carrier)->blockDepth(compoundStmt);
         int threshold = RuleConfiguration::intForKey("NESTED_BLOCK_DEPTH", 5);
         if (depth > threshold)
         {
@@ -5,6 +5,7 @@
 #include "oclint/AbstractASTVisitorRule.h"
 #include "oclint/RuleSet.h"
 #include "oclint/util/ASTUtil.h"
+#include "oclint/util/ObjCHierarchyOracle.h"
 
 using namespace std;
 using namespace clang;
@@ -43,8 +44,31 @@ private:
     bool isObjCOverrideMethod(DeclContext *context)
     {
         ObjCMethodDecl *decl = dyn_cast<ObjCMethodDecl>(context);
-        return isObjCMethodDeclaredInSuperClass(decl) ||
-            isObjCMethodDeclaredInProtocol(decl);
+        if (!decl || isObjCMethodDeclLocatedInInterfaceContainer(decl))
+        {
+            return false;
+        }
+        ObjCInterfaceDecl *interfaceDecl = decl->getClassInterface();
+        if (!interfaceDecl)
+        {
+            return false;
+        }
+
+        ObjCHierarchyOracle *hierarchy = getObjCHierarchyOracle(*_carrier);
+        if (hierarchy->classDeclaresMethod(interfaceDecl->getSuperClass(), decl))
+        {
+            return true;
+        }
+        for (ObjCProtocolList::iterator protocol = interfaceDecl->protocol_begin(),
+            protocolEnd = interfaceDecl->protocol_end(); protocol != protocolEnd; protocol++)
+        {
+            if (hierarchy->protocolDeclaresMethod(*protocol,
+                decl->getSelector(), decl->isInstanceMethod()))
+            {
+                return true;
+            }
+        }
+        return false;
     }
 
     bool isCppFunctionDeclaration(DeclContext *context)
@@ -0,0 +1,57 @@
+#include "TestRuleOnCode.h"
+
+#include "oclint/AbstractASTVisitorRule.h"
+
+using namespace std;
+using namespace oclint;
+
+class CancelAfterFirstFunctionRule : public AbstractASTVisitorRule<CancelAfterFirstFunctionRule>
+{
+public:
+    virtual const string name() const override
+    {
+        return "cancel after first function rule";
+    }
+
+    virtual int priority() const override
+    {
+        return 0;
+    }
+
+    virtual const string category() const override
+    {
+        return "test";
+    }
+
+    bool VisitFunctionDecl(clang::FunctionDecl *decl)
+    {
+        addViolation(decl, this);
+        _carrier->setDeadline(std::chrono::steady_clock::time_point::min());
+        return true;
+    }
+};
+
+TEST(CancelAfterFirstFunctionRuleTest, PropertyTest)
+{
+    CancelAfterFirstFunctionRule rule;
+    EXPECT_EQ(0, rule.priority());
+    EXPECT_EQ("cancel after first function rule", rule.name());
+}
+
+TEST(CancelAfterFirstFunctionRuleTest, StopsBetweenTopLevelDeclarations)
+{
+    testRuleOnCode(new CancelAfterFirstFunctionRule(),
+        VIOLATION_START "void a() {" VIOLATION_END "}\nvoid b() {}");
+}
+
+TEST(CancelAfterFirstFunctionRuleTest, StopsBetweenFunctionsOfOneDeclaration)
+{
+    testRuleOnCXXCode(new CancelAfterFirstFunctionRule(),
+        "namespace n {\n" VIOLATION_START "void a() {" VIOLATION_END "}\nvoid b() {}\n}");
+}
+
+TEST(CancelAfterFirstFunctionRuleTest, StopsBetweenMethodsOfOneClass)
+{
+    testRuleOnCXXCode(new CancelAfterFirstFunctionRule(),
+        "class C {\n" VIOLATION_START "void a() {" VIOLATION_END "}\nvoid b() {}\n};");
+}
@@ -186,3 +186,18 @@ TEST(MultipleLanguagesSupportASTRuleTest, RunOnObjC)
 {
     testRuleOnObjCCode(new LanguageSelectionASTRule(LANG_C | LANG_OBJC), "void a() {}", 0, 1, 1, 1, 11);
 }
+
+TEST(LanguageSelectionASTRuleTest, ApplicableLanguageOptions)
+{
+    clang::LangOptions cOptions;
+    cOptions.C99 = 1;
+    clang::LangOptions cxxOptions;
+    cxxOptions.CPlusPlus = 1;
+    clang::LangOptions objcOptions;
+    objcOptions.ObjC1 = 1;
+
+    LanguageSelectionASTRule rule(LANG_CXX);
+    EXPECT_FALSE(rule.isApplicable(cOptions));
+    EXPECT_TRUE(rule.isApplicable(cxxOptions));
+    EXPECT_FALSE(rule.isApplicable(objcOptions));
+}
@@ -127,6 +127,68 @@ BOOL YES = 1;                                       \n\
                                                     \n\
 ";
 
+static string testMethodUsedThroughDotSyntax = "\
+@interface NSObject                                 \n\
+@end                                                \n\
+                                                    \n\
+@interface BaseObject : NSObject                    \n\
+@end                                                \n\
+                                                    \n\
+@implementation BaseObject                          \n\
+- (int)value { return 1; }                          \n\
+- (int)twice { return self.value * 2; }             \n\
+@end                                                \n\
+";
+
+static string testMethodPossiblyUsedBySelector = "\
+@interface NSObject                                 \n\
+@end                                                \n\
+                                                    \n\
+@interface BaseObject : NSObject                    \n\
+@end                                                \n\
+                                                    \n\
+@implementation BaseObject                          \n\
+- (void)run { }                                     \n\
+- (SEL)action { return @selector(run); }            \n\
+@end                                                \n\
+";
+
+static string testMethodSentToUnrelatedClass = "\
+@interface NSObject                                 \n\
+@end                                                \n\
+@interface Other : NSObject                         \n\
+- (void)run;                                        \n\
+@end                                                \n\
+@interface BaseObject : NSObject                    \n\
+- (void)go:(Other *)other;                          \n\
+@end                                                \n\
+                                                    \n\
+@implementation BaseObject                          \n\
+- (void)run { }                                     \n\
+- (void)go:(Other *)other { [other run]; }          \n\
+@end                                                \n\
+";
+
+static string testMethodFromProtocolOfSuperCategory = "\
+@interface NSObject                                 \n\
+@end                                                \n\
+@protocol Base                                      \n\
+- (void)base;                                       \n\
+@end                                                \n\
+@protocol Derived <Base>                            \n\
+@end                                                \n\
+@interface Parent : NSObject                        \n\
+@end                                                \n\
+@interface Parent (Extra) <Derived>                 \n\
+@end                                                \n\
+@interface BaseObject : Parent                      \n\
+@end                                                \n\
+                                                    \n\
+@implementation BaseObject                          \n\
+- (void)base { }                                    \n\
+@end                                                \n\
+";
+
 TEST(ObjCVerifyMethodIsUsedRuleTest, PropertyTest)
 {
     ObjCVerifyMethodIsUsedRule rule;
@@ -150,6 +212,11 @@ TEST(ObjCVerifyMethodIsUsedRuleTest, MethodUsedProtocolMethod)
     testRuleOnObjCCode(new ObjCVerifyMethodIsUsedRule(), testMethodFromProtocol);
 }
 
+TEST(ObjCVerifyMethodIsUsedRuleTest, MethodUsedProtocolOfSuperCategory)
+{
+    testRuleOnObjCCode(new ObjCVerifyMethodIsUsedRule(), testMethodFromProtocolOfSuperCategory);
+}
+
 TEST(ObjCVerifyMethodIsUsedRuleTest, MethodNotUsed)
 {
     testRuleOnObjCCode(new ObjCVerifyMethodIsUsedRule(),
@@ -170,3 +237,94 @@ TEST(ObjCVerifyMethodIsUsedRuleTest, OneMethodNotUsed)
                        0, 13, 1, 15, 1,
                        "The method isEqual: was defined but not exported or referenced here");
 }
+
+TEST(ObjCVerifyMethodIsUsedRuleTest, MethodUsedThroughDotSyntax)
+{
+    testRuleOnObjCCode(new ObjCVerifyMethodIsUsedRule(),
+                       testMethodUsedThroughDotSyntax,
+                       0, 9, 1, 9, 39,
+                       "The method twice was defined but not exported or referenced here");
+}
+
+TEST(ObjCVerifyMethodIsUsedRuleTest, MethodPossiblyUsedBySelector)
+{
+    testRuleOnObjCCode(new ObjCVerifyMethodIsUsedRule(),
+                       testMethodPossiblyUsedBySelector,
+                       0, 9, 1, 9, 40,
+                       "The method action was defined but not exported or referenced here");
+}
+
+TEST(ObjCVerifyMethodIsUsedRuleTest, MethodNotUsedBySelectorSentToUnrelatedClass)
+{
+    testRuleOnObjCCode(new ObjCVerifyMethodIsUsedRule(),
+                       testMethodSentToUnrelatedClass,
+                       0, 11, 1, 11, 15,
+                       "The method run was defined but not exported or referenced here");
+}
+
+static string testGlobalDefiningUnit = "\
+@interface NSObject                                 \n\
+@end                                                \n\
+                                                    \n\
+@interface Exporter : NSObject                      \n\
+- (void)exported;                                   \n\
+- (void)unused;                                     \n\
+@end                                                \n\
+                                                    \n\
+@implementation Exporter                            \n\
+- (void)exported { }                                \n\
+- (void)unused { }                                  \n\
+@end                                                \n\
+";
+
+static string testGlobalReferencingUnit = "\
+@interface NSObject                                 \n\
+@end                                                \n\
+                                                    \n\
+@interface Exporter : NSObject                      \n\
+- (void)exported;                                   \n\
+@end                                                \n\
+                                                    \n\
+void use(Exporter *exporter) {                      \n\
+    [exporter exported];                            \n\
+}                                                   \n\
+";
+
+TEST(ObjCVerifyMethodIsUsedRuleTest, GlobalAnalysisAcrossTranslationUnits)
+{
+    ObjCVerifyMethodIsUsedRule rule;
+    rule.beginGlobalAnalysis();
+    vector<string> summaries;
+    ViolationSet definingViolations;
+    ASSERT_TRUE(computeViolationSet("input.m", &rule,
+        testGlobalDefiningUnit, {}, &definingViolations));
+    summaries.push_back(rule.summarizeTranslationUnit());
+    ViolationSet referencingViolations;
+    ASSERT_TRUE(computeViolationSet("input.m", &rule,
+        testGlobalReferencingUnit, {}, &referencingViolations));
+    summaries.push_back(rule.summarizeTranslationUnit());
+    EXPECT_EQ(0, definingViolations.numberOfViolations());
+    EXPECT_EQ(0, referencingViolations.numberOfViolations());
+
+    ViolationSet globalViolations;
+    rule.endGlobalAnalysis(summaries, &globalViolations);
+    ASSERT_EQ(1, globalViolations.numberOfViolations());
+    validateViolation(globalViolations.getViolations().at(0), 11, 1, 11, 18,
+        "The method unused was defined but not referenced in any translation unit");
+}
+
+TEST(ObjCVerifyMethodIsUsedRuleTest, GlobalAnalysisIgnoresMalformedSummary)
+{
+    ObjCVerifyMethodIsUsedRule rule;
+    rule.beginGlobalAnalysis();
+    ViolationSet definingViolations;
+    ASSERT_TRUE(computeViolationSet("input.m", &rule,
+        testGlobalDefiningUnit, {}, &definingViolations));
+    string summary = rule.summarizeTranslationUnit();
+
+    ViolationSet globalViolations;
+    rule.endGlobalAnalysis({ summary.substr(0, summary.size() / 2) }, &globalViolations);
+    EXPECT_EQ(0, globalViolations.numberOfViolations());
+    rule.endGlobalAnalysis({ summary }, &globalViolations);
+    EXPECT_EQ(2, globalViolations.numberOfViolations());
+}
@@ -119,3 +119,19 @@ TEST(ObjcVerifyMustCallSuperRuleTest, NormalMethod)
 {
     testRuleOnObjCCode(new ObjCVerifyMustCallSuperRule(), testNormalMethod);
 }
+
+static const string testAnnotationGrandChildDoesNotCall = testAnnotationBase + "\
+@interface GrandChildController : ChildViewController                           \n\
+@end                                                                            \n\
+@implementation GrandChildController                                            \n\
+- (void)viewWillAppear:(BOOL)animated {                                         \n\
+}                                                                               \n\
+@end                                                                            \n\
+";
+
+TEST(ObjcVerifyMustCallSuperRuleTest, AnnotationInheritedByGrandChild)
+{
+    testRuleOnObjCCode(new ObjCVerifyMustCallSuperRule(),
+        testAnnotationGrandChildDoesNotCall, 0, 19, 1, 20, 1,
+        "overridden method viewWillAppear: must call super");
+}
@@ -0,0 +1,27 @@
+#include "TestRuleOnCode.h"
+
+#include "rules/cocoa/ObjCVerifySafeObjectsRule.cpp"
+
+TEST(ObjCVerifySafeObjectsRuleTest, PropertyTest)
+{
+    ObjCVerifySafeObjectsRule rule;
+    EXPECT_EQ(1, rule.priority());
+    EXPECT_EQ("should use weak", rule.name());
+    EXPECT_EQ(LANG_OBJC, rule.supportedLanguages());
+    EXPECT_EQ("cocoa", rule.category());
+}
+
+TEST(ObjCVerifySafeObjectsRuleTest, AssignObjectPropertyWithoutARC)
+{
+    testRuleOnObjCCode(new ObjCVerifySafeObjectsRule(),
+        "@interface NSObject\n@end\n@interface Holder : NSObject\n"
+        V_START "@property (assign) NSObject *" V_END "object;\n@end\n",
+        {"property object property object should use strong, copy, or weak"});
+}
+
+TEST(ObjCVerifySafeObjectsRuleTest, RetainObjectProperty)
+{
+    testRuleOnObjCCode(new ObjCVerifySafeObjectsRule(),
+        "@interface NSObject\n@end\n@interface Holder : NSObject\n"
+        "@property (retain) NSObject *object;\n@end\n");
+}
@@ -17,8 +17,8 @@ public:
 
     virtual void HandleTranslationUnit(ASTContext &astContext) override
     {
-        RuleCarrier *carrier = new RuleCarrier(&astContext, _violationSet);
-        _rule->takeoff(carrier);
+        RuleCarrier carrier(&astContext, _violationSet);
+        _rule->takeoff(&carrier);
     }
 };
 
@@ -33,7 +33,7 @@ public:
     bool VisitObjCMessageExpr(ObjCMessageExpr* expr)
     {
         const auto method = expr->getMethodDecl();
-        if(declHasActionAttribute(method, "enforce", *this)) {
+        if(declHasActionAttribute(method, "enforce", *this, *_carrier)) {
             addViolation(expr, this);
         }
         return true;
@@ -41,7 +41,7 @@ public:
 
     bool VisitCallExpr(CallExpr* expr)
     {
-        if(declHasActionAttribute(expr->getCalleeDecl(), "enforce", *this)) {
+        if(declHasActionAttribute(expr->getCalleeDecl(), "enforce", *this, *_carrier)) {
             addViolation(expr, this);
         }
         return true;
@@ -73,7 +73,7 @@ public:
     bool VisitCallExpr(CallExpr* expr)
     {
         std::string comment;
-        if(declHasActionAttribute(expr->getCalleeDecl(), "enforce", *this, &comment)) {
+        if(declHasActionAttribute(expr->getCalleeDecl(), "enforce", *this, *_carrier, &comment)) {
             if(!comment.empty()) {
                 addViolation(expr, this, comment);
             }
@@ -119,6 +119,20 @@ TEST(AttributeHelperTestCallRuleTest, AttributeFunctionCall)
         0, 4, 17, 4, 19);
 }
 
+TEST(AttributeHelperTestCallRuleTest, RepeatedAttributeFunctionCall)
+{
+    AttributeHelperTestCallRule rule;
+    testRuleOnCode(&rule,
+        R"END(
+            void a() __attribute__((annotate("oclint:enforce[test attribute]")));
+            void b() {
+                a();
+                a();
+            }
+        )END",
+        1, 5, 17, 5, 19);
+}
+
 TEST(AttributeHelperTestCallRuleTest, IncorrectAction)
 {
     AttributeHelperTestCallRule rule;
@@ -1,5 +1,7 @@
 #include "TestRuleOnCode.h"
 
+#include <clang/Tooling/Tooling.h>
+
 #include "oclint/AbstractASTVisitorRule.h"
 #include "oclint/AbstractSourceCodeReaderRule.h"
 
@@ -106,21 +108,17 @@ TEST(SuppressHelperTestASTRuleTest, ObjCContainerSuppressOnMethod)
 TEST(SuppressHelperTestASTRuleTest, SimpleNOLINT)
 {
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() {} //!OCLINT");
-#if defined(__APPLE__) || defined(__MACH__)
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() {} //! OCLINT");
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() {} //!OCLint");
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() {} //! OCLint");
-#endif
 }
 
 TEST(SuppressHelperTestASTRuleTest, MultipleLineNOLINT)
 {
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() { //!OCLINT\n if (1) {//!OCLINT\n}}");
-#if defined(__APPLE__) || defined(__MACH__)
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() { //! OCLINT\n if (1) {//! OCLINT\n}}");
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() { //!OCLint\n if (1) {//!OCLint\n}}");
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() { //! OCLint\n if (1) {//! OCLint\n}}");
-#endif
 }
 
 TEST(SuppressHelperTestASTRuleTest, CommentWithDescriptionNOLINT)
@@ -129,7 +127,6 @@ TEST(SuppressHelperTestASTRuleTest, CommentWithDescriptionNOLINT)
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() {} //!OCLINT[reason for suppressing this is blahblah]");
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() {} //!OCLINT:reason for suppressing this is blahblah)");
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() {} //!OCLINT     ");
-#if defined(__APPLE__) || defined(__MACH__)
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() {} //! OCLINT(reason for suppressing this is blahblah)");
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() {} //! OCLINT[reason for suppressing this is blahblah]");
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() {} //! OCLINT:reason for suppressing this is blahblah)");
@@ -146,7 +143,6 @@ TEST(SuppressHelperTestASTRuleTest, CommentWithDescriptionNOLINT)
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() {} //!   OCLint[reason for suppressing this is blahblah]");
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() {} //!    OCLint:reason for suppressing this is blahblah)");
     testRuleOnCode(new SuppressHelperTestASTRule(), "void a() {} //!     OCLint     ");
-#endif
 }
 
 class SuppressHelperTestSourceCodeReaderRule : public AbstractSourceCodeReaderRule
@@ -188,11 +184,51 @@ TEST(SuppressHelperTestSourceCodeReaderRuleTest, NoSuppress)
 TEST(SuppressHelperTestSourceCodeReaderRuleTest, SuppressByComment)
 {
     testRuleOnCode(new SuppressHelperTestSourceCodeReaderRule(), "void a() {} //!OCLINT");
-#if defined(__APPLE__) || defined(__MACH__)
     testRuleOnCode(new SuppressHelperTestSourceCodeReaderRule(), "void a() {} //! OCLINT");
     testRuleOnCode(new SuppressHelperTestSourceCodeReaderRule(), "void a() {} //!OCLint");
     testRuleOnCode(new SuppressHelperTestSourceCodeReaderRule(), "void a() {} //! OCLint");
-#endif
+}
+
+TEST(SuppressHelperTestSourceCodeReaderRuleTest, SuppressByCommentOnlyOnItsLine)
+{
+    testRuleOnCode(new SuppressHelperTestSourceCodeReaderRule(),
+        "void a() {} //!OCLINT\nvoid b() {}", 0, 2, 1, 2, 11);
+}
+
+TEST(SuppressHelperTestSourceCodeReaderRuleTest, MarkerInStringLiteralDoesNotSuppress)
+{
+    testRuleOnCode(new SuppressHelperTestSourceCodeReaderRule(),
+        "const char *s = \"//!OCLINT\";", 0, 1, 1, 1, 28);
+    testRuleOnCode(new SuppressHelperTestSourceCodeReaderRule(),
+        "const char *s = \"//!OCLINT\"; //!OCLINT");
+}
+
+TEST(SuppressHelperTestSourceCodeReaderRuleTest, MarkerAfterBlockCommentSuppresses)
+{
+    testRuleOnCode(new SuppressHelperTestSourceCodeReaderRule(),
+        "int x; /* \"q */ //!OCLINT");
+}
+
+TEST(SuppressHelperTestSourceCodeReaderRuleTest, MarkerInBlockCommentDoesNotSuppress)
+{
+    testRuleOnCode(new SuppressHelperTestSourceCodeReaderRule(),
+        "/* //!OCLINT */ int x;", 0, 1, 1, 1, 22);
+    testRuleOnCode(new SuppressHelperTestSourceCodeReaderRule(),
+        "/*\n//!OCLINT */ int x;", 1, 2, 1, 2, 19);
+}
+
+TEST(SuppressHelperTestSourceCodeReaderRuleTest, MarkerOnlySuppressesOutsideRawStringLiteral)
+{
+    testRuleOnCXX11Code(new SuppressHelperTestSourceCodeReaderRule(),
+        "const char *s = R\"(//!OCLINT)\";", 0, 1, 1, 1, 31);
+    testRuleOnCXX11Code(new SuppressHelperTestSourceCodeReaderRule(),
+        VIOLATION_START "const char *s = R\"x" VIOLATION_END "(\n\")x\"; //!OCLINT");
+}
+
+TEST(SuppressHelperTestSourceCodeReaderRuleTest, MarkerInSplicedStringLiteralDoesNotSuppress)
+{
+    testRuleOnCode(new SuppressHelperTestSourceCodeReaderRule(),
+        "const char *s = \"a\\\n//!OCLINT\";", 1, 2, 1, 2, 11);
 }
 
 TEST(SuppressHelperTestSourceCodeReaderRuleTest, SuppressEntireMethod)
@@ -212,3 +248,82 @@ TEST(SuppressHelperTestSourceCodeReaderRuleTest, ObjCContainerSuppressOnAtInterf
     testRuleOnObjCCode(new SuppressHelperTestSourceCodeReaderRule(),
         "__attribute__((annotate(\"oclint:suppress\"))) @interface a {\nint i;\n}\n@end");
 }
+
+class OtherSuppressHelperTestSourceCodeReaderRule : public SuppressHelperTestSourceCodeReaderRule
+{
+public:
+    virtual const string name() const override
+    {
+        return "other test source code rule";
+    }
+};
+
+/* applies the rules one after another to the same carrier, the way the analyzer does */
+class SharedCarrierConsumer : public ASTConsumer
+{
+private:
+    vector<RuleBase *> _rules;
+    ViolationSet *_violationSet;
+
+public:
+    SharedCarrierConsumer(vector<RuleBase *> rules, ViolationSet *violationSet)
+        : _rules(rules), _violationSet(violationSet)
+    {
+    }
+
+    virtual void HandleTranslationUnit(ASTContext &astContext) override
+    {
+        RuleCarrier carrier(&astContext, _violationSet);
+        for (RuleBase *rule : _rules)
+        {
+            rule->takeoff(&carrier);
+        }
+    }
+};
+
+class SharedCarrierAction : public ASTFrontendAction
+{
+private:
+    vector<RuleBase *> _rules;
+    ViolationSet *_violationSet;
+
+public:
+    SharedCarrierAction(vector<RuleBase *> rules, ViolationSet *violationSet)
+        : _rules(rules), _violationSet(violationSet)
+    {
+    }
+
+    std::unique_ptr<ASTConsumer> CreateASTConsumer(CompilerInstance &, llvm::StringRef) override
+    {
+        return llvm::make_unique<SharedCarrierConsumer>(_rules, _violationSet);
+    }
+};
+
+static int numberOfViolations(const ViolationSet &violationSet, const RuleBase *rule)
+{
+    int count = 0;
+    for (const auto &violation : violationSet.getViolations())
+    {
+        count += violation.rule == rule;
+    }
+    return count;
+}
+
+TEST(SuppressHelperTestSourceCodeReaderRuleTest, SuppressOnlyTheAnnotatedRuleOfATranslationUnit)
+{
+    const string code =
+        "void __attribute__((annotate(\"oclint:suppress[test source code rule]\"))) a()\n{\nint i = 1;\n}\n";
+    SuppressHelperTestSourceCodeReaderRule suppressedRule;
+    OtherSuppressHelperTestSourceCodeReaderRule otherRule;
+
+    // the suppressed ranges of the first rule must not be reused for the second, in either order
+    vector<vector<RuleBase *>> orders { { &suppressedRule, &otherRule }, { &otherRule, &suppressedRule } };
+    for (const auto &rules : orders)
+    {
+        ViolationSet violationSet;
+        ASSERT_TRUE(clang::tooling::runToolOnCodeWithArgs(
+            new SharedCarrierAction(rules, &violationSet), code, {}, "input.c"));
+        EXPECT_EQ(0, numberOfViolations(violationSet, &suppressedRule));
+        EXPECT_EQ(4, numberOfViolations(violationSet, &otherRule));
+    }
+}
@@ -200,6 +200,12 @@ TEST_F(NPathComplexityRuleTest, NastingConditionalOperator)
         0, 1, 1, 1, 53, "NPath Complexity Number 8 exceeds limit of 1");
 }
 
+TEST_F(NPathComplexityRuleTest, ReportExactValueAboveThreshold)
+{
+    testRuleOnCode(new NPathComplexityRule(), "void mthd() { if (1) {} if (1) {} }",
+        0, 1, 1, 1, 35, "NPath Complexity Number 4 exceeds limit of 1");
+}
+
 TEST_F(NPathComplexityRuleTest, SuppressHighNPathComplexity)
 {
     testRuleOnCode(new NPathComplexityRule(), "void __attribute__((annotate(\"oclint:suppress[high npath complexity]\"))) mthd() { if (1 ? 2 : 3) {} }");
@@ -176,6 +176,31 @@ TEST(UnusedMethodParameterRuleTest, ObjCMethodInheritanceFromBaseInterfaceShould
 @implementation SubClass\n- (void)aMethod:(int)a {}\n@end");
 }
 
+TEST(UnusedMethodParameterRuleTest, ObjCClassMethodInheritanceFromBaseInterfaceShouldBeIgnored)
+{
+    testRuleOnObjCCode(new UnusedMethodParameterRule(), "\
+@interface BaseClass\n+ (void)aMethod:(int)a;\n@end\n    \
+@interface SubClass : BaseClass\n@end\n                  \
+@implementation SubClass\n+ (void)aMethod:(int)a {}\n@end");
+}
+
+TEST(UnusedMethodParameterRuleTest, ObjCClassMethodImplementedForProtocolShouldBeIgnored)
+{
+    testRuleOnObjCCode(new UnusedMethodParameterRule(), "@interface Object\n@end\n\
+@protocol AProtocol\n+ (void)aMethod:(int)a;\n@end\n\
+@interface AnInterface : Object <AProtocol>\n@end\n\
+@implementation AnInterface\n+ (void)aMethod:(int)a {}\n@end");
+}
+
+TEST(UnusedMethodParameterRuleTest, ObjCClassMethodDoesNotOverrideInstanceMethod)
+{
+    testRuleOnObjCCode(new UnusedMethodParameterRule(), "\
+@interface BaseClass\n- (void)aMethod:(int)a;\n@end\n\
+@interface SubClass : BaseClass\n@end\n\
+@implementation SubClass\n+ (void)aMethod:(int)a {}\n@end",
+        0, 7, 18, 7, 22, "The parameter 'a' is unused.");
+}
+
 TEST(UnusedMethodParameterRuleTest, ObjCMethodImplementedForProtocolShouldBeIgnored)
 {
     testRuleOnObjCCode(new UnusedMethodParameterRule(), "@interface Object\n@end\n\